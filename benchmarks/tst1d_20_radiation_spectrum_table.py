@@ -0,0 +1,100 @@
+########################################################################################################################
+# Setup:                                                                                                               #
+# - Synchrotron emission spectrum of ultra-relativistic electrons in a constant magnetic field                         #
+# - EM fields are frozen, the electrons do not lose energy (radiation_model = "diagradiationspectrum")                 #
+# - two electron species with quantum parameters of about 1 and 0.1                                                   #
+# Main test:                                                                                                           #
+# - RadiationSpectrum diagnostics using the tabulated synchrotron spectrum, compared to the previous fit               #
+########################################################################################################################
+
+import numpy as np
+
+# quick access databases
+chi0    = 1.00
+g0      = 1.e3
+
+# Simulation box properties
+dx      = 1./128.
+Lx      = 1.
+dt      = 0.95*dx
+Tsim    = 0.5*np.pi
+
+# Electron bunch properties
+n0      = 1.
+nppc    = 16
+
+# External magnetic field
+B0      = g0
+
+# Compute reference angular frequency
+c_SI    = 299792458.
+me_SI   = 9.10938356e-31
+hbar_SI = 1.054571800e-34
+Er_ov_Es = chi0 / g0**2
+wr       = me_SI*c_SI**2/hbar_SI * Er_ov_Es
+
+# Lorentz factors of the two species: the quantum parameters are about chi0 and chi0/10
+gammas = {"electron_chi1":g0, "electron_chi0.1":g0/10.}
+
+# SMILEI PARAMETERS ####################################################################################################
+
+### MAIN
+Main(
+    geometry = "1Dcartesian",
+    interpolation_order = 2,
+    cell_length = [dx],
+    grid_length  = [Lx],
+    number_of_patches = [16],
+    timestep = dt,
+    simulation_time = Tsim,
+    EM_boundary_conditions = [['periodic']],
+    random_seed = smilei_mpi_rank,
+    reference_angular_frequency_SI = wr,
+    solve_poisson = False,
+    time_fields_frozen = 2.*Tsim,
+    print_every = int(Tsim/dt/20.)
+)
+
+ExternalField(
+    field   = 'Bz',
+    profile = B0
+)
+
+RadiationReaction(
+   minimum_chi_continuous = 1e-6,
+   minimum_chi_discontinuous = 1e-4,
+)
+
+globalEvery = int(Tsim/dt/4.)
+
+for name, gamma in gammas.items():
+    Species(
+        name = name,
+        position_initialization = "random",
+        momentum_initialization = "cold",
+        particles_per_cell = nppc,
+        mass = 1.,
+        charge = -1.,
+        number_density = n0,
+        mean_velocity = [np.sqrt(1.-1./gamma**2),0.,0.],
+        boundary_conditions = [["periodic"]],
+        radiation_model = "diagradiationspectrum"
+    )
+    
+    # Linear photon energy axis, so that all the bins have the same width
+    DiagRadiationSpectrum(
+        every = globalEvery,
+        species = [name],
+        photon_energy_axis = [gamma/200., 0.9*gamma, 200],
+        axes = [],
+        tabulated_spectrum = True
+    )
+    
+    # Total weight, kinetic energy and quantum parameter, to get the mean Lorentz factor and chi
+    for quantity in ["weight", "weight_ekin", "weight_chi"]:
+        DiagParticleBinning(
+            deposited_quantity = quantity,
+            every = globalEvery,
+            species = [name],
+            axes = []
+        )
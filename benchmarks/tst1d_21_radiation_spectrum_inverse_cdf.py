@@ -0,0 +1,158 @@
+########################################################################################################################
+# Setup:                                                                                                               #
+# - Same as tst1d_18_radiation_spectrum_chi0.1, with the electrons without radiation reaction and with Monte-Carlo     #
+# - the photon quantum parameter is sampled in the inverse cumulative distribution table (inverse_cdf_size)            #
+# Main test:                                                                                                           #
+# - Radiated power and photon spectrum compared to the reference of tst1d_18, obtained by a search in the table xi     #
+########################################################################################################################
+
+import numpy as np
+
+# quick access databases
+chi0    = 0.10
+g0      = 1.e3
+
+# Physical constants in SI units
+c_SI    = 299792458.
+me_SI   = 9.10938356e-31
+e_SI    = 1.60217662e-19
+hbar_SI = 1.054571800e-34
+
+# Simulation box properties
+dx      = 1./128.
+Lx      = 1.
+dt      = 0.95*dx
+Tsim    = 2.*np.pi
+
+# Electron bunch properties
+v0      = np.sqrt(1.-1./g0**2)
+n0      = 1.
+l0      = 1.
+nppc    = 32
+
+def n_(x):
+    if (x<l0):
+        return n0
+    else:
+        return 0.
+
+# External magnetic DiagField
+B0      = g0
+
+# Estimate maximum photon energy
+photon_energy_max = 10.*g0*chi0
+
+# Compute reference angular frequency
+Er_ov_Es = chi0 / g0**2
+wr       = me_SI*c_SI**2/hbar_SI * Er_ov_Es
+
+# SMILEI PARAMETERS ####################################################################################################
+
+### MAIN
+Main(
+    geometry = "1Dcartesian",
+    interpolation_order = 2,
+    cell_length = [dx],
+    grid_length  = [Lx],
+    number_of_patches = [16],
+    timestep = dt,
+    simulation_time = Tsim,
+    EM_boundary_conditions = [['periodic']],
+    random_seed = smilei_mpi_rank,
+    reference_angular_frequency_SI = wr,
+    solve_poisson = False,
+    time_fields_frozen = 2.*Tsim,
+    print_every = int(Tsim/dt/20.)
+)
+
+def B0_(x,t):
+    return B0
+
+PrescribedField(
+    field   = 'Bz_m',
+    profile = B0_
+)
+
+
+Species(
+    name = "electron_noRR",
+    position_initialization = "random",
+    momentum_initialization = "cold",
+    particles_per_cell = nppc,
+    mass = 1.,
+    charge = -1.,
+    number_density = n_,
+    mean_velocity = [v0,0.,0.],
+    boundary_conditions = [["periodic"]],
+    radiation_model = "diagradiationspectrum"
+)
+
+Species(
+    name = "electron_MC",
+    position_initialization = "random",
+    momentum_initialization = "cold",
+    particles_per_cell = nppc,
+    mass = 1.,
+    charge = -1.,
+    number_density = n_,
+    mean_velocity = [v0,0.,0.],
+    boundary_conditions = [["periodic"]],
+    radiation_model = "Monte-Carlo",
+    radiation_photon_species = "photon",
+    radiation_photon_sampling = 1,
+    radiation_photon_gamma_threshold = 0
+)
+
+Species(
+    name = "photon",
+    position_initialization = "random",
+    momentum_initialization = "cold",
+    particles_per_cell = 0,
+    mass = 0.,
+    charge = 0.,
+    number_density = 0,
+    mean_velocity = [0.],
+    boundary_conditions = [["periodic"]],
+)
+
+RadiationReaction(
+   Niel_computation_method = "fit5",
+   # Radiation parameters
+   minimum_chi_continuous = 1e-6,
+   minimum_chi_discontinuous = 1e-4,
+   # Photon sampling without search in the table xi
+   inverse_cdf_size = 1024,
+)
+
+### Diagnostics
+globalEvery = int(Tsim/dt)
+
+### distribution in chi of the Monte-Carlo electrons
+DiagParticleBinning(
+    deposited_quantity = "weight",
+    every = globalEvery,
+    species = ["electron_MC"],
+    axes = [
+        ["chi", 0, 4*chi0, 100]
+    ]
+)
+
+### photon energy
+DiagRadiationSpectrum(
+    every = 1,
+    species = ["electron_noRR"],
+    photon_energy_axis = [photon_energy_max/1.e6,photon_energy_max, 400, 'logscale'],
+    axes = []
+)
+
+def depose(particles):
+    return particles.weight*np.sqrt(particles.px**2+particles.py**2+particles.pz**2)
+
+DiagParticleBinning(
+    deposited_quantity = depose,
+    every = 1,
+    species = ["photon"],
+    axes = [
+        ["gamma", photon_energy_max/1.e6, photon_energy_max, 400, 'logscale']
+    ]
+)
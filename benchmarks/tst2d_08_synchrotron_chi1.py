@@ -200,3 +200,8 @@ for i,radiation in enumerate(radiation_list):
             ["ekin", 1., gamma, 1000,"logscale"],
         ]
     )
+
+# Timers of the radiation reaction (Monte-Carlo) to be compared between versions
+DiagPerformances(
+    every = 500,
+)
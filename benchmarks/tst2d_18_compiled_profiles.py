@@ -0,0 +1,109 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# User-defined profiles translated into programs (Main.compile_profiles) compared to
+# the same profiles evaluated by python: each profile is given twice, the second time
+# through a wrapper converting the coordinates to float, which cannot be translated.
+#
+# Validation:
+# - Compiled density profiles (branches, math functions, closures)
+# - Compiled external fields
+# - The math functions are restored after the translation, even when it fails
+# ----------------------------------------------------------------------------------------
+
+import math
+from math import exp, sqrt, atan2, floor
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.005 * L0,
+	simulation_time  = 0.01 * L0,
+	
+	cell_length = [0.01 * L0]*2,
+	grid_length  = [1. * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	time_fields_frozen = 10000000.,
+	
+	EM_boundary_conditions = [
+		["periodic"],
+		["periodic"],
+	], 
+	print_every = 10,
+	solve_poisson = False,
+	compile_profiles = True,
+	
+	random_seed = smilei_mpi_rank
+)
+
+# Profiles using branches, functions of the math module (imported in both manners) and closures
+def branches(x, y):
+	if y < 0.3*L0:
+		return 0.
+	elif x < 0.5*L0:
+		return 0.5 + 0.4*math.cos(4.*x/L0)
+	else:
+		return exp(-((x-0.7*L0)/(0.1*L0))**2)
+def functions(x, y):
+	r = sqrt( (x-0.5*L0)**2 + (y-0.5*L0)**2 )
+	return abs( math.sin(atan2(y-0.5*L0, x-0.5*L0)) ) * math.pow(r/L0, 1.5) + 0.1*floor(2.*x/L0)
+def make_closure(k):
+	cosine = math.cos
+	return lambda x, y: 1. + 0.5 * cosine(k*x) * math.tanh(y/L0)
+
+def python(f):
+	return lambda x, y: f( float(x), float(y) )
+
+profiles = {
+"branches" :branches,
+"functions":functions,
+"closure"  :make_closure(3./L0),
+}
+
+for name, profile in profiles.items():
+	for kind, p in [("compiled", profile), ("python", python(profile))]:
+		Species(
+			name = kind+"_"+name,
+			position_initialization = "regular",
+			momentum_initialization = "cold",
+			particles_per_cell= 4,
+			mass = 1.0,
+			charge = 1.0,
+			number_density = p,
+			time_frozen = 10000.0,
+			boundary_conditions = [
+				["periodic", "periodic"],
+				["periodic", "periodic"],
+			],
+		)
+
+# Ey and Bx are on the same grid in 2D
+ExternalField(
+	field = "Ey",
+	profile = functions
+)
+ExternalField(
+	field = "Bx",
+	profile = python(functions)
+)
+
+DiagFields(
+	every = 5,
+)
+
+# The functions replaced during the translation must be restored, also when it fails
+_originals = ( math.exp, math.cos, exp )
+def _not_translatable(x, y):
+	return math.exp(x) + exp(y) + int(x)
+if _compile_profile(_not_translatable, 2) is not None \
+		or _compile_profile(branches, 2) is None \
+		or ( math.exp, math.cos, exp ) != _originals \
+		or profiles["closure"].__closure__[0].cell_contents is not math.cos:
+	raise Exception("The translation of profiles did not restore the math functions")
@@ -0,0 +1,85 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Pre-defined profiles, evaluated on arrays of points, compared to the same profiles
+# evaluated by python: each profile is given twice, the second time through a wrapper
+# hiding the pre-defined profile.
+#
+# Validation:
+# - Densities given by pre-defined profiles
+# - External fields given by pre-defined profiles
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.005 * L0,
+	simulation_time  = 0.01 * L0,
+	
+	cell_length = [0.01 * L0]*2,
+	grid_length  = [1. * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	time_fields_frozen = 10000000.,
+	
+	EM_boundary_conditions = [
+		["periodic"],
+		["periodic"],
+	], 
+	print_every = 10,
+	solve_poisson = False,
+	
+	random_seed = smilei_mpi_rank
+)
+
+def python(f):
+	return lambda x, y: f( float(x), float(y) )
+
+profiles = {
+"trapezoidal": trapezoidal( 1., xvacuum=0.1*L0, xplateau=0.4*L0, xslope1=0.2*L0, xslope2=0.15*L0,
+                                yvacuum=0.2*L0, yplateau=0.3*L0, yslope1=0.1*L0, yslope2=0.3*L0 ),
+"gaussian"   : gaussian( 2., xfwhm=0.3*L0, xcenter=0.4*L0, yvacuum=0.1*L0, ylength=0.8*L0, yfwhm=0.5*L0, ycenter=0.6*L0, yorder=4 ),
+"polygonal"  : polygonal( xpoints=[0.1*L0, 0.3*L0, 0.3*L0, 0.8*L0], xvalues=[0.5, 1., 2., 0.2] ),
+"cosine"     : cosine( 1., xamplitude=0.5, xvacuum=0.1*L0, xlength=0.7*L0, xphi=0.3, xnumber=3,
+                           yamplitude=0.3, ylength=0.9*L0, ynumber=1 ),
+"polynomial" : polynomial( x0=0.5*L0, y0=0.5*L0, order0=1., order1=[0.05, 0.05], order2=[0.02, -0.01, 0.03] ),
+}
+
+for name, profile in profiles.items():
+	for kind, p in [("predefined", profile), ("python", python(profile))]:
+		Species(
+			name = kind+"_"+name,
+			position_initialization = "regular",
+			momentum_initialization = "cold",
+			particles_per_cell= 4,
+			mass = 1.0,
+			charge = 1.0,
+			number_density = p,
+			time_frozen = 10000.0,
+			boundary_conditions = [
+				["periodic", "periodic"],
+				["periodic", "periodic"],
+			],
+		)
+
+# Ey and Bx are on the same grid in 2D
+ExternalField(
+	field = "Ey",
+	profile = profiles["gaussian"]
+)
+ExternalField(
+	field = "Bx",
+	profile = python(profiles["gaussian"])
+)
+
+DiagFields(
+	every = 5,
+)
@@ -0,0 +1,92 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Particle binning diagnostics due at the same timesteps, run together over chunks of
+# particles, compared to the same diagnostics defined with python functions, which
+# bin all the particles of each patch at once.
+#
+# Validation:
+# - Built-in deposited quantities and axes against equivalent python functions
+# - Diagnostics with several species, time-averaging, and different periods
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.005 * L0,
+	simulation_time  = 0.2 * L0,
+	
+	cell_length = [0.01 * L0]*2,
+	grid_length  = [0.64 * L0]*2,
+	
+	number_of_patches = [ 2 ]*2,
+	
+	EM_boundary_conditions = [
+		["periodic"],
+		["periodic"],
+	], 
+	print_every = 10,
+	
+	random_seed = smilei_mpi_rank
+)
+
+# 32x32 cells and 4 particles per cell per patch: several chunks of particles in each patch
+for name, charge, mass in [("electron", -1., 1.), ("ion", 1., 100.)]:
+	Species(
+		name = name,
+		position_initialization = "random",
+		momentum_initialization = "maxwell-juettner",
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		number_density = 1.,
+		temperature = [0.001],
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+	)
+
+# Each diagnostic is given twice: with built-in quantities, then with python functions
+Lx, Ly = Main.grid_length
+diagnostics = [
+	dict(
+		every = 5,
+		species = ["electron"],
+		deposited_quantity = ["weight_px", lambda p: p.weight * p.px],
+		axes = [ ["x", 0., Lx, 16], ["px", -0.15, 0.15, 30] ],
+		python_axes = [ ["x", 0., Lx, 16], [lambda p: p.px, -0.15, 0.15, 30] ],
+	),
+	dict(
+		every = 10,
+		time_average = 3,
+		species = ["electron", "ion"],
+		deposited_quantity = ["weight_charge", lambda p: p.weight * p.charge],
+		axes = [ ["y", 0., Ly, 16], ["charge", -1.5, 1.5, 3] ],
+		python_axes = [ [lambda p: p.y, 0., Ly, 16], [lambda p: p.charge, -1.5, 1.5, 3] ],
+	),
+	dict(
+		every = 5,
+		species = ["ion"],
+		deposited_quantity = ["weight", lambda p: p.weight],
+		axes = [ ["py", -0.015, 0.015, 20, "edge_inclusive"] ],
+		python_axes = [ [lambda p: p.py, -0.015, 0.015, 20, "edge_inclusive"] ],
+	),
+]
+
+for d in diagnostics:
+	for deposited_quantity, axes in [(d["deposited_quantity"][0], d["axes"]), (d["deposited_quantity"][1], d["python_axes"])]:
+		DiagParticleBinning(
+			deposited_quantity = deposited_quantity,
+			every = d["every"],
+			time_average = d.get("time_average", 1),
+			species = d["species"],
+			axes = axes
+		)
@@ -0,0 +1,96 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# DiagTrackParticles filters translated into programs compared to the same filters
+# evaluated by python: each filter is given to two identical species, the second time
+# as a numpy function which is not translated.
+#
+# Validation:
+# - Expression filters using positions, momenta, weights, math functions and the iteration
+# - Python function filter translated with compile_filter
+# - Tracked particles identical to those selected by python
+# ----------------------------------------------------------------------------------------
+
+import math
+import numpy as np
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.005 * L0,
+	simulation_time  = 0.5 * L0,
+	
+	cell_length = [0.02 * L0]*2,
+	grid_length  = [1. * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	EM_boundary_conditions = [
+		["periodic"],
+		["periodic"],
+	], 
+	print_every = 20,
+	solve_poisson = False,
+	
+	random_seed = smilei_mpi_rank
+)
+
+# Filters given as expressions (always translated), or as functions translated with compile_filter,
+# then the same filters as numpy functions evaluated by python
+def momentum_filter(p):
+	return ( (p.px > 0.02) & (p.y < 3.) ) | ( p.py < -0.03 )
+filters = {
+"position_momentum": [
+	"(x < 3. and px > 0.) or (iteration >= 40 and y > 4.)",
+	lambda p: ( (p.x < 3.) & (p.px > 0.) ) | ( (Main.iteration >= 40) & (p.y > 4.) )
+],
+"math_weight": [
+	"sqrt(px*px + py*py) > 0.03 and weight > 0.",
+	lambda p: ( np.sqrt(p.px*p.px + p.py*p.py) > 0.03 ) & ( p.weight > 0. )
+],
+"function": [
+	momentum_filter,
+	momentum_filter
+],
+}
+
+for name, (compiled_filter, python_filter) in filters.items():
+	for kind, filter in [("compiled", compiled_filter), ("python", python_filter)]:
+		Species(
+			name = kind+"_"+name,
+			position_initialization = "regular",
+			momentum_initialization = "cold",
+			particles_per_cell = 4,
+			mass = 1.0,
+			charge = -1.0,
+			number_density = 1.,
+			mean_velocity = [
+				lambda x, y: 0.05*math.sin(x/L0*2.*math.pi),
+				lambda x, y: 0.04*math.cos(y/L0*4.*math.pi),
+				0.
+			],
+			boundary_conditions = [
+				["periodic", "periodic"],
+				["periodic", "periodic"],
+			],
+		)
+		
+		DiagTrackParticles(
+			species = kind+"_"+name,
+			every = 10,
+			filter = filter,
+			compile_filter = ( kind == "compiled" ),
+			attributes = ["x", "y", "px", "py"]
+		)
+
+# The function given with compile_filter must actually be translated,
+# but not a function combining several particles
+if _compile_filter(momentum_filter, 2) is None:
+	raise Exception("The filter function could not be translated")
+if _compile_filter(lambda p: p.px > np.mean(p.px), 2) is not None:
+	raise Exception("A filter using numpy.mean was translated")
@@ -0,0 +1,69 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# DiagTrackParticles written in ID order by Smilei (ordered = True) compared to the
+# usual output sorted by happi: two identical species are tracked, one in each mode.
+# The filter selects new particles during the simulation.
+#
+# Validation:
+# - Same trajectories in both modes
+# - Each particle keeps its position in the ordered file
+# ----------------------------------------------------------------------------------------
+
+import math
+
+L0 = 2.*math.pi # Wavelength in PIC units
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = 0.005 * L0,
+	simulation_time  = 0.5 * L0,
+	
+	cell_length = [0.02 * L0]*2,
+	grid_length  = [1. * L0]*2,
+	
+	number_of_patches = [ 4 ]*2,
+	
+	EM_boundary_conditions = [
+		["periodic"],
+		["periodic"],
+	], 
+	print_every = 20,
+	solve_poisson = False,
+	
+	random_seed = smilei_mpi_rank
+)
+
+for ordered in [True, False]:
+	name = "ordered" if ordered else "disordered"
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 4,
+		mass = 1.0,
+		charge = -1.0,
+		number_density = 1.,
+		mean_velocity = [
+			lambda x, y: 0.05*math.sin(x/L0*2.*math.pi),
+			lambda x, y: 0.04*math.cos(y/L0*4.*math.pi),
+			0.
+		],
+		boundary_conditions = [
+			["periodic", "periodic"],
+			["periodic", "periodic"],
+		],
+	)
+	
+	# Particles enter the filter progressively: new IDs appear at each output
+	DiagTrackParticles(
+		species = name,
+		every = 10,
+		filter = lambda p: p.x < 0.1*L0 + 0.05*Main.iteration*Main.timestep,
+		ordered = ordered,
+		attributes = ["x", "y", "px", "py"]
+	)
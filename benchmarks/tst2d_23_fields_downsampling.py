@@ -0,0 +1,75 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# DiagFields averaged over blocks of cells (downsample) compared to the full-resolution
+# fields averaged by the analysis: a laser enters an underdense plasma.
+#
+# Validation:
+# - Pyramid of resolutions (downsample = [2, 8]) on primal and dual fields
+# - Downsampling of time-averaged fields
+# ----------------------------------------------------------------------------------------
+
+from math import pi
+
+l0 = 2.*pi  # laser wavelength
+t0 = l0     # optical cycle
+dx = l0/16.
+dt = 0.6*dx
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = dt,
+	simulation_time = 6.*t0,
+	
+	cell_length = [dx, dx],
+	grid_length  = [128*dx, 64*dx],
+	
+	# 32x32 cells per patch
+	number_of_patches = [ 4, 2 ],
+	
+	EM_boundary_conditions = [
+		["silver-muller"],
+		["periodic"],
+	],
+	print_every = 20,
+	solve_poisson = False,
+	
+	random_seed = smilei_mpi_rank
+)
+
+LaserGaussian2D(
+	box_side        = "xmin",
+	a0              = 1.,
+	omega           = 1.,
+	focus           = [2.*l0, Main.grid_length[1]/2.],
+	waist           = 1.5*l0,
+	time_envelope   = tgaussian(fwhm=2.*t0, center=2.*t0)
+)
+
+for name, charge, mass in [("electron", -1., 1.), ("ion", 1., 1836.)]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		number_density = trapezoidal(0.05, xvacuum=2.*l0, xslope1=l0),
+		boundary_conditions = [
+			["remove", "remove"],
+			["periodic", "periodic"],
+		],
+	)
+
+fields = ["Ex", "Ey", "Bz", "Jx", "Rho_electron"]
+every = 24
+
+# Full resolution, then downsampled, without and with time-averaging
+DiagFields( every = every, fields = fields )
+DiagFields( every = every, fields = fields, downsample = [2, 8] )
+DiagFields( every = every, fields = fields, time_average = 3 )
+DiagFields( every = every, fields = fields, time_average = 3, downsample = 4 )
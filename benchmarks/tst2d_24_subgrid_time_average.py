@@ -0,0 +1,90 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Time-averaged DiagFields, accumulated only on the points of their subgrid, compared to
+# the instantaneous fields averaged by the analysis: a laser enters an underdense plasma.
+#
+# Validation:
+# - Time-average on the full grid
+# - Time-average on subgrids with steps, and on a subgrid crossing patch boundaries
+# - Time-average accumulated in single precision
+# ----------------------------------------------------------------------------------------
+
+from math import pi
+from numpy import s_
+
+l0 = 2.*pi  # laser wavelength
+t0 = l0     # optical cycle
+dx = l0/16.
+dt = 0.6*dx
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = dt,
+	simulation_time = 6.*t0,
+	
+	cell_length = [dx, dx],
+	grid_length  = [128*dx, 64*dx],
+	
+	number_of_patches = [ 4, 2 ],
+	
+	EM_boundary_conditions = [
+		["silver-muller"],
+		["periodic"],
+	],
+	print_every = 20,
+	solve_poisson = False,
+	
+	random_seed = smilei_mpi_rank
+)
+
+LoadBalancing(
+	every = 20,
+)
+
+LaserGaussian2D(
+	box_side        = "xmin",
+	a0              = 1.,
+	omega           = 1.,
+	focus           = [2.*l0, Main.grid_length[1]/2.],
+	waist           = 1.5*l0,
+	time_envelope   = tgaussian(fwhm=2.*t0, center=2.*t0)
+)
+
+for name, charge, mass in [("electron", -1., 1.), ("ion", 1., 1836.)]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 4,
+		mass = mass,
+		charge = charge,
+		number_density = trapezoidal(0.05, xvacuum=2.*l0, xslope1=l0),
+		boundary_conditions = [
+			["remove", "remove"],
+			["periodic", "periodic"],
+		],
+	)
+
+fields = ["Ex", "Ey", "Bz", "Jx", "Rho_electron"]
+every = 24
+time_average = 5
+
+# Instantaneous fields at all timesteps
+DiagFields( every = 1, fields = fields )
+
+# Time-averaged fields on the full grid and on subgrids
+subgrids = [
+	None,
+	s_[3:120:2, 10:50:3],
+	s_[30:70, 20:45],
+]
+for subgrid in subgrids:
+	DiagFields( every = every, fields = fields, time_average = time_average, subgrid = subgrid )
+
+# Single precision accumulators
+DiagFields( every = every, fields = fields, time_average = time_average, subgrid = subgrids[1], time_average_precision = "single" )
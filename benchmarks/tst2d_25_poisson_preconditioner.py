@@ -0,0 +1,74 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Initial electrostatic field of two charged blobs, obtained with the preconditioned
+# conjugate gradient of the Poisson solver. The analysis solves the same problem with the
+# plain conjugate gradient (preconditioner_sweeps = 0) and compares them.
+#
+# Validation:
+# - Convergence of the preconditioned Poisson solver
+# - Fewer iterations than the plain conjugate gradient
+# - Same Ex and Ey as the plain conjugate gradient
+# ----------------------------------------------------------------------------------------
+
+import math
+
+dx = 0.5
+dt = 0.95*dx/math.sqrt(2.)
+
+Main(
+	geometry = "2Dcartesian",
+	
+	interpolation_order = 2,
+	
+	timestep = dt,
+	simulation_time = 10.*dt,
+	
+	cell_length = [dx, dx],
+	grid_length  = [64*dx, 64*dx],
+	
+	number_of_patches = [ 4, 4 ],
+	
+	EM_boundary_conditions = [
+		["silver-muller"],
+		["periodic"],
+	],
+	print_every = 5,
+	
+	solve_poisson = True,
+	poisson_max_error = 1.e-14,
+	poisson_preconditioner_sweeps = 2,
+	
+	random_seed = smilei_mpi_rank
+)
+
+def blob(x0, y0, sigma, n0):
+	def density(x, y):
+		r2 = (x-x0)**2 + (y-y0)**2
+		return n0*math.exp(-r2/sigma**2) if r2 < (3.*sigma)**2 else 0.
+	return density
+
+for name, charge, density in [
+		("electron", -1., blob(20., 12., 2.8, 1.)),
+		("positron",  1., blob(10., 20., 2., 0.5)),
+	]:
+	Species(
+		name = name,
+		position_initialization = "regular",
+		momentum_initialization = "cold",
+		particles_per_cell = 16,
+		mass = 1.,
+		charge = charge,
+		number_density = density,
+		boundary_conditions = [
+			["remove", "remove"],
+			["periodic", "periodic"],
+		],
+	)
+
+# Only the initial fields are written
+DiagFields(
+	every = 1000,
+	fields = ["Ex", "Ey", "Rho"],
+)
@@ -4,7 +4,7 @@ from .._Utils import *
 class Field(Diagnostic):
 	"""Class for loading a Field diagnostic"""
 	
-	def _init(self, diagNumber=None, field=None, timesteps=None, subset=None, average=None, data_log=False, moving=False, **kwargs):
+	def _init(self, diagNumber=None, field=None, timesteps=None, subset=None, average=None, data_log=False, moving=False, level=0, **kwargs):
 		
 		self.moving = moving
 		self._subsetinfo = {}
@@ -28,6 +28,10 @@ class Field(Diagnostic):
 				self._error += ["Diagnostic not loaded: no field diagnostic #"+str(diagNumber)+" found"]
 				return
 		
+		# Group of the requested downsampling level
+		self._level = level
+		group = "data" if level == 0 else "data_level"+str(level)
+		
 		# Open the file(s) and load the data
 		self._h5items = {}
 		self._fields = []
@@ -38,9 +42,13 @@ class Field(Diagnostic):
 			except:
 				self._error += ["Diagnostic not loaded: Could not open '"+file+"'"]
 				return
-			self._h5items.update( dict(f["data"]) )
+			if group not in f:
+				self._error += ["Diagnostic not loaded: no downsampling level "+str(level)+" in '"+file+"'"]
+				return
+			self._downsample = f[group].attrs["downsample"] if "downsample" in f[group].attrs else 1
+			self._h5items.update( dict(f[group]) )
 			# Select only the fields that are common to all simulations
-			values = f["data"].values()
+			values = f[group].values()
 			if len(values)==0:
 				self._fields = []
 			elif len(self._fields)==0:
@@ -50,7 +58,7 @@ class Field(Diagnostic):
 		# Remove "tmp" dataset
 		if "tmp" in self._h5items: del self._h5items["tmp"]
 		# Converted to ordered list
-		self._h5items = sorted(self._h5items.values(), key=lambda x:int(x.name[6:]))
+		self._h5items = sorted(self._h5items.values(), key=lambda x:int(x.name.split("/")[-1]))
 		
 		# Case of a cylindrical geometry
 		# Build the list of fields that can be reconstructed
@@ -374,6 +382,8 @@ class Field(Diagnostic):
 		tavg = self.namelist.DiagFields[self.diagNumber].time_average
 		if tavg > 1:
 			s += "\n\tTime_average: " + str(tavg) + " timesteps"
+		if self._downsample > 1:
+			s += "\n\tDownsampled: blocks of " + str(self._downsample) + " cells"
 		if any(self._offset > 0.):
 			s += "\n\tGrid offset: " + ", ".join([str(a) for a in self._offset])
 		if any(self._spacing != self._cell_length):
@@ -401,7 +411,7 @@ class Field(Diagnostic):
 	
 	# get all available timesteps
 	def getAvailableTimesteps(self):
-		try:    times = [float(a.name[6:]) for a in self._h5items]
+		try:    times = [float(a.name.split("/")[-1]) for a in self._h5items]
 		except: times = []
 		return self._np.double(times)
 	
@@ -31,12 +31,24 @@ class TrackParticles(Diagnostic):
 		self.species  = species
 		self._h5items = {}
 		self._locationForTime = {}
-		disorderedfiles = self._findDisorderedFiles()
+		orderedfile = self._results_path[0]+self._os.sep+"TrackParticles_"+species+".h5"
+		
+		# The file may have been written directly in ID order by Smilei (option `ordered`)
+		self._orderedBySmilei = self._isOrderedBySmilei(orderedfile)
+		if self._orderedBySmilei:
+			if len(self._results_path) > 1:
+				self._error += ["Particles tracked with `ordered=True` cannot be read from several directories"]
+				return
+			if not sort:
+				self._error += ["Particles tracked with `ordered=True` are always sorted"]
+				return
+			disorderedfiles = []
+		else:
+			disorderedfiles = self._findDisorderedFiles()
 		
 		# If sorting allowed, then do the sorting
 		if sort:
 			# If the first path does not contain the ordered file (or it is incomplete), we must create it
-			orderedfile = self._results_path[0]+self._os.sep+"TrackParticles_"+species+".h5"
 			if self._needsOrdering(orderedfile):
 				self._orderFiles(disorderedfiles, orderedfile, chunksize)
 				if self._needsOrdering(orderedfile):
@@ -77,7 +89,10 @@ class TrackParticles(Diagnostic):
 			self.available_properties = [v for k,v in properties.items() if k in T0]
 		
 		# Add moving_x in the list of properties
-		if "x" in self.available_properties:
+		if "x" in self.available_properties and self._orderedBySmilei:
+			if "x_moved" in f:
+				self.available_properties += ["moving_x"]
+		elif "x" in self.available_properties:
 			file = disorderedfiles[0]
 			with self._h5py.File(file) as f:
 				try: # python 2
@@ -274,6 +289,10 @@ class TrackParticles(Diagnostic):
 		# Get x_moved if necessary
 		if "moving_x" in self.axes:
 			self._XmovedForTime = {}
+			if self._orderedBySmilei:
+				with self._h5py.File(orderedfile, "r") as f:
+					for t, x_moved in zip(f["Times"][()], f["x_moved"][()]):
+						self._XmovedForTime[int(t)] = x_moved
 			for file in disorderedfiles:
 				with self._h5py.File(file) as f:
 					for t in f["data"].keys():
@@ -348,6 +367,15 @@ class TrackParticles(Diagnostic):
 				f.close()
 		return False
 
+	def _isOrderedBySmilei(self, orderedfile):
+		if not self._os.path.isfile(orderedfile):
+			return False
+		try:
+			with self._h5py.File(orderedfile, "r") as f:
+				return "ordered_by_smilei" in f.attrs.keys()
+		except:
+			return False
+
 	# Method to get info
 	def _info(self):
 		info = "Track particles: species '"+self.species+"'"
@@ -651,6 +679,10 @@ class TrackParticles(Diagnostic):
 		if timestep not in self._timesteps:
 			print("ERROR: timestep "+str(timestep)+" not available")
 			return
+		
+		if self._orderedBySmilei:
+			print("ERROR: iterParticles not available for particles tracked with `ordered=True`")
+			return
 
 		properties = {"Id":"id", "x":"position/x", "y":"position/y", "z":"position/z",
 		              "px":"momentum/x", "py":"momentum/y", "pz":"momentum/z",
@@ -0,0 +1,204 @@
+import os as _os
+import time as _time
+import json as _json
+import mmap as _mmap
+
+
+class StreamFrame(object):
+	"""One frame published by a running simulation in a DiagStream.
+
+	The arrays are numpy views on the shared memory (no copy): they are only valid
+	until the frame is released (see :py:meth:`Stream.release`).
+
+	Attributes:
+	-----------
+	frame: index of the frame
+	timestep: timestep of the frame
+	time: time of the frame
+	x_moved: distance travelled by the moving window
+	patches: array of shape (npatches, 4) containing the coordinates of each patch and its hindex
+	fields: dictionary of arrays of shape (npatches, nx, ny, nz), one block per patch
+	particles: dictionary (one per species) of dictionaries of attribute arrays
+	"""
+	def __init__(self, stream, slot):
+		import numpy as np
+		s = stream._schema
+		header = np.frombuffer(stream._mm, dtype=np.uint64, count=5, offset=slot)
+		self.frame    = int(header[0])
+		self.timestep = int(header[1:2].view(np.int64)[0])
+		self.time     = float(header[2:3].view(np.float64)[0])
+		self.x_moved  = float(header[3:4].view(np.float64)[0])
+		npatches = int(header[4])
+		self.patches = np.frombuffer(stream._mm, dtype=np.int32, count=4*npatches, offset=slot+s["patch_table"]).reshape((npatches, 4))
+		shape = (npatches,) + tuple(s["n_space"])
+		ncells = int(np.prod(s["n_space"]))
+		self.fields = {}
+		for f in s["fields"]:
+			self.fields[f["name"]] = np.frombuffer(stream._mm, dtype=np.float64, count=npatches*ncells, offset=slot+f["offset"]).reshape(shape)
+		self.particles = {}
+		for sp in s["species"]:
+			n = int(np.frombuffer(stream._mm, dtype=np.uint64, count=1, offset=slot+sp["count"])[0])
+			self.particles[sp["name"]] = {}
+			for a in sp["attributes"]:
+				self.particles[sp["name"]][a["name"]] = np.frombuffer(stream._mm, dtype=np.float64, count=n, offset=slot+a["offset"])
+		self._n_space = s["n_space"]
+		self._number_of_patches = s["number_of_patches"]
+
+	def assemble(self, field, fill=float("nan")):
+		"""Places the patches of one field in an array covering the whole simulation box (copy).
+
+		The points which belong to patches of other MPI processes are set to `fill`.
+		"""
+		import numpy as np
+		n = self._n_space
+		data = self.fields[field]
+		result = np.full([n[i]*self._number_of_patches[i] for i in range(len(n))], fill)
+		for ipatch in range(data.shape[0]):
+			index = tuple( slice(self.patches[ipatch,i]*n[i], (self.patches[ipatch,i]+1)*n[i]) for i in range(len(n)) )
+			result[index] = data[ipatch]
+		return result
+
+
+class Stream(object):
+	"""Consumer of a `DiagStream` of a running simulation.
+
+	Maps, without copy, the shared memory where one MPI process of the simulation
+	publishes its frames, and reads them in order::
+
+		stream = happi.Stream(rank=0)
+		for frame in stream:
+			print(frame.timestep, frame.fields["Ex"].max())
+
+	Each frame is released (its slot given back to the simulation) when the next one
+	is requested. The iteration stops when the simulation has finished and all frames were read.
+
+	Parameters:
+	-----------
+	name: the `name` of the DiagStream. If None, the most recent stream with the default
+	      name of the first DiagStream ("smilei_stream0_pid") is read.
+	rank: the MPI rank of the simulation to read (one shared memory segment per rank)
+	timeout: maximum time (in seconds) to wait for the simulation to create the stream
+	"""
+	def __init__(self, name=None, rank=0, timeout=60.):
+		import numpy as np
+		self._mm = None
+		self._segment = None if name is None else "/%s_%d" % (name, rank)
+		t0 = _time.time()
+		while True:
+			if name is None:
+				self._segment = self._findDefault(rank)
+			fd = None if self._segment is None else self._open()
+			if fd is not None:
+				size = _os.fstat(fd).st_size
+				if size > 0:
+					mm = _mmap.mmap(fd, size, _mmap.MAP_SHARED, _mmap.PROT_READ | _mmap.PROT_WRITE)
+					_os.close(fd)
+					if mm[0:8] == b"SMILEIST":
+						self._mm = mm
+						break
+					mm.close()
+				else:
+					_os.close(fd)
+			if _time.time() - t0 > timeout:
+				raise Exception("Stream "+str(self._segment or "smilei_stream0_*")+" not found (waited "+str(timeout)+" s)")
+			_time.sleep(0.1)
+		header = np.frombuffer(self._mm, dtype=np.uint32, count=8)
+		self._header_size = int(header[3])
+		self._nslots = int(header[6])
+		self._slot_size = int(np.frombuffer(self._mm, dtype=np.uint64, count=1, offset=16)[0])
+		self.policy = ["block", "drop", "decimate"][int(header[7])]
+		# Live views on the counters: write_count, read_count, dropped
+		self._counters = np.frombuffer(self._mm, dtype=np.uint64, count=3, offset=32)
+		self._status = np.frombuffer(self._mm, dtype=np.uint32, count=2, offset=56)
+		schema = self._mm[64:self._header_size]
+		self._schema = _json.loads(schema[:schema.find(b"\0")].decode())
+		self.schema = self._schema
+		self._current = None
+		# Start with the oldest frame still available
+		self._next = int(self._counters[1])
+
+	def _findDefault(self, rank):
+		# The default name contains the pid of the simulation: take the most recent one
+		import re
+		pattern = re.compile(r"^smilei_stream0_\d+_%d$" % rank)
+		try:
+			segments = [s for s in _os.listdir("/dev/shm") if pattern.match(s)]
+		except OSError:
+			return None
+		if not segments:
+			return None
+		return "/" + max(segments, key=lambda s: _os.path.getmtime("/dev/shm/"+s))
+
+	def _open(self):
+		try:
+			import _posixshmem
+			return _posixshmem.shm_open(self._segment, _os.O_RDWR, mode=0o600)
+		except ImportError:
+			path = "/dev/shm" + self._segment
+			if _os.path.exists(path):
+				return _os.open(path, _os.O_RDWR)
+		except OSError:
+			pass
+		return None
+
+	def dropped(self):
+		"""Number of frames dropped by the simulation because the buffer was full"""
+		return int(self._counters[2])
+
+	def decimation(self):
+		"""Current decimation factor (policy "decimate")"""
+		return int(self._status[0])
+
+	def finished(self):
+		"""True if the simulation has finished publishing"""
+		return self._status[1] != 0
+
+	def available(self):
+		"""Number of frames published and not yet read"""
+		return int(self._counters[0]) - self._next
+
+	def next(self, timeout=None):
+		"""Releases the current frame and returns the next one.
+
+		Waits at most `timeout` seconds (forever if None). Returns None if no frame arrived,
+		or if the simulation has finished and all frames were read.
+		"""
+		self.release()
+		t0 = _time.time()
+		while self.available() <= 0:
+			if self.finished() and self.available() <= 0:
+				return None
+			if timeout is not None and _time.time() - t0 > timeout:
+				return None
+			_time.sleep(0.001)
+		slot = self._header_size + (self._next % self._nslots) * self._slot_size
+		self._current = StreamFrame(self, slot)
+		self._next += 1
+		return self._current
+
+	def release(self):
+		"""Gives the slot of the current frame back to the simulation. Its arrays become invalid."""
+		if self._current is not None:
+			self._current = None
+			self._counters[1] = self._next
+
+	def close(self):
+		"""Releases the current frame and unmaps the stream"""
+		self.release()
+		self._counters = self._status = None
+		if self._mm is not None:
+			try:
+				self._mm.close()
+			except BufferError:
+				# Some arrays still refer to the shared memory
+				pass
+			self._mm = None
+
+	def __iter__(self):
+		return self
+
+	def __next__(self):
+		frame = self.next()
+		if frame is None:
+			raise StopIteration
+		return frame
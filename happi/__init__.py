@@ -1,5 +1,6 @@
 from ._core import Open
 from ._Utils import multiPlot, Units, openNamelist
+from ._Stream import Stream
 
 import os as _os
 happi_directory = _os.path.dirname(_os.path.abspath(__file__))
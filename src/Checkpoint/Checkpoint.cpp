@@ -720,7 +720,18 @@ void Checkpoint::restartPatch( ElectroMagn *EMfields, std::vector<Species *> &ve
             hid_t diag_gid = H5Gopen( patch_gid, group_name.str().c_str(), H5P_DEFAULT );
             
             for( unsigned int ifield=0; ifield<EMfields->allFields_avg[idiag].size(); ifield++ ) {
-                restartFieldsPerProc( diag_gid, EMfields->allFields_avg[idiag][ifield] );
+                // The size of the average storage changes with the diag parameters
+                Field *field = EMfields->allFields_avg[idiag][ifield];
+                hid_t did = H5Dopen( diag_gid, field->name.c_str(), H5P_DEFAULT );
+                hid_t sid = H5Dget_space( did );
+                hssize_t npoints = H5Sget_simple_extent_npoints( sid );
+                H5Sclose( sid );
+                H5Dclose( did );
+                if( npoints != ( hssize_t )field->globalDims_ ) {
+                    WARNING( "Average Field diag "<<idiag<<" has changed and may produce wrong first output after restart" );
+                    break;
+                }
+                restartFieldsPerProc( diag_gid, field );
             }
             
             H5Gclose( diag_gid );
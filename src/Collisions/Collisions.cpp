@@ -24,6 +24,10 @@ Collisions::Collisions(
     double coulomb_log,
     bool intra_collisions,
     int debug_every,
+    int every,
+    unsigned int collision_bins_merged,
+    double subcycling_threshold,
+    unsigned int subcycling_max,
     CollisionalIonization *ionization,
     CollisionalNuclearReaction *nuclear_reaction,
     string filename
@@ -36,6 +40,10 @@ Collisions::Collisions(
     coulomb_log_( coulomb_log ),
     intra_collisions_( intra_collisions ),
     debug_every_( debug_every ),
+    every_( every ),
+    collision_bins_merged_( collision_bins_merged ),
+    subcycling_threshold_( subcycling_threshold ),
+    subcycling_max_( subcycling_max ),
     filename_( filename )
 {
     coeff1_ = 4.046650232e-21*params.reference_angular_frequency_SI; // h*omega/(2*me*c^2)
@@ -53,6 +61,10 @@ Collisions::Collisions( Collisions *coll )
     coulomb_log_      = coll->coulomb_log_     ;
     intra_collisions_ = coll->intra_collisions_;
     debug_every_      = coll->debug_every_     ;
+    every_            = coll->every_           ;
+    collision_bins_merged_ = coll->collision_bins_merged_;
+    subcycling_threshold_ = coll->subcycling_threshold_;
+    subcycling_max_   = coll->subcycling_max_  ;
     filename_         = coll->filename_        ;
     coeff1_           = coll->coeff1_        ;
     coeff2_           = coll->coeff2_        ;
@@ -165,6 +177,97 @@ void Collisions::calculate_debye_length( Params &params, Patch *patch )
     DEBUG( "Mean Debye length in meters = " << scientific << setprecision( 3 ) << mean_debye_length );
 }
 
+// Reset the sub-cycling arrays when the number of collision bins has changed
+// (new patch, or patch received from another process)
+void Collisions::prepareSubcycling( unsigned int nbin )
+{
+    if( subcycling_threshold_ > 0. && bin_accumulated_time_.size() != nbin ) {
+        bin_accumulated_time_.assign( nbin, 0. );
+        bin_collision_rate_  .assign( nbin, -1. );
+        bin_skipped_         .assign( nbin, 0 );
+    }
+}
+
+// Decide whether one bin must be collided at this step.
+// The bin accumulates the timestep dt until the expected collision parameter,
+// estimated from the rate measured at its last collision, reaches the threshold
+bool Collisions::binCollidesNow( unsigned int ibin, double dt, double &dt_bin )
+{
+    if( subcycling_threshold_ <= 0. ) {
+        dt_bin = dt;
+        return true;
+    }
+    bin_accumulated_time_[ibin] += dt;
+    dt_bin = bin_accumulated_time_[ibin];
+    if( bin_collision_rate_[ibin] < 0.
+     || bin_collision_rate_[ibin] * dt_bin >= subcycling_threshold_
+     || bin_skipped_[ibin] >= subcycling_max_ ) {
+        return true;
+    }
+    bin_skipped_[ibin] ++;
+    return false;
+}
+
+// Store the collision rate measured in one bin, and restart accumulating time
+void Collisions::binCollided( unsigned int ibin, double dt_bin, double s_sum, unsigned int npairs )
+{
+    if( subcycling_threshold_ > 0. ) {
+        bin_collision_rate_  [ibin] = s_sum / ( ( double )npairs * dt_bin );
+        bin_accumulated_time_[ibin] = 0.;
+        bin_skipped_         [ibin] = 0;
+    }
+}
+
+// A bin without enough particles has no meaningful history
+void Collisions::binEmpty( unsigned int ibin )
+{
+    if( subcycling_threshold_ > 0. ) {
+        bin_collision_rate_  [ibin] = -1.;
+        bin_accumulated_time_[ibin] = 0.;
+        bin_skipped_         [ibin] = 0;
+    }
+}
+
+// Volume of a group of cells: each cell volume is obtained from one of its particles
+// in order to account for the half cells at the domain boundaries
+double Collisions::binVolume( Params &params, Patch *patch, unsigned int ibin_start, unsigned int ibin_end )
+{
+    double volume = 0.;
+    for( unsigned int ibin = ibin_start; ibin < ibin_end; ibin++ ) {
+        double cell_volume = params.cell_volume;
+        for( unsigned int g = 0; g < 2; g++ ) {
+            vector<unsigned int> &sg = g==0 ? species_group1_ : species_group2_;
+            unsigned int ispec;
+            for( ispec = 0; ispec < sg.size(); ispec++ ) {
+                Species *s = patch->vecSpecies[sg[ispec]];
+                if( s->last_index[ibin] > s->first_index[ibin] ) {
+                    cell_volume = patch->getPrimalCellVolume( s->particles, s->first_index[ibin], params );
+                    break;
+                }
+            }
+            if( ispec < sg.size() ) {
+                break;
+            }
+        }
+        volume += cell_volume;
+    }
+    return volume;
+}
+
+// Average Debye length squared over the cells of a collision bin (only cells containing plasma)
+double Collisions::binDebyeLengthSquared( Patch *patch, unsigned int ibin_start, unsigned int ibin_end )
+{
+    double debye2 = 0.;
+    unsigned int n = 0;
+    for( unsigned int ibin = ibin_start; ibin < ibin_end; ibin++ ) {
+        if( patch->debye_length_squared[ibin] > 0. ) {
+            debye2 += patch->debye_length_squared[ibin];
+            n++;
+        }
+    }
+    return n>0 ? debye2 / ( double )n : 0.;
+}
+
 // Calculates the collisions for a given Collisions object
 void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagnostic *> &localDiags )
 {
@@ -192,10 +295,24 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
     
     NuclearReaction->prepare();
     
-    // Loop bins of particles (typically, cells, but may also be clusters)
-    unsigned int nbin = patch->vecSpecies[0]->first_index.size();
+    // Collision bins are groups of `collision_bins_merged_` consecutive sorting bins (typically, cells).
+    // The particles of consecutive sorting bins are contiguous in each species.
+    unsigned int nsortbin = patch->vecSpecies[0]->first_index.size();
+    unsigned int nbin = ( nsortbin + collision_bins_merged_ - 1 ) / collision_bins_merged_;
+    vector<unsigned int> first( patch->vecSpecies.size() ), last( patch->vecSpecies.size() );
+    prepareSubcycling( nbin );
+    double dt = params.timestep * ( double )every_;
+    
+    // Loop collision bins
     for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
     
+        unsigned int ibin_start = ibin * collision_bins_merged_;
+        unsigned int ibin_end   = min( ibin_start + collision_bins_merged_, nsortbin );
+        for( unsigned int ispec=0 ; ispec<patch->vecSpecies.size() ; ispec++ ) {
+            first[ispec] = patch->vecSpecies[ispec]->first_index[ibin_start];
+            last [ispec] = patch->vecSpecies[ispec]->last_index [ibin_end-1];
+        }
+        
         // get number of particles for all necessary species
         for( unsigned int i=0; i<2; i++ ) { // try twice to ensure group 1 has more macro-particles
             nspec1 = sg1->size();
@@ -206,12 +323,12 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             npart2 = 0;
             for( ispec1=0 ; ispec1<nspec1 ; ispec1++ ) {
                 s1 = patch->vecSpecies[( *sg1 )[ispec1]];
-                np1[ispec1] = s1->last_index[ibin] - s1->first_index[ibin];
+                np1[ispec1] = last[( *sg1 )[ispec1]] - first[( *sg1 )[ispec1]];
                 npart1 += np1[ispec1];
             }
             for( ispec2=0 ; ispec2<nspec2 ; ispec2++ ) {
                 s2 = patch->vecSpecies[( *sg2 )[ispec2]];
-                np2[ispec2] = s2->last_index[ibin] - s2->first_index[ibin];
+                np2[ispec2] = last[( *sg2 )[ispec2]] - first[( *sg2 )[ispec2]];
                 npart2 += np2[ispec2];
             }
             if( npart2 <= npart1 ) {
@@ -223,13 +340,20 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         // now group1 has more macro-particles than group2
         
         // skip to next bin if no particles
-        if( npart1==0 || npart2==0 ) {
+        if( npart1==0 || npart2==0 || ( intra_collisions_ && npart1 < 2 ) ) {
+            binEmpty( ibin );
+            continue;
+        }
+        
+        // Sub-cycling: skip weakly collisional bins, which accumulate their time
+        double dt_bin;
+        if( ! binCollidesNow( ibin, dt, dt_bin ) ) {
             continue;
         }
         
         // Set the debye length
         if( Collisions::debye_length_required ) {
-            debye2 = patch->debye_length_squared[ibin];
+            debye2 = binDebyeLengthSquared( patch, ibin_start, ibin_end );
         }
         
         // Shuffle particles to have random pairs
@@ -244,9 +368,6 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             swap( index1[i-1], index1[p] );
         }
         if( intra_collisions_ ) { // In the case of collisions within one species
-            if( npart1 < 2 ) {
-                continue;
-            }
             npairs = ( npart1 + 1 ) / 2; // half as many pairs as macro-particles
             index2.resize( npairs );
             for( unsigned int i=0; i<npairs; i++ ) {
@@ -271,7 +392,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         for( ispec1=0 ; ispec1<nspec1 ; ispec1++ ) {
             s1 = patch->vecSpecies[( *sg1 )[ispec1]];
             p1 = s1->particles;
-            for( int i = s1->first_index[ibin]; i < s1->last_index[ibin]; i++ ) {
+            for( unsigned int i = first[( *sg1 )[ispec1]]; i < last[( *sg1 )[ispec1]]; i++ ) {
                 n1 += p1->weight( i );
             }
         }
@@ -279,17 +400,15 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         for( ispec2=0 ; ispec2<nspec2 ; ispec2++ ) {
             s2 = patch->vecSpecies[( *sg2 )[ispec2]];
             p2 = s2->particles;
-            for( int i = s2->first_index[ibin]; i < s2->last_index[ibin]; i++ ) {
+            for( unsigned int i = first[( *sg2 )[ispec2]]; i < last[( *sg2 )[ispec2]]; i++ ) {
                 n2 += p2->weight( i );
             }
         }
         
         // Pre-calculate some numbers before the big loop
-        s1 = patch->vecSpecies[( *sg1 )[0]];
-        p1 = s1->particles;
-        double inv_cell_volume = 1./patch->getPrimalCellVolume( p1, s1->first_index[ibin], params );
+        double inv_cell_volume = 1./binVolume( params, patch, ibin_start, ibin_end );
         unsigned int ncorr = intra_collisions_ ? 2*npairs-1 : npairs;
-        double dt_corr = params.timestep * ((double)ncorr) * inv_cell_volume;
+        double dt_corr = dt_bin * ((double)ncorr) * inv_cell_volume;
         coeff3 = coeff2_ * dt_corr;
         coeff4 = pow( 3.*coeff2_, -1./3. ) * dt_corr;
         double weight_correction_1 = 1. / (double)( (npairs-1) / N2max );
@@ -302,6 +421,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
         // Now start the real loop on pairs of particles
         // See equations in http://dx.doi.org/10.1063/1.4742167
         // ----------------------------------------------------
+        double s_sum = 0.;
         for( unsigned int i = 0; i<npairs; i++ ) {
             
             // find species and index i1 of particle "1"
@@ -317,8 +437,8 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             
             s1 = patch->vecSpecies[( *sg1 )[ispec1]];
             s2 = patch->vecSpecies[( *sg2 )[ispec2]];
-            i1 += s1->first_index[ibin];
-            i2 += s2->first_index[ibin];
+            i1 += first[( *sg1 )[ispec1]];
+            i2 += first[( *sg2 )[ispec2]];
             p1 = s1->particles;
             p2 = s2->particles;
             
@@ -340,6 +460,7 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             Ionization->apply( patch, p1, i1, p2, i2, dt_corr*weight_correction );
             
             ncol ++;
+            s_sum += s;
             if( debug ) {
                 smean_    += s;
                 logLmean_ += logL;
@@ -348,6 +469,8 @@ void Collisions::collide( Params &params, Patch *patch, int itime, vector<Diagno
             
         } // end loop on pairs of particles
         
+        binCollided( ibin, dt_bin, s_sum, npairs );
+        
     } // end loop on bins
     
     Ionization->finish( params, patch, localDiags );
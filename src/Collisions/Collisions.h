@@ -28,6 +28,10 @@ public:
         double coulomb_log,
         bool intra_collisions,
         int debug_every,
+        int every,
+        unsigned int collision_bins_merged,
+        double subcycling_threshold,
+        unsigned int subcycling_max,
         CollisionalIonization *ionization,
         CollisionalNuclearReaction *nuclear_reaction,
         std::string
@@ -49,6 +53,12 @@ public:
     //! Outputs the debug info if requested
     static void debug( Params &params, int itime, unsigned int icoll, VectorPatch &vecPatches );
     
+    //! True if this Collisions object must be applied at the given timestep
+    inline bool isDue( int itime )
+    {
+        return itime % every_ == 0;
+    };
+    
     //! CollisionalIonization object, created if ionization required
     CollisionalIonization *Ionization;
     
@@ -71,6 +81,27 @@ protected:
     //! Number of timesteps between each dump of collisions debugging
     int debug_every_;
     
+    //! Number of timesteps between each application of the collisions
+    int every_;
+    
+    //! Number of consecutive sorting bins (typically, cells) merged into one collision bin
+    unsigned int collision_bins_merged_;
+    
+    //! Minimum expected collision parameter for a bin to be collided (0 means no sub-cycling)
+    double subcycling_threshold_;
+    
+    //! Maximum number of consecutive collision steps a bin may be skipped
+    unsigned int subcycling_max_;
+    
+    //! Time accumulated in each collision bin since its last collision
+    std::vector<double> bin_accumulated_time_;
+    
+    //! Collision parameter per unit time measured in each bin (negative when unknown)
+    std::vector<double> bin_collision_rate_;
+    
+    //! Number of consecutive collision steps each bin has been skipped
+    std::vector<unsigned int> bin_skipped_;
+    
     //! Hdf5 file name
     std::string filename_;
     
@@ -80,6 +111,24 @@ protected:
     const double twoPi = 2. * 3.14159265358979323846;
     double coeff1_, coeff2_;
     
+    //! Reset the sub-cycling arrays when the number of collision bins has changed
+    void prepareSubcycling( unsigned int nbin );
+    
+    //! Returns true if the bin must be collided now, with its accumulated timestep dt_bin
+    bool binCollidesNow( unsigned int ibin, double dt, double &dt_bin );
+    
+    //! Stores the collision rate measured in a bin after it has been collided
+    void binCollided( unsigned int ibin, double dt_bin, double s_sum, unsigned int npairs );
+    
+    //! Forgets the history of a bin which did not contain enough particles to collide
+    void binEmpty( unsigned int ibin );
+    
+    //! Volume of the cells ibin_start to ibin_end-1, grouped in one collision bin
+    double binVolume( Params &params, Patch *patch, unsigned int ibin_start, unsigned int ibin_end );
+    
+    //! Average Debye length squared in the cells ibin_start to ibin_end-1
+    double binDebyeLengthSquared( Patch *patch, unsigned int ibin_start, unsigned int ibin_end );
+    
     // Collide one particle with another
     // See equations in http://dx.doi.org/10.1063/1.4742167
     inline double one_collision(
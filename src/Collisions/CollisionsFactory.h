@@ -70,6 +70,35 @@ public:
         debug_every = 0; // default
         PyTools::extract( "debug_every", debug_every, "Collisions", n_collisions );
         
+        // Number of timesteps between each application of the collisions
+        int every = 1; // default
+        PyTools::extract( "every", every, "Collisions", n_collisions );
+        if( every < 1 ) {
+            ERROR( "In collisions #" << n_collisions << ": `every` must be a positive integer" );
+        }
+        if( debug_every > 0 && debug_every % every != 0 ) {
+            ERROR( "In collisions #" << n_collisions << ": `debug_every` must be a multiple of `every`" );
+        }
+        
+        // Number of cells grouped in each collision bin
+        int collision_bins_merged = 1; // default
+        PyTools::extract( "collision_bins_merged", collision_bins_merged, "Collisions", n_collisions );
+        if( collision_bins_merged < 1 ) {
+            ERROR( "In collisions #" << n_collisions << ": `collision_bins_merged` must be a positive integer" );
+        }
+        
+        // Adaptive sub-cycling of weakly collisional bins
+        double subcycling_threshold = 0.; // default
+        PyTools::extract( "subcycling_threshold", subcycling_threshold, "Collisions", n_collisions );
+        int subcycling_max = 10; // default
+        PyTools::extract( "subcycling_max", subcycling_max, "Collisions", n_collisions );
+        if( subcycling_threshold < 0. ) {
+            ERROR( "In collisions #" << n_collisions << ": `subcycling_threshold` must be positive or zero" );
+        }
+        if( subcycling_max < 0 ) {
+            ERROR( "In collisions #" << n_collisions << ": `subcycling_max` must be positive or zero" );
+        }
+        
         // Collisional ionization
         Z = 0; // default
         PyObject * ionizing = PyTools::extract_py( "ionizing", "Collisions", n_collisions );
@@ -242,6 +271,16 @@ public:
             MESSAGE( 2, "Collisions between species " << mystream.str() << ")" );
         }
         MESSAGE( 2, "Coulomb logarithm: " << clog );
+        if( every>1 ) {
+            MESSAGE( 2, "Applied every " << every << " timesteps" );
+        }
+        if( collision_bins_merged>1 ) {
+            MESSAGE( 2, "Collision bins of " << collision_bins_merged << " sorting bins" );
+        }
+        if( subcycling_threshold>0. ) {
+            MESSAGE( 2, "Sub-cycling bins with expected collision parameter below " << subcycling_threshold
+                     << " (at most " << subcycling_max << " times)" );
+        }
         if( debug_every>0 ) {
             MESSAGE( 2, "Debug every " << debug_every << " timesteps" );
         }
@@ -289,7 +328,8 @@ public:
         }
         
         // new Collisions object
-        if( sgroup[0].size()>1 || sgroup[1].size()>1 ) {
+        // (CollisionsSingle shuffles particles in memory, which is not possible across cells)
+        if( sgroup[0].size()>1 || sgroup[1].size()>1 || collision_bins_merged>1 ) {
             return new Collisions(
                        params,
                        n_collisions,
@@ -297,6 +337,10 @@ public:
                        sgroup[1],
                        clog, intra,
                        debug_every,
+                       every,
+                       collision_bins_merged,
+                       subcycling_threshold,
+                       subcycling_max,
                        Ionization,
                        NuclearReaction,
                        filename
@@ -309,6 +353,10 @@ public:
                        sgroup[1],
                        clog, intra,
                        debug_every,
+                       every,
+                       collision_bins_merged,
+                       subcycling_threshold,
+                       subcycling_max,
                        Ionization,
                        NuclearReaction,
                        filename
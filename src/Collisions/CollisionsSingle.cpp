@@ -45,14 +45,24 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
     NuclearReaction->prepare();
     
     // Loop bins of particles (typically, cells, but may also be clusters)
+    // This version always has one sorting bin per collision bin
     unsigned int nbin = patch->vecSpecies[0]->first_index.size();
+    prepareSubcycling( nbin );
+    double dt = params.timestep * ( double )every_;
     for( unsigned int ibin = 0 ; ibin < nbin ; ibin++ ) {
     
         // get number of particles for all necessary species
         np1 = s1->last_index[ibin] - s1->first_index[ibin];
         np2 = s2->last_index[ibin] - s2->first_index[ibin];
         // skip to next bin if no particles
-        if( np1==0 || np2==0 ) {
+        if( np1==0 || np2==0 || ( intra_collisions_ && np1 < 2 ) ) {
+            binEmpty( ibin );
+            continue;
+        }
+        
+        // Sub-cycling: skip weakly collisional bins, which accumulate their time
+        double dt_bin;
+        if( ! binCollidesNow( ibin, dt, dt_bin ) ) {
             continue;
         }
         // Ensure species 1 has more macro-particles
@@ -73,9 +83,6 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         // Shuffle particles of species 1 to have random pairs
         // In the case of collisions within one species
         if( intra_collisions_ ) {
-            if( np1 < 2 ) {
-                continue;
-            }
             npairs = ( np1 + 1 ) / 2; // half as many pairs as macro-particles
             N2max = np1 - npairs; // number of not-repeated particles (in second half only)
             first_index2 += npairs;
@@ -115,7 +122,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         // Pre-calculate some numbers before the big loop
         double inv_cell_volume = 1./patch->getPrimalCellVolume( p1, s1->first_index[ibin], params );
         unsigned int ncorr = intra_collisions_ ? 2*npairs-1 : npairs;
-        double dt_corr = params.timestep * ((double)ncorr) * inv_cell_volume;
+        double dt_corr = dt_bin * ((double)ncorr) * inv_cell_volume;
         coeff3 = coeff2_ * dt_corr;
         coeff4 = pow( 3.*coeff2_, -1./3. ) * dt_corr;
         double weight_correction_1 = 1. / (double)( (npairs-1) / N2max );
@@ -127,6 +134,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
         
         // Now start the real loop on pairs of particles
         // ----------------------------------------------------
+        double s_sum = 0.;
         for( unsigned int i=0; i<npairs; i++ ) {
             
             i1 = first_index1 + i;
@@ -150,6 +158,7 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             Ionization->apply( patch, p1, i1, p2, i2, dt_corr*weight_correction );
             
             ncol ++;
+            s_sum += s;
             if( debug ) {
                 smean_    += s;
                 logLmean_ += logL;
@@ -158,6 +167,8 @@ void CollisionsSingle::collide( Params &params, Patch *patch, int itime, vector<
             
         } // end loop on pairs of particles
         
+        binCollided( ibin, dt_bin, s_sum, npairs );
+        
     } // end loop on bins
     
     Ionization->finish( params, patch, localDiags );
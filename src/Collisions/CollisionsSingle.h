@@ -26,6 +26,10 @@ public:
         double coulomb_log,
         bool intra_collisions,
         int debug_every,
+        int every,
+        unsigned int collision_bins_merged,
+        double subcycling_threshold,
+        unsigned int subcycling_max,
         CollisionalIonization *ionization,
         CollisionalNuclearReaction *nuclear_reaction,
         std::string fname
@@ -37,6 +41,10 @@ public:
         coulomb_log,
         intra_collisions,
         debug_every,
+        every,
+        collision_bins_merged,
+        subcycling_threshold,
+        subcycling_max,
         ionization,
         nuclear_reaction,
         fname
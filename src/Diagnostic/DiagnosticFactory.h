@@ -10,6 +10,7 @@
 #include "DiagnosticScalar.h"
 #include "DiagnosticTrack.h"
 #include "DiagnosticPerformances.h"
+#include "DiagnosticStream.h"
 
 #include "DiagnosticFields1D.h"
 #include "DiagnosticFields2D.h"
@@ -89,6 +90,10 @@ public:
             vecDiagnostics.push_back( new DiagnosticTrack( params, smpi, vecPatches, n_diag_track, vecDiagnostics.size(), openPMD ) );
         }
         
+        for( unsigned int n_diag_stream = 0; n_diag_stream < PyTools::nComponents( "DiagStream" ); n_diag_stream++ ) {
+            vecDiagnostics.push_back( new DiagnosticStream( params, smpi, vecPatches, n_diag_stream ) );
+        }
+        
         if( PyTools::nComponents( "DiagPerformances" ) > 0 ) {
             vecDiagnostics.push_back( new DiagnosticPerformances( params, smpi ) );
         }
@@ -1,8 +1,11 @@
 
 #include <string>
+#include <algorithm>
+#include <cmath>
 
 #include "DiagnosticFields.h"
 #include "VectorPatch.h"
+#include "Field1D.h"
 
 using namespace std;
 
@@ -28,6 +31,17 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     }
     time_average_inv = 1./( ( double )time_average );
     
+    // Extract the precision of the time-average accumulators
+    string precision( "double" );
+    PyTools::extract( "time_average_precision", precision, "DiagFields", ndiag );
+    if( precision != "double" && precision != "single" ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `time_average_precision` must be \"double\" or \"single\"" );
+    }
+    avg_single_ = precision == "single";
+    if( avg_single_ && params.geometry == "AMcylindrical" ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `time_average_precision` is not available in AMcylindrical geometry" );
+    }
+    
     // Define the filename
     ostringstream fn( "" );
     fn << "Fields"<< ndiag <<".h5";
@@ -93,6 +107,7 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
             subgrids.push_back( PySequence_Fast_GET_ITEM( subgrid, is ) );
         }
     }
+    bool has_subgrid = subgrid != Py_None;
     Py_DECREF( subgrid );
     // Verify the number of subgrids
     unsigned int nsubgrid = subgrids.size();
@@ -131,12 +146,76 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
         }
     }
     
+    n_space_ = params.n_space;
+    oversize_ = params.oversize;
+    n_space_.resize( params.nDim_field );
+    oversize_.resize( params.nDim_field );
+    
+    // Extract the downsampling factors (one per level of the pyramid)
+    PyObject *py_downsample = PyTools::extract_py( "downsample", "DiagFields", ndiag );
+    unsigned int factor;
+    if( py_downsample == Py_None ) {
+    } else if( PyTools::py2scalar( py_downsample, factor ) ) {
+        downsample_.push_back( factor );
+    } else if( ! PyTools::py2vector( py_downsample, downsample_ ) ) {
+        ERROR( "Diagnostic Fields #"<<ndiag<<" `downsample` must be an integer or a list of integers" );
+    }
+    Py_DECREF( py_downsample );
+    if( downsample_.size() > 0 ) {
+        if( params.geometry == "AMcylindrical" ) {
+            ERROR( "Diagnostic Fields #"<<ndiag<<" `downsample` is not available in AMcylindrical geometry" );
+        }
+        if( has_subgrid ) {
+            ERROR( "Diagnostic Fields #"<<ndiag<<" cannot have both `subgrid` and `downsample`" );
+        }
+        level_patch_shape_.resize( downsample_.size() );
+        for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+            if( downsample_[ilevel] < 2 ) {
+                ERROR( "Diagnostic Fields #"<<ndiag<<" `downsample` factors must be at least 2" );
+            }
+            // Each level is calculated from the previous one
+            if( ilevel > 0 && downsample_[ilevel] % downsample_[ilevel-1] != 0 ) {
+                ERROR( "Diagnostic Fields #"<<ndiag<<" each `downsample` factor must be a multiple of the previous one" );
+            }
+            for( unsigned int i=0; i<params.nDim_field; i++ ) {
+                if( params.n_space[i] % downsample_[ilevel] != 0 ) {
+                    ERROR( "Diagnostic Fields #"<<ndiag<<" `downsample` factor "<<downsample_[ilevel]<<" does not divide the patch size ("<<params.n_space[i]<<" cells) on axis #"<<i );
+                }
+                level_patch_shape_[ilevel].push_back( params.n_space[i] / downsample_[ilevel] );
+            }
+        }
+    }
+    level_refHindex_ = -1;
+    level_npatches_ = -1;
+    
     // Some output
     ostringstream p( "" );
     p << "(time average = " << time_average << ")";
-    MESSAGE( 1, "Diagnostic Fields #"<<ndiag<<" "<<( time_average>1?p.str():"" )<<" :" );
+    ostringstream d( "" );
+    if( downsample_.size() > 0 ) {
+        d << "(downsampled by";
+        for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+            d << " " << downsample_[ilevel];
+        }
+        d << ")";
+    }
+    MESSAGE( 1, "Diagnostic Fields #"<<ndiag<<" "<<( time_average>1?p.str():"" )<<d.str()<<" :" );
     MESSAGE( 2, ss.str() );
     
+    // In cartesian geometries, the time-average is accumulated only on the points of the patch
+    // that may be written: n_space+2 points in each direction from the first point after the ghost cells
+    // (n_space+1 points read by getField, one more for the dual fields of the downsampling).
+    // Only the points of the subgrid are accumulated, unless the moving window changes the points
+    // of the subgrid held by each patch during the average
+    if( time_average > 1 && params.geometry != "AMcylindrical" ) {
+        for( unsigned int i=0; i<params.nDim_field; i++ ) {
+            avg_shape_.push_back( params.n_space[i] + 2 );
+        }
+        avg_subgrid_only_ = downsample_.size() == 0 && PyTools::nComponents( "MovingWindow" ) == 0;
+    } else {
+        avg_subgrid_only_ = false;
+    }
+    
     // Create new fields in each patch, for time-average storage
     if( ! smpi->test_mode ) {
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
@@ -144,10 +223,25 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
             if( time_average > 1 ) {
                 for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ )
                     vecPatches( ipatch )->EMfields->allFields_avg[diag_n].push_back(
+                        avg_shape_.size() > 0 ?
+                        createAverageAccumulator( fields_names[ifield] ) :
                         vecPatches( ipatch )->EMfields->createField( fields_names[ifield],params )
                     );
             }
         }
+        // Fields where each thread expands the averages before output
+        if( avg_shape_.size() > 0 ) {
+            int nthreads = 1;
+#ifdef _OPENMP
+            nthreads = omp_get_max_threads();
+#endif
+            avg_expanded_.resize( nthreads );
+            for( int ithread=0; ithread<nthreads; ithread++ ) {
+                for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
+                    avg_expanded_[ithread].push_back( vecPatches( 0 )->EMfields->createField( fields_names[ifield], params ) );
+                }
+            }
+        }
     }
     
     // Extract the time selection
@@ -169,6 +263,34 @@ DiagnosticFields::DiagnosticFields( Params &params, SmileiMPI *smpi, VectorPatch
     H5Pset_dxpl_mpio( write_plist, H5FD_MPIO_COLLECTIVE );
     dcreate = H5Pcreate( H5P_DATASET_CREATE );
     
+    // Prepare the datasets of each downsampling level
+    for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+        vector<hsize_t> shape( params.nDim_field );
+        hsize_t size = 1;
+        for( unsigned int i=0; i<params.nDim_field; i++ ) {
+            shape[i] = ( hsize_t )params.number_of_patches[i] * level_patch_shape_[ilevel][i];
+            size *= shape[i];
+        }
+        level_filespace_.push_back( H5Screate_simple( params.nDim_field, &shape[0], NULL ) );
+        hsize_t one = 1;
+        level_memspace_.push_back( H5Screate_simple( 1, &one, NULL ) );
+        // Define the chunk size (necessary above 2^28 points)
+        level_dcreate_.push_back( H5Pcreate( H5P_DATASET_CREATE ) );
+        const hsize_t max_size = 4294967295/2/sizeof( double );
+        if( size > max_size ) {
+            hsize_t n_chunks = 1 + ( size-1 ) / max_size;
+            vector<hsize_t> chunk_size = shape;
+            chunk_size[0] = shape[0] / n_chunks;
+            if( n_chunks * chunk_size[0] < shape[0] ) {
+                chunk_size[0]++;
+            }
+            H5Pset_layout( level_dcreate_[ilevel], H5D_CHUNKED );
+            H5Pset_chunk( level_dcreate_[ilevel], params.nDim_field, &chunk_size[0] );
+        }
+    }
+    level_data_.resize( downsample_.size() );
+    level_patch_offset_.resize( downsample_.size() );
+    
     // Prepare some openPMD parameters
     field_type.resize( fields_names.size() );
     for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
@@ -192,6 +314,16 @@ DiagnosticFields::~DiagnosticFields()
 {
     H5Pclose( write_plist );
     H5Pclose( dcreate );
+    for( unsigned int ithread=0; ithread<avg_expanded_.size(); ithread++ ) {
+        for( unsigned int ifield=0; ifield<avg_expanded_[ithread].size(); ifield++ ) {
+            delete avg_expanded_[ithread][ifield];
+        }
+    }
+    for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+        H5Sclose( level_filespace_[ilevel] );
+        H5Sclose( level_memspace_[ilevel] );
+        H5Pclose( level_dcreate_[ilevel] );
+    }
     
     delete timeSelection;
     delete flush_timeSelection;
@@ -233,6 +365,19 @@ void DiagnosticFields::openFile( Params &params, SmileiMPI *smpi, bool newfile )
         
         // Make main "data" group where everything will be stored (required by openPMD)
         data_group_id = H5::group( fileId_, "data" );
+        
+        // The first downsampling level goes in "data", the next ones in other groups
+        level_group_id_.resize( downsample_.size() );
+        for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+            if( ilevel == 0 ) {
+                level_group_id_[ilevel] = data_group_id;
+            } else {
+                ostringstream name( "" );
+                name << "data_level" << ilevel;
+                level_group_id_[ilevel] = H5::group( fileId_, name.str() );
+            }
+            H5::attr( level_group_id_[ilevel], "downsample", downsample_[ilevel] );
+        }
     } else {
         // Open the existing file
         hid_t pid = H5Pcreate( H5P_FILE_ACCESS );
@@ -240,6 +385,16 @@ void DiagnosticFields::openFile( Params &params, SmileiMPI *smpi, bool newfile )
         fileId_ = H5Fopen( filename.c_str(), H5F_ACC_RDWR, pid );
         H5Pclose( pid );
         data_group_id = H5Gopen( fileId_, "data", H5P_DEFAULT );
+        level_group_id_.resize( downsample_.size() );
+        for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+            if( ilevel == 0 ) {
+                level_group_id_[ilevel] = data_group_id;
+            } else {
+                ostringstream name( "" );
+                name << "data_level" << ilevel;
+                level_group_id_[ilevel] = H5Gopen( fileId_, name.str().c_str(), H5P_DEFAULT );
+            }
+        }
     }
 }
 
@@ -267,6 +422,10 @@ void DiagnosticFields::closeFile()
         H5Dclose( tmp_dset_id );
     }
     
+    for( unsigned int ilevel=1; ilevel<level_group_id_.size(); ilevel++ ) {
+        H5Gclose( level_group_id_[ilevel] );
+    }
+    level_group_id_.resize( 0 );
     if( data_group_id>0 ) {
         H5Gclose( data_group_id );
     }
@@ -301,7 +460,12 @@ bool DiagnosticFields::prepare( int itime )
 void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers )
 {
     // If time-averaging, increment the average
-    if( time_average>1 ) {
+    if( time_average>1 && avg_shape_.size() > 0 ) {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            incrementAverage( vecPatches( ipatch ) );
+        }
+    } else if( time_average>1 ) {
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
             for( unsigned int ifield=0; ifield<fields_names.size(); ifield++ ) {
@@ -322,7 +486,11 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
     {
         // Calculate the structure of the file depending on 1D, 2D, ...
         refHindex = ( unsigned int )( vecPatches.refHindex_ );
-        setFileSplitting( smpi, vecPatches );
+        if( downsample_.size() > 0 ) {
+            setDownsampleSplitting( vecPatches );
+        } else {
+            setFileSplitting( smpi, vecPatches );
+        }
         
         // Create group for this iteration
         ostringstream name_t;
@@ -331,6 +499,10 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         status = H5Lexists( data_group_id, name_t.str().c_str(), H5P_DEFAULT );
         if( status==0 ) {
             iteration_group_id = H5::group( data_group_id, name_t.str().c_str() );
+            level_iteration_group_id_.resize( downsample_.size() );
+            for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+                level_iteration_group_id_[ilevel] = ilevel == 0 ? iteration_group_id : H5::group( level_group_id_[ilevel], name_t.str().c_str() );
+            }
         }
         // Warning if file unreachable
         if( status < 0 ) {
@@ -340,6 +512,10 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         openPMD_->writeBasePathAttributes( iteration_group_id, itime );
         // Add openPMD attributes ( "meshesPath" )
         openPMD_->writeMeshesAttributes( iteration_group_id );
+        for( unsigned int ilevel=1; ilevel<level_iteration_group_id_.size(); ilevel++ ) {
+            openPMD_->writeBasePathAttributes( level_iteration_group_id_[ilevel], itime );
+            openPMD_->writeMeshesAttributes( level_iteration_group_id_[ilevel] );
+        }
     }
     #pragma omp barrier
     
@@ -357,11 +533,26 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         #pragma omp barrier
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-            getField( vecPatches( ipatch ), ifield );
+            if( downsample_.size() > 0 ) {
+                downsampleField( vecPatches( ipatch ), ifield );
+            } else {
+                getField( vecPatches( ipatch ), ifield );
+            }
         }
         
         #pragma omp master
-        {
+        if( downsample_.size() > 0 ) {
+            // Write each level in its group
+            for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+                hid_t dset_id  = H5Dcreate( level_iteration_group_id_[ilevel], fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, level_filespace_[ilevel], H5P_DEFAULT, level_dcreate_[ilevel], H5P_DEFAULT );
+                H5Dwrite( dset_id, H5T_NATIVE_DOUBLE, level_memspace_[ilevel], level_filespace_[ilevel], write_plist, &( level_data_[ilevel][0] ) );
+                openPMD_->writeDownsampledFieldAttributes( dset_id, downsample_[ilevel] );
+                openPMD_->writeRecordAttributes( dset_id, field_type[ifield] );
+                openPMD_->writeFieldRecordAttributes( dset_id );
+                openPMD_->writeComponentAttributes( dset_id, field_type[ifield] );
+                H5Dclose( dset_id );
+            }
+        } else {
             // Create field dataset in HDF5
             hid_t dset_id  = H5Dcreate( iteration_group_id, fields_names[ifield].c_str(), H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcreate, H5P_DEFAULT );
             
@@ -387,6 +578,10 @@ void DiagnosticFields::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         double x_moved = simWindow ? simWindow->getXmoved() : 0.;
         H5::attr( iteration_group_id, "x_moved", x_moved );
         
+        for( unsigned int ilevel=1; ilevel<level_iteration_group_id_.size(); ilevel++ ) {
+            H5::attr( level_iteration_group_id_[ilevel], "x_moved", x_moved );
+            H5Gclose( level_iteration_group_id_[ilevel] );
+        }
         H5Gclose( iteration_group_id );
         if( tmp_dset_id>0 ) {
             H5Dclose( tmp_dset_id );
@@ -423,7 +618,13 @@ uint64_t DiagnosticFields::getDiskFootPrint( int istart, int istop, Patch *patch
     footprint += ndumps * nfields * 1200;
     
     // Add size of each field
-    footprint += ndumps * nfields * ( uint64_t )( total_dataset_size * 8 );
+    if( downsample_.size() > 0 ) {
+        for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+            footprint += ndumps * nfields * ( uint64_t )H5Sget_simple_extent_npoints( level_filespace_[ilevel] ) * 8;
+        }
+    } else {
+        footprint += ndumps * nfields * ( uint64_t )( total_dataset_size * 8 );
+    }
     
     return footprint;
 }
@@ -473,3 +674,304 @@ void DiagnosticFields::findSubgridIntersection(
         }
     }
 }
+
+
+// The blocks of each patch are written directly at their place in the HDF5 selection
+// of this MPI process: a union of one hyperslab per patch, ordered in the C order of the file.
+// Sorting the patches by coordinates, the position of a point (patch coordinates X, Y, Z and
+// indices x, y, z in the patch) is: start + x*stride_x + y*stride_y + z
+void DiagnosticFields::setDownsampleSplitting( VectorPatch &vecPatches )
+{
+    int npatches = vecPatches.size();
+    if( ( int )refHindex == level_refHindex_ && npatches == level_npatches_ ) {
+        return;
+    }
+    level_refHindex_ = refHindex;
+    level_npatches_ = npatches;
+    
+    unsigned int ndim = n_space_.size();
+    
+    // Sort the patches by coordinates
+    vector<unsigned int> sorted( npatches );
+    vector<vector<unsigned int> > coordinates( npatches );
+    for( int ipatch=0; ipatch<npatches; ipatch++ ) {
+        unsigned int h = vecPatches( ipatch )->Hindex() - refHindex;
+        sorted[ipatch] = h;
+        coordinates[h] = vecPatches( ipatch )->Pcoordinates;
+        coordinates[h].resize( ndim );
+    }
+    sort( sorted.begin(), sorted.end(), [&coordinates]( unsigned int a, unsigned int b ) {
+        return coordinates[a] < coordinates[b];
+    } );
+    
+    // For each depth d, first and last sorted patches sharing the first d coordinates
+    vector<vector<int> > first( ndim+1, vector<int>( npatches ) ), last( ndim+1, vector<int>( npatches ) );
+    for( unsigned int d=0; d<=ndim; d++ ) {
+        for( int k=0; k<npatches; k++ ) {
+            bool same = k>0 && equal( coordinates[sorted[k]].begin(), coordinates[sorted[k]].begin()+d, coordinates[sorted[k-1]].begin() );
+            first[d][k] = same ? first[d][k-1] : k;
+        }
+        for( int k=npatches-1; k>=0; k-- ) {
+            bool same = k<npatches-1 && equal( coordinates[sorted[k]].begin(), coordinates[sorted[k]].begin()+d, coordinates[sorted[k+1]].begin() );
+            last[d][k] = same ? last[d][k+1] : k;
+        }
+    }
+    
+    for( unsigned int ilevel=0; ilevel<downsample_.size(); ilevel++ ) {
+        vector<unsigned int> &shape = level_patch_shape_[ilevel];
+        // Number of points of one patch in the directions after d
+        vector<uint64_t> tail( ndim+1, 1 );
+        for( int d=ndim-1; d>=0; d-- ) {
+            tail[d] = tail[d+1] * shape[d];
+        }
+        
+        level_patch_offset_[ilevel].resize( npatches * ( ndim+1 ) );
+        H5Sselect_none( level_filespace_[ilevel] );
+        vector<hsize_t> offset( ndim ), count( ndim, 1 ), block( shape.begin(), shape.end() );
+        for( int k=0; k<npatches; k++ ) {
+            uint64_t *patch_offset = &level_patch_offset_[ilevel][sorted[k] * ( ndim+1 )];
+            patch_offset[0] = 0;
+            for( unsigned int d=0; d<ndim; d++ ) {
+                // Patches before this one in the same group, and patches in the same sub-group
+                patch_offset[0] += ( uint64_t )( first[d+1][k] - first[d][k] ) * tail[d];
+                patch_offset[d+1] = ( uint64_t )( last[d+1][k] - first[d+1][k] + 1 ) * tail[d+1];
+                offset[d] = ( hsize_t )coordinates[sorted[k]][d] * shape[d];
+            }
+            H5Sselect_hyperslab( level_filespace_[ilevel], H5S_SELECT_OR, &offset[0], NULL, &count[0], &block[0] );
+        }
+        
+        hsize_t size = ( hsize_t )npatches * tail[0];
+        H5Sset_extent_simple( level_memspace_[ilevel], 1, &size, &size );
+        level_data_[ilevel].resize( size );
+    }
+}
+
+// Block-averages the field of one patch: each block of the first level is the average over
+// factor^ndim cells (trapezoidal rule on primal axes, midpoint rule on dual axes), so that
+// all fields are located at the block centers. The next levels average the blocks of the previous one.
+void DiagnosticFields::downsampleField( Patch *patch, unsigned int ifield )
+{
+    Field *field;
+    if( time_average>1 ) {
+        field = getAveragedField( patch, ifield );
+    } else {
+        field = patch->EMfields->allFields[fields_indexes[ifield]];
+    }
+    unsigned int ndim = n_space_.size();
+    unsigned int h = patch->Hindex() - refHindex;
+    
+    // First level from the field
+    // Missing dimensions are given one block of one point
+    unsigned int factor = downsample_[0];
+    unsigned int nblocks[3] = {1, 1, 1}, npoints[3] = {1, 1, 1}, first[3] = {0, 0, 0};
+    uint64_t field_stride[3] = {0, 0, 0}, out_stride[3] = {0, 0, 0};
+    vector<double> weights[3];
+    uint64_t *patch_offset = &level_patch_offset_[0][h * ( ndim+1 )];
+    uint64_t s = 1;
+    for( int i=ndim-1; i>=0; i-- ) {
+        unsigned int dual = field->isDual( i );
+        nblocks[i] = level_patch_shape_[0][i];
+        npoints[i] = factor + 1 - dual;
+        first[i] = oversize_[i] + dual;
+        field_stride[i] = s;
+        s *= field->dims_[i];
+        out_stride[i] = patch_offset[i+1];
+        weights[i].assign( npoints[i], 1. / factor );
+        if( ! dual ) {
+            weights[i][0] *= 0.5;
+            weights[i][factor] *= 0.5;
+        }
+    }
+    for( unsigned int i=ndim; i<3; i++ ) {
+        weights[i].assign( 1, 1. );
+    }
+    double *in = field->data_;
+    double *out = &level_data_[0][patch_offset[0]];
+    for( unsigned int bx=0; bx<nblocks[0]; bx++ ) {
+        for( unsigned int by=0; by<nblocks[1]; by++ ) {
+            for( unsigned int bz=0; bz<nblocks[2]; bz++ ) {
+                uint64_t start = ( first[0] + bx*factor ) * field_stride[0] + ( first[1] + by*factor ) * field_stride[1] + ( first[2] + bz*factor ) * field_stride[2];
+                double sum = 0.;
+                for( unsigned int ix=0; ix<npoints[0]; ix++ ) {
+                    for( unsigned int iy=0; iy<npoints[1]; iy++ ) {
+                        double wxy = weights[0][ix] * weights[1][iy];
+                        double *row = in + start + ix*field_stride[0] + iy*field_stride[1];
+                        for( unsigned int iz=0; iz<npoints[2]; iz++ ) {
+                            sum += wxy * weights[2][iz] * row[iz*field_stride[2]];
+                        }
+                    }
+                }
+                out[bx*out_stride[0] + by*out_stride[1] + bz*out_stride[2]] = sum * time_average_inv;
+            }
+        }
+    }
+    
+    // Next levels from the previous one
+    for( unsigned int ilevel=1; ilevel<downsample_.size(); ilevel++ ) {
+        unsigned int ratio = downsample_[ilevel] / downsample_[ilevel-1];
+        unsigned int nratio[3] = {1, 1, 1};
+        uint64_t in_stride[3] = {0, 0, 0};
+        uint64_t *previous_offset = &level_patch_offset_[ilevel-1][h * ( ndim+1 )];
+        patch_offset = &level_patch_offset_[ilevel][h * ( ndim+1 )];
+        for( unsigned int i=0; i<ndim; i++ ) {
+            nblocks[i] = level_patch_shape_[ilevel][i];
+            nratio[i] = ratio;
+            in_stride[i] = previous_offset[i+1];
+            out_stride[i] = patch_offset[i+1];
+        }
+        double norm = 1. / pow( ( double )ratio, ( double )ndim );
+        in = &level_data_[ilevel-1][previous_offset[0]];
+        out = &level_data_[ilevel][patch_offset[0]];
+        for( unsigned int bx=0; bx<nblocks[0]; bx++ ) {
+            for( unsigned int by=0; by<nblocks[1]; by++ ) {
+                for( unsigned int bz=0; bz<nblocks[2]; bz++ ) {
+                    double sum = 0.;
+                    for( unsigned int ix=bx*nratio[0]; ix<( bx+1 )*nratio[0]; ix++ ) {
+                        for( unsigned int iy=by*nratio[1]; iy<( by+1 )*nratio[1]; iy++ ) {
+                            for( unsigned int iz=bz*nratio[2]; iz<( bz+1 )*nratio[2]; iz++ ) {
+                                sum += in[ix*in_stride[0] + iy*in_stride[1] + iz*in_stride[2]];
+                            }
+                        }
+                    }
+                    out[bx*out_stride[0] + by*out_stride[1] + bz*out_stride[2]] = sum * norm;
+                }
+            }
+        }
+    }
+}
+
+
+// The accumulators are 1D fields, so that they are exchanged between processes and
+// written in checkpoints like the other fields. In single precision, two floats are stored per double.
+Field *DiagnosticFields::createAverageAccumulator( string name )
+{
+    unsigned int npoints = 1;
+    for( unsigned int i=0; i<avg_shape_.size(); i++ ) {
+        npoints *= avg_shape_[i];
+    }
+    if( avg_single_ ) {
+        npoints = ( npoints+1 ) / 2;
+    }
+    return new Field1D( vector<unsigned int>( 1, npoints ), name );
+}
+
+// Adds a contiguous row of a field to its accumulator
+template<typename T>
+static inline void accumulateRow( T *acc, const double *in, unsigned int start, unsigned int stop, unsigned int step )
+{
+    if( step == 1 ) {
+        #pragma omp simd
+        for( unsigned int i=start; i<stop; i++ ) {
+            acc[i] += in[i];
+        }
+    } else {
+        for( unsigned int i=start; i<stop; i+=step ) {
+            acc[i] += in[i];
+        }
+    }
+}
+
+void DiagnosticFields::incrementAverage( Patch *patch )
+{
+    // Range of the points to accumulate in each direction
+    // The directions of the patch are the last ones, so that the innermost loop is contiguous
+    unsigned int ndim = avg_shape_.size();
+    unsigned int start[3] = {0, 0, 0}, stop[3] = {1, 1, 1}, step[3] = {1, 1, 1};
+    for( unsigned int i=0; i<ndim; i++ ) {
+        unsigned int d = 3-ndim+i;
+        stop[d] = avg_shape_[i];
+        if( avg_subgrid_only_ ) {
+            // Same points as in getField
+            unsigned int istart_in_patch, istart_in_file, nsteps;
+            unsigned int patch_begin = patch->Pcoordinates[i] * n_space_[i];
+            unsigned int patch_end   = patch_begin + n_space_[i] + 1;
+            if( patch->Pcoordinates[i] != 0 ) {
+                patch_begin++;
+            }
+            findSubgridIntersection(
+                subgrid_start_[i], subgrid_stop_[i], subgrid_step_[i],
+                patch_begin, patch_end,
+                istart_in_patch, istart_in_file, nsteps
+            );
+            if( nsteps == 0 ) {
+                return;
+            }
+            start[d] = istart_in_patch + ( patch->Pcoordinates[i] != 0 ? 1 : 0 );
+            step [d] = subgrid_step_[i];
+            stop [d] = start[d] + step[d] * nsteps;
+        }
+    }
+    
+    // Strides of the accumulators
+    unsigned int acc_stride[3] = {0, 0, 0};
+    unsigned int s = 1;
+    for( int i=ndim-1; i>=0; i-- ) {
+        acc_stride[3-ndim+i] = s;
+        s *= avg_shape_[i];
+    }
+    
+    // All fields in the same pass over the rows of the patch (the last direction is contiguous)
+    unsigned int nfields = fields_indexes.size();
+    vector<double *> in( nfields );
+    vector<unsigned int> in_stride( 3*nfields, 0 );
+    for( unsigned int ifield=0; ifield<nfields; ifield++ ) {
+        Field *field = patch->EMfields->allFields[fields_indexes[ifield]];
+        in[ifield] = field->data_;
+        s = 1;
+        for( int i=ndim-1; i>=0; i-- ) {
+            in_stride[3*ifield+3-ndim+i] = s;
+            in[ifield] += oversize_[i] * s;
+            s *= field->dims_[i];
+        }
+    }
+    vector<Field *> &acc = patch->EMfields->allFields_avg[diag_n];
+    for( unsigned int i0=start[0]; i0<stop[0]; i0+=step[0] ) {
+        for( unsigned int i1=start[1]; i1<stop[1]; i1+=step[1] ) {
+            unsigned int acc_row = i0*acc_stride[0] + i1*acc_stride[1];
+            for( unsigned int ifield=0; ifield<nfields; ifield++ ) {
+                double *in_row = in[ifield] + i0*in_stride[3*ifield] + i1*in_stride[3*ifield+1];
+                if( avg_single_ ) {
+                    accumulateRow( reinterpret_cast<float *>( acc[ifield]->data_ ) + acc_row, in_row, start[2], stop[2], step[2] );
+                } else {
+                    accumulateRow( acc[ifield]->data_ + acc_row, in_row, start[2], stop[2], step[2] );
+                }
+            }
+        }
+    }
+}
+
+// Returns a field with the shape of the patch containing the accumulated average
+// (not divided by time_average) on the accumulated points, and resets the accumulator
+Field *DiagnosticFields::getAveragedField( Patch *patch, unsigned int ifield )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    Field *expanded = avg_expanded_[ithread][ifield];
+    Field *acc = patch->EMfields->allFields_avg[diag_n][ifield];
+    float *acc_single = reinterpret_cast<float *>( acc->data_ );
+    
+    unsigned int ndim = avg_shape_.size();
+    unsigned int shape[3] = {1, 1, 1}, stride[3] = {0, 0, 0};
+    unsigned int s = 1;
+    double *out = expanded->data_;
+    for( int i=ndim-1; i>=0; i-- ) {
+        shape [3-ndim+i] = avg_shape_[i];
+        stride[3-ndim+i] = s;
+        out += oversize_[i] * s;
+        s *= expanded->dims_[i];
+    }
+    unsigned int iacc = 0;
+    for( unsigned int i0=0; i0<shape[0]; i0++ ) {
+        for( unsigned int i1=0; i1<shape[1]; i1++ ) {
+            double *row = out + i0*stride[0] + i1*stride[1];
+            for( unsigned int i2=0; i2<shape[2]; i2++ ) {
+                row[i2*stride[2]] = avg_single_ ? ( double )acc_single[iacc] : acc->data_[iacc];
+                iacc++;
+            }
+        }
+    }
+    acc->put_to( 0.0 );
+    return expanded;
+}
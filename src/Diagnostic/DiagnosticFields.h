@@ -38,6 +38,21 @@ public :
                                   unsigned int &istart_in_file,
                                   unsigned int &nsteps );
                                   
+    //! Block-averages the field of one patch in the buffers of all the downsampling levels
+    void downsampleField( Patch *patch, unsigned int ifield );
+    
+    //! Calculates the position of the patches in the downsampled buffers and the file spaces
+    void setDownsampleSplitting( VectorPatch &vecPatches );
+    
+    //! Adds the fields of one patch to their time-average accumulators, all fields in one pass
+    void incrementAverage( Patch *patch );
+    
+    //! Expands the time-average of one field of a patch in a field with the shape of the patch, and resets the accumulator
+    Field *getAveragedField( Patch *patch, unsigned int ifield );
+    
+    //! Creates the time-average accumulator of one field in a patch
+    Field *createAverageAccumulator( std::string name );
+    
     //! Get memory footprint of current diagnostic
     int getMemFootPrint() override
     {
@@ -106,6 +121,40 @@ protected :
     
     //! Save the field type (needed for OpenPMD units dimensionality)
     std::vector<unsigned int> field_type;
+    
+    //! Factors of the block-averaging, one per level of the pyramid (empty if not downsampled)
+    std::vector<unsigned int> downsample_;
+    
+    //! Size of a patch in the grid, and number of ghost cells
+    std::vector<unsigned int> n_space_, oversize_;
+    
+    //! Number of points of one patch in each level and direction
+    std::vector<std::vector<unsigned int> > level_patch_shape_;
+    
+    //! Position of each local patch in the buffer of each level: first point, then one stride per direction
+    std::vector<std::vector<uint64_t> > level_patch_offset_;
+    
+    //! Groups of each level in the file ("data" for the first level), and of the current iteration
+    std::vector<hid_t> level_group_id_, level_iteration_group_id_;
+    
+    //! File spaces, memory spaces, dataset creation lists and buffers of each level
+    std::vector<hid_t> level_filespace_, level_memspace_, level_dcreate_;
+    std::vector<std::vector<double> > level_data_;
+    
+    //! Patches for which the levels were split (first hindex and number of patches)
+    int level_refHindex_, level_npatches_;
+    
+    //! Number of points of the time-average accumulators in each direction (empty in AM geometry, where they are fields)
+    std::vector<unsigned int> avg_shape_;
+    
+    //! Whether the time-average is accumulated in single precision
+    bool avg_single_;
+    
+    //! Whether only the points of the subgrid are accumulated
+    bool avg_subgrid_only_;
+    
+    //! Fields with the shape of a patch where each thread expands the averages before output
+    std::vector<std::vector<Field *> > avg_expanded_;
 };
 
 #endif
@@ -89,7 +89,7 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
     // Get current field
     Field1D *field;
     if( time_average>1 ) {
-        field = static_cast<Field1D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
+        field = static_cast<Field1D *>( getAveragedField( patch, ifield ) );
     } else {
         field = static_cast<Field1D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
     }
@@ -119,10 +119,6 @@ void DiagnosticFields1D::getField( Patch *patch, unsigned int ifield )
         ix += subgrid_step_[0];
         iout++;
     }
-    
-    if( time_average>1 ) {
-        field->put_to( 0.0 );
-    }
 }
 
 
@@ -74,7 +74,10 @@ DiagnosticFields2D::DiagnosticFields2D( Params &params, SmileiMPI *smpi, VectorP
     H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, &offset, NULL, &count, &block );
     // Define space in memory for re-reading
     memspace_reread = H5Screate_simple( 1, &block, NULL );
-    data_reread.resize( block );
+    // The downsampled output does not fold the full grid
+    if( downsample_.size() == 0 ) {
+        data_reread.resize( block );
+    }
     // Define the list of patches for re-writing
     rewrite_npatch = ( unsigned int )npatch_local;
     rewrite_patch.resize( rewrite_npatch );
@@ -137,7 +140,9 @@ DiagnosticFields2D::DiagnosticFields2D( Params &params, SmileiMPI *smpi, VectorP
     }
     // Define space in memory for re-writing
     memspace = H5Screate_simple( 2, block2, NULL );
-    data_rewrite.resize( rewrite_size[0]*rewrite_size[1] );
+    if( downsample_.size() == 0 ) {
+        data_rewrite.resize( rewrite_size[0]*rewrite_size[1] );
+    }
     
     // Define the chunk size (necessary above 2^28 points)
     const hsize_t max_size = 4294967295/2/sizeof( double );
@@ -211,7 +216,7 @@ void DiagnosticFields2D::getField( Patch *patch, unsigned int ifield )
     // Get current field
     Field2D *field;
     if( time_average>1 ) {
-        field = static_cast<Field2D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
+        field = static_cast<Field2D *>( getAveragedField( patch, ifield ) );
     } else {
         field = static_cast<Field2D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
     }
@@ -245,10 +250,6 @@ void DiagnosticFields2D::getField( Patch *patch, unsigned int ifield )
             iout++;
         }
     }
-    
-    if( time_average>1 ) {
-        field->put_to( 0.0 );
-    }
 }
 
 
@@ -76,7 +76,10 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
     H5Sselect_hyperslab( filespace_reread, H5S_SELECT_SET, &offset, NULL, &count, &block );
     // Define space in memory for re-reading
     memspace_reread = H5Screate_simple( 1, &block, NULL );
-    data_reread.resize( block );
+    // The downsampled output does not fold the full grid
+    if( downsample_.size() == 0 ) {
+        data_reread.resize( block );
+    }
     // Define the list of patches for re-writing
     rewrite_npatch = ( unsigned int )npatch_local;
     rewrite_patch.resize( rewrite_npatch );
@@ -151,7 +154,9 @@ DiagnosticFields3D::DiagnosticFields3D( Params &params, SmileiMPI *smpi, VectorP
     }
     // Define space in memory for re-writing
     memspace = H5Screate_simple( 3, block2, NULL );
-    data_rewrite.resize( rewrite_size[0]*rewrite_size[1]*rewrite_size[2] );
+    if( downsample_.size() == 0 ) {
+        data_rewrite.resize( rewrite_size[0]*rewrite_size[1]*rewrite_size[2] );
+    }
     
     // Define the chunk size (necessary above 2^28 points)
     const hsize_t max_size = 4294967295/2/sizeof( double );
@@ -227,7 +232,7 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
     // Get current field
     Field3D *field;
     if( time_average>1 ) {
-        field = static_cast<Field3D *>( patch->EMfields->allFields_avg[diag_n][ifield] );
+        field = static_cast<Field3D *>( getAveragedField( patch, ifield ) );
     } else {
         field = static_cast<Field3D *>( patch->EMfields->allFields[fields_indexes[ifield]] );
     }
@@ -264,10 +269,6 @@ void DiagnosticFields3D::getField( Patch *patch, unsigned int ifield )
             }
         }
     }
-    
-    if( time_average>1 ) {
-        field->put_to( 0.0 );
-    }
 }
 
 
@@ -221,47 +221,39 @@ bool DiagnosticParticleBinningBase::prepare( int timestep )
 
 
 // run one particle binning diagnostic
+// (the particle binning engine calls binParticles directly for all the diagnostics due at the same time)
 void DiagnosticParticleBinningBase::run( Patch *patch, int timestep, SimWindow *simWindow )
 {
-
-    vector<int> int_buffer;
-    vector<double> double_buffer;
-    unsigned int npart;
-    
-//    // Update spatial_min and spatial_max if needed
-//    if( simWindow ) {
-//        bool did_move = false;
-//        for( unsigned int i=0; i<histogram->axes.size(); i++ ) {
-//            if( histogram->axes[i]->type == "moving_x" ) {
-//                spatial_min[0] = histogram->axes[i]->min + simWindow->getXmoved();
-//                spatial_max[0] = histogram->axes[i]->max + simWindow->getXmoved();
-//                did_move = true;
-//            }
-//        }
-//        if( ! did_move ) {
-//            spatial_max[0] += simWindow->getXmoved() - spatial_min[0];
-//            spatial_min[0] = simWindow->getXmoved();
-//        }
-//    }
+    if( ! usesPatch( patch ) ) {
+        return;
+    }
+    
+    HistogramBuffers buffers;
     
     // loop species
     for( unsigned int ispec=0 ; ispec < species.size() ; ispec++ ) {
-    
         Species *s = patch->vecSpecies[species[ispec]];
-        npart = s->particles->size();
-        int_buffer   .resize( npart );
-        double_buffer.resize( npart );
-        
-        fill( int_buffer.begin(), int_buffer.end(), 0 );
-        
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
-        histogram->valuate( s, double_buffer, int_buffer );
-        histogram->distribute( double_buffer, int_buffer, data_sum );
-        
+        unsigned int npart = s->particles->size();
+        buffers.resize( npart );
+        binParticles( s, 0, npart, buffers, simWindow );
     }
     
+    endPatch();
+    
 } // END run
 
+
+// bin a set of particles of one species
+void DiagnosticParticleBinningBase::binParticles( Species *s, unsigned int istart, unsigned int npart, HistogramBuffers &buffers, SimWindow *simWindow )
+{
+    fill( buffers.int_buffer.begin(), buffers.int_buffer.begin()+npart, 0 );
+    
+    histogram->digitize( s, buffers.double_buffer, buffers.int_buffer, istart, npart, simWindow );
+    histogram->valuate( s, buffers.double_buffer, buffers.int_buffer, istart, npart );
+    histogram->distribute( buffers.double_buffer, buffers.int_buffer, npart, data_sum );
+    
+} // END binParticles
+
 bool DiagnosticParticleBinningBase::writeNow( int timestep ) {
     return timestep - timeSelection->previousTime() == time_average-1;
 }
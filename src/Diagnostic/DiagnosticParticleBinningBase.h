@@ -31,7 +31,31 @@ public :
     
     bool prepare( int timestep ) override;
     
-    virtual void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    
+    //! False if the particles of this patch cannot contribute to the diagnostic
+    virtual bool usesPatch( Patch *patch )
+    {
+        return true;
+    }
+    
+    //! Bins the particles istart to istart+npart-1 of the species s in data_sum
+    virtual void binParticles( Species *s, unsigned int istart, unsigned int npart, HistogramBuffers &buffers, SimWindow *simWindow );
+    
+    //! Called once all the particles of a patch have been binned
+    virtual void endPatch() {};
+    
+    //! True if the particles of a species must be binned in a single call (python functions)
+    inline bool binsWholeSpecies()
+    {
+        return histogram->calls_python;
+    }
+    
+    //! True if the species number ispec is binned by this diagnostic
+    inline bool hasSpecies( unsigned int ispec )
+    {
+        return std::find( species.begin(), species.end(), ispec ) != species.end();
+    }
     
     virtual bool writeNow( int timestep );
     
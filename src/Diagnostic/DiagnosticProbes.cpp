@@ -77,6 +77,79 @@ vector<double> matrixTimesVector( vector<double> A, vector<double> v )
 }
 
 
+// Interpolation of one field at the points [istart, iend) of a patch, using the cached stencil
+// The sums are done in the same order as in the interpolators, so that results are identical
+template<int N>
+void interpolateStencil1D( Field *field, ProbeParticles *probe, unsigned int istart, unsigned int iend, double *out )
+{
+    unsigned int npart = probe->particles.size();
+    unsigned int dx = field->isDual( 0 );
+    const double *f  = field->data_;
+    const int    *ix = &probe->stencil_index [0][dx][0];
+    const double *cx = &probe->stencil_weight[0][dx][0];
+    #pragma omp simd
+    for( unsigned int ipart=istart; ipart<iend; ipart++ ) {
+        double res = 0.;
+        for( int iloc=0; iloc<N; iloc++ ) {
+            res += cx[iloc*npart+ipart] * f[ix[ipart]+iloc];
+        }
+        out[ipart] = res;
+    }
+}
+
+template<int N>
+void interpolateStencil2D( Field *field, ProbeParticles *probe, unsigned int istart, unsigned int iend, double *out )
+{
+    unsigned int npart = probe->particles.size();
+    unsigned int dx = field->isDual( 0 ), dy = field->isDual( 1 );
+    int ny = field->dims_[1];
+    const double *f  = field->data_;
+    const int    *ix = &probe->stencil_index [0][dx][0];
+    const int    *iy = &probe->stencil_index [1][dy][0];
+    const double *cx = &probe->stencil_weight[0][dx][0];
+    const double *cy = &probe->stencil_weight[1][dy][0];
+    #pragma omp simd
+    for( unsigned int ipart=istart; ipart<iend; ipart++ ) {
+        double res = 0.;
+        for( int iloc=0; iloc<N; iloc++ ) {
+            const double *fi = f + ( ix[ipart]+iloc )*ny + iy[ipart];
+            for( int jloc=0; jloc<N; jloc++ ) {
+                res += cx[iloc*npart+ipart] * cy[jloc*npart+ipart] * fi[jloc];
+            }
+        }
+        out[ipart] = res;
+    }
+}
+
+template<int N>
+void interpolateStencil3D( Field *field, ProbeParticles *probe, unsigned int istart, unsigned int iend, double *out )
+{
+    unsigned int npart = probe->particles.size();
+    unsigned int dx = field->isDual( 0 ), dy = field->isDual( 1 ), dz = field->isDual( 2 );
+    int ny = field->dims_[1], nz = field->dims_[2];
+    const double *f  = field->data_;
+    const int    *ix = &probe->stencil_index [0][dx][0];
+    const int    *iy = &probe->stencil_index [1][dy][0];
+    const int    *iz = &probe->stencil_index [2][dz][0];
+    const double *cx = &probe->stencil_weight[0][dx][0];
+    const double *cy = &probe->stencil_weight[1][dy][0];
+    const double *cz = &probe->stencil_weight[2][dz][0];
+    #pragma omp simd
+    for( unsigned int ipart=istart; ipart<iend; ipart++ ) {
+        double res = 0.;
+        for( int iloc=0; iloc<N; iloc++ ) {
+            for( int jloc=0; jloc<N; jloc++ ) {
+                const double *fij = f + ( ( ix[ipart]+iloc )*ny + iy[ipart]+jloc )*nz + iz[ipart];
+                for( int kloc=0; kloc<N; kloc++ ) {
+                    res += cx[iloc*npart+ipart] * cy[jloc*npart+ipart] * cz[kloc*npart+ipart] * fij[kloc];
+                }
+            }
+        }
+        out[ipart] = res;
+    }
+}
+
+
 
 
 DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches, int n_probe )
@@ -324,6 +397,23 @@ DiagnosticProbes::DiagnosticProbes( Params &params, SmileiMPI *smpi, VectorPatch
         patch_size[k] = params.n_space[k]*params.cell_length[k];
     }
 
+    // In cartesian geometries, the interpolation stencils of the points are cached in each patch
+    stencil_kernel_ = NULL;
+    interpolation_order_ = params.interpolation_order;
+    if( geometry != "AMcylindrical" && ( interpolation_order_ == 2 || interpolation_order_ == 4 ) ) {
+        inv_cell_length_.resize( nDim_field );
+        for( unsigned int k=0; k<nDim_field; k++ ) {
+            inv_cell_length_[k] = 1.0/params.cell_length[k];
+        }
+        if( nDim_field == 1 ) {
+            stencil_kernel_ = interpolation_order_ == 2 ? interpolateStencil1D<3> : interpolateStencil1D<5>;
+        } else if( nDim_field == 2 ) {
+            stencil_kernel_ = interpolation_order_ == 2 ? interpolateStencil2D<3> : interpolateStencil2D<5>;
+        } else if( nDim_field == 3 ) {
+            stencil_kernel_ = interpolation_order_ == 2 ? interpolateStencil3D<3> : interpolateStencil3D<5>;
+        }
+    }
+
     // Create filename
     ostringstream mystream( "" );
     mystream << "Probes" << n_probe << ".h5";
@@ -592,6 +682,7 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
     for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
         offset_in_file[ipatch] = global_offset - nPart_MPI + offset_in_MPI[ipatch];
         vecPatches( ipatch )->probes[probe_n]->offset_in_file = offset_in_file[ipatch];
+        vecPatches( ipatch )->probes[probe_n]->stencil_ready = false;
     }
 
     if( nPart_total_actual==0 ) {
@@ -601,6 +692,103 @@ void DiagnosticProbes::createPoints( SmileiMPI *smpi, VectorPatch &vecPatches, b
 
 
 
+void DiagnosticProbes::computeStencil( Patch *patch, ProbeParticles *probe )
+{
+    unsigned int npart = probe->particles.size();
+    unsigned int nnodes = interpolation_order_+1;
+    int half = interpolation_order_/2;
+    const double dble_1_ov_384 = 1.0/384.0, dble_1_ov_48 = 1.0/48.0, dble_1_ov_16 = 1.0/16.0, dble_1_ov_12 = 1.0/12.0;
+    const double dble_1_ov_24 = 1.0/24.0, dble_19_ov_96 = 19.0/96.0, dble_11_ov_24 = 11.0/24.0, dble_1_ov_4 = 1.0/4.0;
+    const double dble_1_ov_6 = 1.0/6.0, dble_115_ov_192 = 115.0/192.0, dble_5_ov_8 = 5.0/8.0;
+    for( unsigned int idim=0; idim<nDim_field; idim++ ) {
+        int domain_begin = patch->getCellStartingGlobalIndex( idim );
+        for( unsigned int dual=0; dual<2; dual++ ) {
+            vector<int> &index = probe->stencil_index[idim][dual];
+            vector<double> &c = probe->stencil_weight[idim][dual];
+            index.resize( npart );
+            c.resize( nnodes*npart );
+            double shift = 0.5*dual;
+            for( unsigned int ipart=0; ipart<npart; ipart++ ) {
+                // Central node and normalized distance to it, as in the interpolators
+                double xpn = probe->particles.position( idim, ipart )*inv_cell_length_[idim];
+                int icentral = round( xpn+shift );
+                double delta = xpn - ( double )icentral + shift;
+                double delta2 = delta*delta;
+                if( interpolation_order_ == 2 ) {
+                    c[0*npart+ipart] = 0.5 * ( delta2-delta+0.25 );
+                    c[1*npart+ipart] = ( 0.75-delta2 );
+                    c[2*npart+ipart] = 0.5 * ( delta2+delta+0.25 );
+                } else {
+                    double delta3 = delta2*delta;
+                    double delta4 = delta3*delta;
+                    c[0*npart+ipart] = dble_1_ov_384   - dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 - dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                    c[1*npart+ipart] = dble_19_ov_96   - dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  + dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                    c[2*npart+ipart] = dble_115_ov_192 - dble_5_ov_8   * delta2 + dble_1_ov_4 * delta4;
+                    c[3*npart+ipart] = dble_19_ov_96   + dble_11_ov_24 * delta  + dble_1_ov_4 * delta2  - dble_1_ov_6  * delta3 - dble_1_ov_6  * delta4;
+                    c[4*npart+ipart] = dble_1_ov_384   + dble_1_ov_48  * delta  + dble_1_ov_16 * delta2 + dble_1_ov_12 * delta3 + dble_1_ov_24 * delta4;
+                }
+                // First node of the stencil, relative to the patch
+                index[ipart] = icentral - domain_begin - half;
+            }
+        }
+    }
+    probe->stencil_ready = true;
+}
+
+
+void DiagnosticProbes::interpolateStencil( Patch *patch, unsigned int ipatch )
+{
+    ProbeParticles *probe = patch->probes[probe_n];
+    unsigned int npart = probe->particles.size();
+    if( npart == 0 ) {
+        return;
+    }
+    if( ! probe->stencil_ready ) {
+        computeStencil( patch, probe );
+    }
+    
+    // List the requested fields, and their location in the output
+    ElectroMagn *EM = patch->EMfields;
+    vector<Field *> fields;
+    vector<unsigned int> locations;
+    Field *usual_fields[10] = { EM->Ex_, EM->Ey_, EM->Ez_, EM->Bx_m, EM->By_m, EM->Bz_m, EM->Jx_, EM->Jy_, EM->Jz_, EM->rho_ };
+    for( unsigned int i=0; i<10; i++ ) {
+        if( fieldlocation[i] < ( unsigned int ) nFields ) {
+            fields.push_back( usual_fields[i] );
+            locations.push_back( fieldlocation[i] );
+        }
+    }
+    for( unsigned int ispec=0; ispec<species_field_index.size(); ispec++ ) {
+        unsigned int start = EM->species_starts[ispec];
+        for( unsigned int j=0; j<species_field_index[ispec].size(); j++ ) {
+            fields.push_back( EM->allFields[start+species_field_index[ispec][j]] );
+            locations.push_back( species_field_location[ispec][j] );
+        }
+    }
+    if( EM->envelope != NULL ) {
+        Field *envelope_fields[3] = { EM->Env_A_abs_, EM->Env_Chi_, EM->Env_E_abs_ };
+        for( unsigned int i=0; i<3; i++ ) {
+            if( fieldlocation[10+i] < ( unsigned int ) nFields ) {
+                fields.push_back( envelope_fields[i] );
+                locations.push_back( fieldlocation[10+i] );
+            }
+        }
+    }
+    
+    // All fields are interpolated in one sweep over blocks of points, so that the stencil stays in cache
+    vector<double *> out( fields.size() );
+    for( unsigned int ifield=0; ifield<fields.size(); ifield++ ) {
+        out[ifield] = &( ( *probesArray )( locations[ifield], offset_in_MPI[ipatch] ) );
+    }
+    for( unsigned int istart=0; istart<npart; istart+=stencil_block_size_ ) {
+        unsigned int iend = min( istart+stencil_block_size_, npart );
+        for( unsigned int ifield=0; ifield<fields.size(); ifield++ ) {
+            stencil_kernel_( fields[ifield], probe, istart, iend, out[ifield] );
+        }
+    }
+}
+
+
 void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timestep, SimWindow *simWindow, Timers &timers )
 {
     ostringstream name_t;
@@ -707,6 +895,12 @@ void DiagnosticProbes::run( SmileiMPI *smpi, VectorPatch &vecPatches, int timest
         unsigned int iPart_MPI = offset_in_MPI[ipatch];
         Patch * patch = vecPatches( ipatch );
         unsigned int npart = patch->probes[probe_n]->particles.size();
+        
+        // Cartesian geometries: vectorized interpolation with the cached stencil
+        if( stencil_kernel_ ) {
+            interpolateStencil( patch, ipatch );
+            continue;
+        }
 
         LocalFields Jloc_fields;
         double Rloc_fields;
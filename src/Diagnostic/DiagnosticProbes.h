@@ -5,6 +5,7 @@
 
 #include "Field2D.h"
 
+class ProbeParticles;
 
 class DiagnosticProbes : public Diagnostic
 {
@@ -40,6 +41,8 @@ public :
                    ( nDim_particle+3+1 )*sizeof( double ) + sizeof( short )
                    // eval probesArray (even if temporary)
                    + 10*sizeof( double )
+                   // cached interpolation stencil
+                   + ( stencil_kernel_ ? 2*nDim_field*( ( interpolation_order_+1 )*sizeof( double ) + sizeof( int ) ) : 0 )
                );
     }
     
@@ -123,6 +126,24 @@ private :
     
     //! patch size
     std::vector<double> patch_size;
+    
+    //! Computes the interpolation stencil of the points of one patch
+    void computeStencil( Patch *patch, ProbeParticles *probe );
+    
+    //! Interpolates all requested fields at the points of one patch, using the cached stencil
+    void interpolateStencil( Patch *patch, unsigned int ipatch );
+    
+    //! Kernel interpolating one field at a range of points with the cached stencil (NULL if not available)
+    void ( *stencil_kernel_ )( Field *, ProbeParticles *, unsigned int, unsigned int, double * );
+    
+    //! Interpolation order
+    unsigned int interpolation_order_;
+    
+    //! Inverse of the cell length in each dimension
+    std::vector<double> inv_cell_length_;
+    
+    //! Number of points interpolated together for all fields
+    static const unsigned int stencil_block_size_ = 256;
 };
 
 
@@ -130,8 +151,8 @@ private :
 class ProbeParticles
 {
 public :
-    ProbeParticles() {};
-    ProbeParticles( ProbeParticles *probe )
+    ProbeParticles() : stencil_ready( false ) {};
+    ProbeParticles( ProbeParticles *probe ) : stencil_ready( false )
     {
         offset_in_file=probe->offset_in_file;
     }
@@ -139,6 +160,14 @@ public :
     
     Particles particles;
     int offset_in_file;
+    
+    //! Interpolation stencil of the points, for each dimension and each staggering (0: primal, 1: dual)
+    //! Index of the first node, relative to the patch
+    std::vector<int> stencil_index[3][2];
+    //! Weights of the nodes, stored as [inode*npoints + ipoint]
+    std::vector<double> stencil_weight[3][2];
+    //! False when the points have changed since the stencil was calculated
+    bool stencil_ready;
 };
 
 
@@ -31,6 +31,10 @@ DiagnosticRadiationSpectrum::DiagnosticRadiationSpectrum(
     
     // minimum chi beyond which the radiation spectrum is computed (uses minimum_chi_continuous)
     minimum_chi_continuous_ = radiation_tables_->getMinimumChiContinuous();
+    this->radiation_tables_ = radiation_tables_;
+    
+    // Whether the spectrum is interpolated in the table of RadiationTables
+    PyTools::extract( "tabulated_spectrum", tabulated_spectrum_, "DiagRadiationSpectrum", diagId );
     
     // Normalization parameters
     two_third = 2./3.;
@@ -57,6 +61,7 @@ DiagnosticRadiationSpectrum::DiagnosticRadiationSpectrum(
     // construct the list of photon_energies
     photon_energies.resize( photon_axis->nbins );
     delta_energies.resize( photon_axis->nbins );
+    log10_photon_energies.resize( photon_axis->nbins );
     double emin = photon_axis->actual_min;
     double emax = photon_axis->actual_max;
     double spacing = (emax-emin) / photon_axis->nbins;
@@ -69,6 +74,7 @@ DiagnosticRadiationSpectrum::DiagnosticRadiationSpectrum(
             delta_energies[i] = spacing;
         }
         delta_energies[i] *= factor;
+        log10_photon_energies[i] = log10( photon_energies[i] );
     }
     
     // Calculate the size of the output array
@@ -78,6 +84,15 @@ DiagnosticRadiationSpectrum::DiagnosticRadiationSpectrum(
     }
     output_size = ( unsigned int ) total_size;
     
+    // One histogram per thread
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    thread_data_.resize( nthreads );
+    thread_rows_.resize( nthreads );
+    thread_row_flags_.resize( nthreads );
+    
     // Output info on diagnostics
     if( smpi->isMaster() ) {
         MESSAGE( 2, photon_axis->info( "photon energy" ) );
@@ -114,92 +129,121 @@ void DiagnosticRadiationSpectrum::openFile( Params& params, SmileiMPI* smpi, boo
     }
 }
 
-// run one particle binning diagnostic
-void DiagnosticRadiationSpectrum::run( Patch* patch, int timestep, SimWindow* simWindow )
+// bin the spectrum radiated by the particles istart to istart+npart-1
+void DiagnosticRadiationSpectrum::binParticles( Species *s, unsigned int istart, unsigned int npart, HistogramBuffers &buffers, SimWindow *simWindow )
 {
-
-    vector<int> int_buffer;
-    vector<double> double_buffer;
-    
-//    // Update spatial_min and spatial_max if needed
-//    if( simWindow ) {
-//        bool did_move = false;
-//        for( unsigned int i=0; i<histogram->axes.size(); i++ ) {
-//            if( histogram->axes[i]->type == "moving_x" ) {
-//                spatial_min[0] = histogram->axes[i]->min + simWindow->getXmoved();
-//                spatial_max[0] = histogram->axes[i]->max + simWindow->getXmoved();
-//                did_move = true;
-//            }
-//        }
-//        if( ! did_move ) {
-//            spatial_max[0] += simWindow->getXmoved() - spatial_min[0];
-//            spatial_min[0] = simWindow->getXmoved();
-//        }
-//    }
-    
-    // loop species
-    for( unsigned int ispec=0 ; ispec < species.size() ; ispec++ ) {
+    vector<int> &int_buffer = buffers.int_buffer;
+    
+    // Thread histogram (zero outside of binParticles and endPatch)
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    thread_data_[ithread].resize( output_size, 0. );
+    thread_row_flags_[ithread].resize( output_size / photon_axis->nbins, 0 );
+    double *data = &thread_data_[ithread][0];
+    char *rows_modified = &thread_row_flags_[ithread][0];
+    
+    fill( int_buffer.begin(), int_buffer.begin()+npart, 0 );
+    
+    histogram->digitize( s, buffers.double_buffer, int_buffer, istart, npart, simWindow );
+    
+    // Sum the data into the thread histogram
+    // ---------------------------------------
+    unsigned int nbins = photon_axis->nbins;
+    const double *log10_energies = &log10_photon_energies[0];
+    const double *energies = &photon_energies[0];
+    const double *deltas = &delta_energies[0];
+    
+    for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
+        int ind = int_buffer[ipart];
+        if( ind<0 ) continue; // skip already discarded particles
+        ind *= nbins;
         
-        Species *s = patch->vecSpecies[species[ispec]];
-        unsigned int npart = s->particles->size();
-        int_buffer   .resize( npart );
-        double_buffer.resize( npart );
+        // Get the quantum parameter
+        double chi = s->particles->chi( istart+ipart );
         
-        fill(int_buffer.begin(), int_buffer.end(), 0);
+        // Update the spectrum only if the quantum parameter is sufficiently high
+        if( chi <= minimum_chi_continuous_ ) continue;
         
-        histogram->digitize( s, double_buffer, int_buffer, simWindow );
+        // Emitting particle energy (maximum of the spectrum)
+        double gamma = s->particles->LorentzFactor( istart+ipart );
+        double gamma_inv = 1./gamma;
+        double increment0 = gamma_inv * s->particles->weight( istart+ipart );
+        double log10_gamma_chi = log10( gamma*chi );
+        double weight_chi = 0.;
+        const double *rows = tabulated_spectrum_ ? radiation_tables_->getSynchrotronSpectrumRows( chi, weight_chi ) : NULL;
         
-        // Sum the data into the data_sum
-        // ------------------------------
-        int ind;
+        // Compute the maximum iteration of the loop on bins
+        // ensures that xi<1;
+        // that is no radiation corresponds to photon energy larger than the radiating particle energy
+        if( photon_axis->logscale ) {
+            gamma = log10( gamma );
+        }
+        int iphoton_energy_max = int( (gamma - photon_axis->actual_min) * photon_axis->coeff );
+        //iphoton_energy_max can not be greater than photon_energy_nbins
+        iphoton_energy_max = min( iphoton_energy_max, photon_axis->nbins );
+        if( iphoton_energy_max <= 0 ) continue;
         
-        double gamma_inv, gamma, chi, xi, zeta, nu, cst;
-        double two_third_ov_chi, increment0, increment;
-        int iphoton_energy_max;
+        // Mark the row as modified
+        if( rows_modified[ind/nbins] == 0 ) {
+            rows_modified[ind/nbins] = 1;
+            thread_rows_[ithread].push_back( ind );
+        }
         
-        for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
-            ind = int_buffer[ipart];
-            if( ind<0 ) continue; // skip already discarded particles
-            ind *= photon_axis->nbins;
-            
-            // Get the quantum parameter
-            chi = s->particles->chi( ipart );
-            
-            // Update the spectrum only if the quantum parameter is sufficiently high
-            if( chi <= minimum_chi_continuous_ ) continue;
-            
-            // Emitting particle energy (maximum of the spectrum)
-            gamma = s->particles->LorentzFactor( ipart );
-            gamma_inv = 1./gamma;
-            two_third_ov_chi = two_third/chi;
-            increment0 = gamma_inv * s->particles->weight( ipart );
-            
-            // Compute the maximum iteration of the loop on bins
-            // ensures that xi<1;
-            // that is no radiation corresponds to photon energy larger than the radiating particle energy
-            if( photon_axis->logscale ) {
-                gamma = log10( gamma );
+        // Loop on bins: xi = photon energy / gamma, log10( zeta/chi ) = log10( xi/(1-xi)/chi )
+        double *spectrum = &data[ind];
+        if( rows ) {
+            #pragma omp simd
+            for( int i=0; i<iphoton_energy_max; i++ ) {
+                double xi = energies[i] * gamma_inv;
+                double log10_zeta_ov_chi = log10_energies[i] - log10_gamma_chi - log10( 1.-xi ); // xi<1 is ensured above
+                spectrum[i] += increment0 * deltas[i] * radiation_tables_->getSynchrotronSpectrum( rows, weight_chi, log10_zeta_ov_chi );
             }
-            iphoton_energy_max = int( (gamma - photon_axis->actual_min) * photon_axis->coeff );
-            //iphoton_energy_max can not be greater than photon_energy_nbins
-            iphoton_energy_max = min( iphoton_energy_max, photon_axis->nbins );
-            
-            // Loop on bins
+        } else {
+            // Exact formula (quantum parameter above the table, or no table)
+            double two_third_ov_chi = two_third/chi;
             for( int i=0; i<iphoton_energy_max; i++ ) {
-                xi   = photon_energies[i] * gamma_inv;
-                zeta = xi / (1.-xi); // xi<1 is ensured above
-                nu   = two_third_ov_chi * zeta;
-                cst  = xi * zeta;
-                increment = increment0 * delta_energies[i] * xi * RadiationTools::computeBesselPartsRadiatedPower(nu,cst);
-                #pragma omp atomic
-                data_sum[ind+i] += increment;
+                double xi   = energies[i] * gamma_inv;
+                double zeta = xi / (1.-xi);
+                double nu   = two_third_ov_chi * zeta;
+                double cst  = xi * zeta;
+                spectrum[i] += increment0 * deltas[i] * xi * RadiationTools::computeBesselPartsRadiatedPower( nu, cst );
             }
-            
         }
+        
+    }
+    
+} // END binParticles
+
+
+// Add the modified rows of the thread histogram to data_sum
+void DiagnosticRadiationSpectrum::endPatch()
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    if( thread_rows_[ithread].empty() ) {
+        return;
+    }
+    double *data = &thread_data_[ithread][0];
+    char *rows_modified = &thread_row_flags_[ithread][0];
     
+    for( unsigned int irow=0; irow<thread_rows_[ithread].size(); irow++ ) {
+        unsigned int ind = thread_rows_[ithread][irow];
+        rows_modified[ind/photon_axis->nbins] = 0;
+        for( int i=0; i<photon_axis->nbins; i++ ) {
+            if( data[ind+i] != 0. ) {
+                #pragma omp atomic
+                data_sum[ind+i] += data[ind+i];
+                data[ind+i] = 0.;
+            }
+        }
     }
+    thread_rows_[ithread].resize( 0 );
     
-} // END run
+} // END endPatch
 
 
 
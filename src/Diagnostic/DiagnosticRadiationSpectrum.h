@@ -16,7 +16,10 @@ public :
     
     void openFile( Params &params, SmileiMPI *smpi, bool newfile ) override;
     
-    void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    void binParticles( Species *s, unsigned int istart, unsigned int npart, HistogramBuffers &buffers, SimWindow *simWindow ) override;
+    
+    //! Adds the thread histogram to data_sum
+    void endPatch() override;
     
     static std::vector<std::string> excludedAxes() {
         std::vector<std::string> excluded_axes( 0 );
@@ -43,6 +46,24 @@ private :
     
     //! axis containing the values of the delta on the binned photon_energies
     std::vector<double> delta_energies;
+    
+    //! log10 of the binned photon_energies
+    std::vector<double> log10_photon_energies;
+    
+    //! Tables containing the synchrotron spectrum
+    RadiationTables *radiation_tables_;
+    
+    //! Whether the spectrum is interpolated in the table instead of the exact formula
+    bool tabulated_spectrum_;
+    
+    //! Thread-private histograms, added to data_sum at the end of each patch
+    std::vector<std::vector<double> > thread_data_;
+    
+    //! Offsets in thread_data_ of the rows modified in the current patch
+    std::vector<std::vector<unsigned int> > thread_rows_;
+    
+    //! Flags of the rows of thread_data_ modified in the current patch
+    std::vector<std::vector<char> > thread_row_flags_;
 
 };
 
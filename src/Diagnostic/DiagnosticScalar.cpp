@@ -7,6 +7,10 @@
 #include <algorithm>
 #include <limits>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 
 
@@ -224,6 +228,7 @@ void DiagnosticScalar::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPa
     necessary_poy.resize( npoy );
     string poy_name;
     unsigned int k = 0;
+    necessary_poy_any = false;
     for( unsigned int j=0; j<2; j++ ) {
         for( unsigned int i=0; i<EMfields->poynting[j].size(); i++ ) {
             //if     (i==0) poy_name = (j==0?"PoyXmin":"PoyXmax");
@@ -231,9 +236,16 @@ void DiagnosticScalar::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPa
             //else if(i==2) poy_name = (j==0?"PoyZmin":"PoyZmax");
             poy_name = Tools::merge( "Poy", Tools::xyz[i], j==0?"min":"max" );
             necessary_poy[k] = necessary_Uelm_BC || allowedKey( poy_name ) || allowedKey( poy_name+"Inst" );
+            if( necessary_poy[k] ) {
+                necessary_poy_any = true;
+            }
             k++;
         }
     }
+    // Without DiagScalar, nobody reads the Poynting flux
+    if( timeSelection->isEmpty() ) {
+        necessary_poy_any = false;
+    }
     
     // 2 - Prepare the Scalar* objects that will contain the data
     // ----------------------------------------------------------
@@ -315,6 +327,17 @@ void DiagnosticScalar::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPa
             k++;
         }
     }
+    
+    // 3 - Prepare the contributions of each thread
+    // --------------------------------------------
+    
+    unsigned int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    thread_SUM   .resize( nthreads, values_SUM    );
+    thread_MINLOC.resize( nthreads, values_MINLOC );
+    thread_MAXLOC.resize( nthreads, values_MAXLOC );
 }
 
 
@@ -326,6 +349,11 @@ bool DiagnosticScalar::prepare( int timestep )
         for( unsigned int iscalar=0 ; iscalar<allScalars.size() ; iscalar++ ) {
             allScalars[iscalar]->reset();
         }
+        for( unsigned int ithread=0 ; ithread<thread_SUM.size() ; ithread++ ) {
+            thread_SUM   [ithread] = values_SUM;
+            thread_MINLOC[ithread] = values_MINLOC;
+            thread_MAXLOC[ithread] = values_MAXLOC;
+        }
     }
     
     // Scalars always run even if they don't dump
@@ -336,8 +364,10 @@ bool DiagnosticScalar::prepare( int timestep )
 void DiagnosticScalar::run( Patch *patch, int timestep, SimWindow *simWindow )
 {
 
-    // Must keep track of Poynting flux even without diag
-    patch->EMfields->computePoynting();
+    // Must keep track of Poynting flux even without diag, when a scalar needs it
+    if( necessary_poy_any ) {
+        patch->EMfields->computePoynting();
+    }
     
     // Compute all scalars when needed
     if( timeSelection->theTimeIsNow( timestep ) && timestep>latest_timestep ) {
@@ -410,6 +440,15 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
     ElectroMagn *EMfields = patch->EMfields;
     std::vector<Species *> &vecSpecies = patch->vecSpecies;
     
+    // Contributions of the current thread
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    vector<double> &sum = thread_SUM[ithread];
+    vector<val_index> &minlocs = thread_MINLOC[ithread];
+    vector<val_index> &maxlocs = thread_MAXLOC[ithread];
+    
     // ------------------------
     // SPECIES-related energies
     // ------------------------
@@ -453,17 +492,17 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
                 }
             }
             
-            *sNtot[ispec] += ( double )nPart;
-            *sDens[ispec] += density;
-            *sZavg[ispec] += charge;
-            *sUkin[ispec] += ener_tot;
+            sum[sNtot[ispec]->index] += ( double )nPart;
+            sum[sDens[ispec]->index] += density;
+            sum[sZavg[ispec]->index] += charge;
+            sum[sUkin[ispec]->index] += ener_tot;
             
             // incremement the total kinetic energy
             Ukin_ += ener_tot;
             
             // If radiation activated
             if( vecSpecies[ispec]->Radiate ) {
-                *sUrad[ispec] += vecSpecies[ispec]->getNrjRadiation();
+                sum[sUrad[ispec]->index] += vecSpecies[ispec]->getNrjRadiation();
                 Urad_         += vecSpecies[ispec]->getNrjRadiation();
             }
             
@@ -488,18 +527,18 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
     
     // Add the calculated energies to the data arrays
     if( necessary_Ukin ) {
-        *Ukin += Ukin_;
+        sum[Ukin->index] += Ukin_;
     }
     if( necessary_Urad ) {
-        *Urad += Urad_;
+        sum[Urad->index] += Urad_;
     }
     if( necessary_UmBWpairs ) {
-        *UmBWpairs += UmBWpairs_;
+        sum[UmBWpairs->index] += UmBWpairs_;
     }
     if( necessary_Ukin_BC ) {
-        *Ukin_bnd     += Ukin_bnd_     ;
-        *Ukin_out_mvw += Ukin_out_mvw_ ;
-        *Ukin_inj_mvw += Ukin_inj_mvw_ ;
+        sum[Ukin_bnd    ->index] += Ukin_bnd_     ;
+        sum[Ukin_out_mvw->index] += Ukin_out_mvw_ ;
+        sum[Ukin_inj_mvw->index] += Ukin_inj_mvw_ ;
     }
     
     // --------------------------------
@@ -560,14 +599,14 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
             // Utot = Dx^N/2 * Field^2
             Utot_crtField *= 0.5*cell_volume;
             
-            *fieldUelm[ifield] += Utot_crtField;
+            sum[fieldUelm[ifield]->index] += Utot_crtField;
             Uelm_+=Utot_crtField;
         }
     }
     
     // Total elm energy
     if( necessary_Uelm ) {
-        *Uelm += Uelm_;
+        sum[Uelm->index] += Uelm_;
     }
     
     // Lost/added elm energies through the moving window
@@ -580,8 +619,8 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
         double Uelm_inj_mvw_=EMfields->getNewFieldsNRJ();
         Uelm_inj_mvw_ *= 0.5*cell_volume;
         
-        *Uelm_out_mvw += Uelm_out_mvw_;
-        *Uelm_inj_mvw += Uelm_inj_mvw_ ;
+        sum[Uelm_out_mvw->index] += Uelm_out_mvw_;
+        sum[Uelm_inj_mvw->index] += Uelm_inj_mvw_ ;
     }
     
     EMfields->reinitDiags();
@@ -604,9 +643,6 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
         fields.push_back( EMfields->Env_E_abs_ );
     }
     
-    double fieldval;
-    unsigned int i_min, j_min, k_min;
-    unsigned int i_max, j_max, k_max;
     val_index minloc, maxloc;
     
     nfield = fields.size();
@@ -616,60 +652,71 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
         
             Field *field = fields[ifield];
             
-            vector<unsigned int> iFieldStart( 3, 0 ), iFieldEnd( 3, 1 ), iFieldGlobalSize( 3, 1 );
-            for( unsigned int i=0 ; i<field->isDual_.size() ; i++ ) {
-                iFieldStart[i] = EMfields->istart[i][field->isDual( i )];
-                iFieldEnd [i] = iFieldStart[i] + EMfields->bufsize[i][field->isDual( i )];
-                iFieldGlobalSize [i] = field->dims_[i];
+            // The dimensions of the field are shifted to the end so that the last one (contiguous in memory) is always k
+            unsigned int nDim = field->isDual_.size();
+            unsigned int iFieldStart[3] = {0, 0, 0}, iFieldEnd[3] = {1, 1, 1}, iFieldGlobalSize[3] = {1, 1, 1};
+            for( unsigned int i=0 ; i<nDim ; i++ ) {
+                iFieldStart     [3-nDim+i] = EMfields->istart[i][field->isDual( i )];
+                iFieldEnd       [3-nDim+i] = iFieldStart[3-nDim+i] + EMfields->bufsize[i][field->isDual( i )];
+                iFieldGlobalSize[3-nDim+i] = field->dims_[i];
             }
             
             unsigned int iifield= iFieldStart[2] + iFieldStart[1]*iFieldGlobalSize[2] +iFieldStart[0]*iFieldGlobalSize[1]*iFieldGlobalSize[2];
             minloc.val = maxloc.val = ( *field )( iifield );
-            i_min = iFieldStart[0];
-            j_min = iFieldStart[1];
-            k_min = iFieldStart[2];
-            i_max = iFieldStart[0];
-            j_max = iFieldStart[1];
-            k_max = iFieldStart[2];
+            unsigned int cell_min[3] = {iFieldStart[0], iFieldStart[1], iFieldStart[2]};
+            unsigned int cell_max[3] = {iFieldStart[0], iFieldStart[1], iFieldStart[2]};
             
-            for( unsigned int k=iFieldStart[2]; k<iFieldEnd[2]; k++ ) {
+            // Vectorized min and max of each row, the location is only searched in the rows which improve them
+            for( unsigned int i=iFieldStart[0]; i<iFieldEnd[0]; i++ ) {
                 for( unsigned int j=iFieldStart[1]; j<iFieldEnd[1]; j++ ) {
-                    for( unsigned int i=iFieldStart[0]; i<iFieldEnd[0]; i++ ) {
-                        unsigned int ii = k+ ( j + i*iFieldGlobalSize[1] ) *iFieldGlobalSize[2];
-                        fieldval = ( *field )( ii );
-                        if( minloc.val > fieldval ) {
-                            minloc.val = fieldval;
-                            i_min=i;
-                            j_min=j;
-                            k_min=k;
+                    double *row = field->data() + ( j + i*iFieldGlobalSize[1] ) *iFieldGlobalSize[2];
+                    double row_min = row[iFieldStart[2]];
+                    double row_max = row[iFieldStart[2]];
+                    #pragma omp simd reduction(min:row_min) reduction(max:row_max)
+                    for( unsigned int k=iFieldStart[2]; k<iFieldEnd[2]; k++ ) {
+                        row_min = std::min( row_min, row[k] );
+                        row_max = std::max( row_max, row[k] );
+                    }
+                    if( row_min < minloc.val ) {
+                        unsigned int k = iFieldStart[2];
+                        while( row[k] != row_min ) {
+                            k++;
                         }
-                        if( maxloc.val < fieldval ) {
-                            maxloc.val = fieldval;
-                            i_max=i;
-                            j_max=j;
-                            k_max=k;
+                        minloc.val = row_min;
+                        cell_min[0] = i;
+                        cell_min[1] = j;
+                        cell_min[2] = k;
+                    }
+                    if( row_max > maxloc.val ) {
+                        unsigned int k = iFieldStart[2];
+                        while( row[k] != row_max ) {
+                            k++;
                         }
+                        maxloc.val = row_max;
+                        cell_max[0] = i;
+                        cell_max[1] = j;
+                        cell_max[2] = k;
                     }
                 }
             }
             
-            i_min += patch->Pcoordinates[0]*n_space[0] - iFieldStart[0];
-            j_min += patch->Pcoordinates[1]*n_space[1] - iFieldStart[1];
-            k_min += patch->Pcoordinates[2]*n_space[2] - iFieldStart[2];
-            minloc.index = ( int )( i_min*n_space_global[1]*n_space_global[2] + j_min*n_space_global[2] + k_min );
-            i_max += patch->Pcoordinates[0]*n_space[0] - iFieldStart[0];
-            j_max += patch->Pcoordinates[1]*n_space[1] - iFieldStart[1];
-            k_max += patch->Pcoordinates[2]*n_space[2] - iFieldStart[2];
-            maxloc.index = ( int )( i_max*n_space_global[1]*n_space_global[2] + j_max*n_space_global[2] + k_max );
+            // Global index of the cells
+            minloc.index = 0;
+            maxloc.index = 0;
+            for( unsigned int i=0 ; i<nDim ; i++ ) {
+                int offset = ( int )( patch->Pcoordinates[i]*n_space[i] ) - ( int )iFieldStart[3-nDim+i];
+                minloc.index = minloc.index * ( int )n_space_global[i] + ( int )cell_min[3-nDim+i] + offset;
+                maxloc.index = maxloc.index * ( int )n_space_global[i] + ( int )cell_max[3-nDim+i] + offset;
+            }
             
-            #pragma omp critical
-            {
-                if( minloc.val < ( double )*fieldMin[ifield] ) {
-                    *fieldMin[ifield] = minloc;
-                }
-                if( maxloc.val > ( double )*fieldMax[ifield] ) {
-                    *fieldMax[ifield] = maxloc;
-                }
+            // Combine with the other patches of this thread
+            val_index &thread_min = minlocs[fieldMin[ifield]->index];
+            val_index &thread_max = maxlocs[fieldMax[ifield]->index];
+            if( minloc.val < thread_min.val ) {
+                thread_min = minloc;
+            }
+            if( maxloc.val > thread_max.val ) {
+                thread_max = maxloc;
             }
         }
     }
@@ -685,22 +732,45 @@ void DiagnosticScalar::compute( Patch *patch, int timestep )
     for( unsigned int j=0; j<2; j++ ) { //directions (xmin/xmax, ymin/ymax, zmin/zmax)
         for( unsigned int i=0; i<EMfields->poynting[j].size(); i++ ) { //axis 0=x, 1=y, 2=z
             if( necessary_poy[k] ) {
-                *poy    [k] += EMfields->poynting     [j][i];
-                *poyInst[k] += EMfields->poynting_inst[j][i];
-                k++;
+                sum[poy    [k]->index] += EMfields->poynting     [j][i];
+                sum[poyInst[k]->index] += EMfields->poynting_inst[j][i];
             }
+            k++;
             
             Uelm_bnd_ += EMfields->poynting[j][i];
         }// i
     }// j
     
     if( necessary_Uelm_BC ) {
-        *Uelm_bnd += Uelm_bnd_;
+        sum[Uelm_bnd->index] += Uelm_bnd_;
     }
     
 } // END compute
 
 
+//! Combine the contributions of all threads (executed by a single thread, after all patches are computed)
+void DiagnosticScalar::reduceThreads()
+{
+    unsigned int nthreads = thread_SUM.size();
+    for( unsigned int ithread=0; ithread<nthreads; ithread++ ) {
+        for( unsigned int i=0; i<values_SUM.size(); i++ ) {
+            values_SUM[i] += thread_SUM[ithread][i];
+        }
+        if( necessary_fieldMinMax_any ) {
+            for( unsigned int i=0; i<values_MINLOC.size(); i++ ) {
+                if( thread_MINLOC[ithread][i].val < values_MINLOC[i].val ) {
+                    values_MINLOC[i] = thread_MINLOC[ithread][i];
+                }
+                if( thread_MAXLOC[ithread][i].val > values_MAXLOC[i].val ) {
+                    values_MAXLOC[i] = thread_MAXLOC[ithread][i];
+                }
+            }
+        }
+    }
+    
+} // END reduceThreads
+
+
 double DiagnosticScalar::getScalar( std::string key )
 {
     unsigned int k, s=allScalars.size();
@@ -137,6 +137,9 @@ public :
     //! Compute the various scalars when requested
     void compute( Patch *patch, int timestep );
     
+    //! Combine the contributions of all threads in the values to be reduced by MPI
+    void reduceThreads();
+    
     //! Latest timestep dumped
     int latest_timestep;
     
@@ -179,6 +182,10 @@ private :
     //! List of scalar values to be MAXLOCed by MPI
     std::vector<val_index> values_MAXLOC;
     
+    //! Contributions of each OpenMP thread to the lists above, combined once per rank by reduceThreads()
+    std::vector<std::vector<double> > thread_SUM;
+    std::vector<std::vector<val_index> > thread_MINLOC, thread_MAXLOC;
+    
     //! Volume of a cell (copied from params)
     double cell_volume;
     
@@ -221,6 +228,8 @@ private :
     // For the pair generation via the multiphoton Breit-Wheeler
     bool necessary_UmBWpairs;
     bool necessary_fieldMinMax_any;
+    //! The Poynting flux is only computed when one of the scalars needs it
+    bool necessary_poy_any;
     std::vector<bool> necessary_species, necessary_fieldUelm, necessary_fieldMinMax, necessary_poy;
 };
 
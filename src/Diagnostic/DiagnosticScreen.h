@@ -17,7 +17,9 @@ public :
     
     bool prepare( int timestep ) override;
     
-    void run( Patch *patch, int timestep, SimWindow *simWindow ) override;
+    bool usesPatch( Patch *patch ) override;
+    
+    void binParticles( Species *s, unsigned int istart, unsigned int npart, HistogramBuffers &buffers, SimWindow *simWindow ) override;
     
     bool writeNow( int timestep ) override;
     
@@ -0,0 +1,509 @@
+#include "PyTools.h"
+#include <iomanip>
+#include <sstream>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "DiagnosticStream.h"
+
+
+using namespace std;
+
+// Alignment of all arrays in the shared-memory segment
+const uint64_t stream_alignment = 64;
+
+static uint64_t streamAlign( uint64_t offset )
+{
+    return ( ( offset+stream_alignment-1 )/stream_alignment )*stream_alignment;
+}
+
+// Constructor
+DiagnosticStream::DiagnosticStream( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches, unsigned int n_stream ) :
+    n_stream_( n_stream ),
+    segment_( NULL ),
+    header_( NULL ),
+    slot_( NULL ),
+    npatches_( 0 ),
+    ndue_( 0 ),
+    stalled_read_count_( UINT64_MAX ),
+    truncation_warned_( false )
+{
+    fileId_ = 0;
+    dt_ = params.timestep;
+
+    ostringstream name( "" );
+    name << "Stream diagnostic #" << n_stream;
+    string errorPrefix = name.str();
+
+    if( params.geometry == "AMcylindrical" ) {
+        ERROR( errorPrefix << ": not available in AMcylindrical geometry" );
+    }
+
+    // get parameter "every" which describes a timestep selection
+    timeSelection = new TimeSelection(
+        PyTools::extract_py( "every", "DiagStream", n_stream ),
+        name.str()
+    );
+    // Nothing to flush
+    flush_timeSelection = new TimeSelection();
+
+    // Name of the shared-memory segment: one per MPI process
+    // The default name contains the pid of the master, so that two simulations on the same node do not collide
+    string stream_name( "" );
+    if( ! PyTools::extractOrNone( "name", stream_name, "DiagStream", n_stream ) || stream_name == "" ) {
+        int pid = getpid();
+        MPI_Bcast( &pid, 1, MPI_INT, 0, MPI_COMM_WORLD );
+        ostringstream n( "" );
+        n << "smilei_stream" << n_stream << "_" << pid;
+        stream_name = n.str();
+    }
+    if( stream_name.find( '/' ) != string::npos ) {
+        ERROR( errorPrefix << ": `name` cannot contain `/`" );
+    }
+    filename = stream_name;
+    ostringstream segment( "" );
+    segment << "/" << stream_name << "_" << smpi->getRank();
+    segment_name_ = segment.str();
+    MESSAGE( 1, errorPrefix << ": published as `" << stream_name << "`" );
+
+    // Ring buffer and backpressure policy
+    PyTools::extract( "slots", nslots_, "DiagStream", n_stream );
+    if( nslots_ < 1 ) {
+        ERROR( errorPrefix << ": `slots` must be at least 1" );
+    }
+    string policy;
+    PyTools::extract( "policy", policy, "DiagStream", n_stream );
+    if( policy == "block" ) {
+        policy_ = 0;
+    } else if( policy == "drop" ) {
+        policy_ = 1;
+    } else if( policy == "decimate" ) {
+        policy_ = 2;
+    } else {
+        ERROR( errorPrefix << ": `policy` must be \"block\", \"drop\" or \"decimate\"" );
+    }
+    PyTools::extract( "block_timeout", block_timeout_, "DiagStream", n_stream );
+    if( block_timeout_ < 0. ) {
+        ERROR( errorPrefix << ": `block_timeout` must be positive or zero" );
+    }
+
+    // Requested fields
+    vector<string> fieldsToStream( 0 );
+    PyTools::extractV( "fields", fieldsToStream, "DiagStream", n_stream );
+    hasRhoJs = false;
+    ostringstream ss( "" );
+    for( unsigned int i=0; i<fieldsToStream.size(); i++ ) {
+        unsigned int ifield = 0, nfields = vecPatches.emfields( 0 )->allFields.size();
+        while( ifield < nfields && vecPatches.emfields( 0 )->allFields[ifield]->name != fieldsToStream[i] ) {
+            ifield++;
+        }
+        if( ifield == nfields ) {
+            ERROR( errorPrefix << ": unknown field `" << fieldsToStream[i] << "`" );
+        }
+        for( unsigned int j=0; j<fields_names_.size(); j++ ) {
+            if( fields_names_[j] == fieldsToStream[i] ) {
+                ERROR( errorPrefix << ": field `" << fieldsToStream[i] << "` appears twice" );
+            }
+        }
+        fields_indexes_.push_back( ifield );
+        fields_names_  .push_back( fieldsToStream[i] );
+        ss << fieldsToStream[i] << " ";
+        if( fieldsToStream[i].at( 0 )=='J' || fieldsToStream[i].at( 0 )=='R' ) {
+            hasRhoJs = true;
+        }
+        // If field specific to a species, then allocate it
+        if( params.speciesField( fieldsToStream[i] ) != "" ) {
+            vecPatches.allocateField( ifield, params );
+        }
+    }
+
+    // Requested species and particle attributes
+    vector<string> species_names( 0 );
+    PyTools::extractV( "species", species_names, "DiagStream", n_stream );
+    for( unsigned int i=0; i<species_names.size(); i++ ) {
+        unsigned int ispec = 0, nspec = vecPatches( 0 )->vecSpecies.size();
+        while( ispec < nspec && vecPatches( 0 )->vecSpecies[ispec]->name_ != species_names[i] ) {
+            ispec++;
+        }
+        if( ispec == nspec ) {
+            ERROR( errorPrefix << ": unknown species `" << species_names[i] << "`" );
+        }
+        species_.push_back( ispec );
+    }
+    vector<string> attributes( 0 );
+    PyTools::extractV( "attributes", attributes, "DiagStream", n_stream );
+    const char *all_attributes[8] = { "x", "y", "z", "px", "py", "pz", "w", "q" };
+    // By default, positions, momenta and weights
+    if( attributes.size() == 0 ) {
+        for( unsigned int iattr=0; iattr<7; iattr++ ) {
+            if( iattr >= params.nDim_particle && iattr < 3 ) {
+                continue;
+            }
+            attributes.push_back( all_attributes[iattr] );
+        }
+    }
+    for( unsigned int i=0; i<attributes.size(); i++ ) {
+        unsigned int iattr = 0;
+        while( iattr < 8 && attributes[i] != all_attributes[iattr] ) {
+            iattr++;
+        }
+        if( iattr == 8 || ( iattr < 3 && iattr >= params.nDim_particle ) ) {
+            ERROR( errorPrefix << ": unknown particle attribute `" << attributes[i] << "`" );
+        }
+        attributes_.push_back( iattr );
+        attributes_names_.push_back( attributes[i] );
+    }
+    PyTools::extract( "particle_stride", particle_stride_, "DiagStream", n_stream );
+    if( particle_stride_ < 1 ) {
+        ERROR( errorPrefix << ": `particle_stride` must be at least 1" );
+    }
+    PyTools::extract( "max_particles", max_particles_, "DiagStream", n_stream );
+
+    // Each patch publishes its n_space cells starting from its first grid point
+    ndim_ = params.nDim_field;
+    n_space_  = params.n_space;
+    oversize_ = params.oversize;
+    cells_per_patch_ = 1;
+    for( unsigned int idim=0; idim<ndim_; idim++ ) {
+        cells_per_patch_ *= n_space_[idim];
+    }
+
+    // Capacity of the slots in number of patches: twice the average number of patches per process
+    // so that the load balancing does not truncate the frames
+    unsigned int average_patches = ( params.tot_number_of_patches + smpi->getSize() - 1 ) / smpi->getSize();
+    max_patches_ = min( 2*max( average_patches, ( unsigned int )vecPatches.size() ), params.tot_number_of_patches );
+
+    // Layout of a slot
+    uint64_t offset = sizeof( StreamSlotHeader );
+    count_offset_.resize( species_.size() );
+    for( unsigned int i=0; i<species_.size(); i++ ) {
+        count_offset_[i] = offset;
+        offset += sizeof( uint64_t );
+    }
+    patch_table_offset_ = streamAlign( offset );
+    offset = patch_table_offset_ + 4*sizeof( int32_t )*( uint64_t )max_patches_;
+    field_offset_.resize( fields_names_.size() );
+    for( unsigned int i=0; i<fields_names_.size(); i++ ) {
+        field_offset_[i] = streamAlign( offset );
+        offset = field_offset_[i] + sizeof( double )*( uint64_t )cells_per_patch_*( uint64_t )max_patches_;
+    }
+    attribute_offset_.resize( species_.size() );
+    for( unsigned int i=0; i<species_.size(); i++ ) {
+        attribute_offset_[i].resize( attributes_.size() );
+        for( unsigned int j=0; j<attributes_.size(); j++ ) {
+            attribute_offset_[i][j] = streamAlign( offset );
+            offset = attribute_offset_[i][j] + sizeof( double )*max_particles_;
+        }
+    }
+    slot_size_ = streamAlign( offset );
+
+    // The header contains the JSON schema, rounded to a page
+    schema_ = schema( params, smpi, vecPatches );
+    header_size_ = ( ( sizeof( StreamHeader ) + schema_.size() + 1 + 4095 )/4096 )*4096;
+
+    // Output info on diagnostics
+    if( smpi->isMaster() ) {
+        MESSAGE( 1, "Stream diagnostic #" << n_stream << " (shared memory /dev/shm/" << stream_name << "_*) :" );
+        if( fields_names_.size() > 0 ) {
+            MESSAGE( 2, "fields " << ss.str() );
+        }
+        if( species_.size() > 0 ) {
+            MESSAGE( 2, species_.size() << " species, one particle out of " << particle_stride_ );
+        }
+        MESSAGE( 2, nslots_ << " slots of " << Tools::printBytes( slot_size_ ) << ", policy \"" << policy << "\"" );
+    }
+
+} // END DiagnosticStream::DiagnosticStream
+
+
+DiagnosticStream::~DiagnosticStream()
+{
+    closeFile();
+    delete timeSelection;
+    delete flush_timeSelection;
+} // END DiagnosticStream::~DiagnosticStream
+
+
+string DiagnosticStream::schema( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches )
+{
+    ostringstream s( "" );
+    s << setprecision( 17 );
+    s << "{\"version\": 1, \"rank\": " << smpi->getRank() << ", \"nranks\": " << smpi->getSize();
+    s << ", \"geometry\": \"" << params.geometry << "\", \"timestep\": " << params.timestep;
+    s << ", \"cell_length\": [";
+    for( unsigned int idim=0; idim<ndim_; idim++ ) {
+        s << ( idim>0 ? ", " : "" ) << params.cell_length[idim];
+    }
+    s << "], \"n_space\": [";
+    for( unsigned int idim=0; idim<ndim_; idim++ ) {
+        s << ( idim>0 ? ", " : "" ) << n_space_[idim];
+    }
+    s << "], \"number_of_patches\": [";
+    for( unsigned int idim=0; idim<ndim_; idim++ ) {
+        s << ( idim>0 ? ", " : "" ) << params.number_of_patches[idim];
+    }
+    s << "], \"max_patches\": " << max_patches_ << ", \"patch_table\": " << patch_table_offset_;
+    s << ", \"fields\": [";
+    for( unsigned int i=0; i<fields_names_.size(); i++ ) {
+        s << ( i>0 ? ", " : "" ) << "{\"name\": \"" << fields_names_[i] << "\", \"offset\": " << field_offset_[i] << "}";
+    }
+    s << "], \"species\": [";
+    for( unsigned int i=0; i<species_.size(); i++ ) {
+        s << ( i>0 ? ", " : "" ) << "{\"name\": \"" << vecPatches( 0 )->vecSpecies[species_[i]]->name_ << "\"";
+        s << ", \"count\": " << count_offset_[i] << ", \"max_particles\": " << max_particles_ << ", \"attributes\": [";
+        for( unsigned int j=0; j<attributes_.size(); j++ ) {
+            s << ( j>0 ? ", " : "" ) << "{\"name\": \"" << attributes_names_[j] << "\", \"offset\": " << attribute_offset_[i][j] << "}";
+        }
+        s << "]}";
+    }
+    s << "], \"particle_stride\": " << particle_stride_ << "}";
+    return s.str();
+}
+
+
+void DiagnosticStream::openFile( Params &params, SmileiMPI *smpi, bool newfile )
+{
+    if( segment_ ) {
+        return;
+    }
+
+    // Never replace an existing segment: it may belong to another simulation running on the same node
+    int fd = shm_open( segment_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600 );
+    if( fd < 0 && errno == EEXIST ) {
+        ERROR( "Stream diagnostic #" << n_stream_ << ": shared memory " << segment_name_ << " already exists. "
+               << "Another simulation may be using this `name`; if not, remove /dev/shm" << segment_name_ );
+    }
+    if( fd < 0 ) {
+        ERROR( "Stream diagnostic #" << n_stream_ << ": cannot create shared memory " << segment_name_ << " (" << strerror( errno ) << ")" );
+    }
+    uint64_t size = header_size_ + ( uint64_t )nslots_ * slot_size_;
+    if( ftruncate( fd, size ) != 0 ) {
+        ERROR( "Stream diagnostic #" << n_stream_ << ": cannot allocate " << Tools::printBytes( size ) << " of shared memory (" << strerror( errno ) << ")" );
+    }
+    void *p = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    close( fd );
+    if( p == MAP_FAILED ) {
+        ERROR( "Stream diagnostic #" << n_stream_ << ": cannot map shared memory " << segment_name_ << " (" << strerror( errno ) << ")" );
+    }
+    segment_ = ( char * )p;
+    header_ = ( StreamHeader * )p;
+
+    // Header and schema. The magic string is written last so that a consumer never sees a partial header
+    memset( header_, 0, header_size_ );
+    header_->version     = 1;
+    header_->header_size = header_size_;
+    header_->slot_size   = slot_size_;
+    header_->nslots      = nslots_;
+    header_->policy      = policy_;
+    header_->decimation  = 1;
+    memcpy( segment_ + sizeof( StreamHeader ), schema_.c_str(), schema_.size()+1 );
+    __atomic_thread_fence( __ATOMIC_RELEASE );
+    memcpy( header_->magic, "SMILEIST", 8 );
+}
+
+
+void DiagnosticStream::closeFile()
+{
+    if( ! segment_ ) {
+        return;
+    }
+    __atomic_store_n( &header_->finished, 1, __ATOMIC_RELEASE );
+    munmap( segment_, header_size_ + ( uint64_t )nslots_ * slot_size_ );
+    // Consumers already attached keep their mapping
+    shm_unlink( segment_name_.c_str() );
+    segment_ = NULL;
+    header_ = NULL;
+}
+
+
+void DiagnosticStream::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches )
+{
+    openFile( params, smpi, true );
+}
+
+
+bool DiagnosticStream::prepare( int itime )
+{
+    return timeSelection->theTimeIsNow( itime );
+}
+
+
+char *DiagnosticStream::reserveSlot()
+{
+    uint64_t write_count = header_->write_count;
+
+    // Decimation: only one due frame out of `decimation` is published
+    ndue_++;
+    if( policy_ == 2 && ( ndue_-1 ) % header_->decimation != 0 ) {
+        return NULL;
+    }
+
+    uint64_t read_count = __atomic_load_n( &header_->read_count, __ATOMIC_ACQUIRE );
+    if( write_count - read_count >= nslots_ ) {
+        if( policy_ == 0 ) {
+            // Block until the consumer releases a slot, during block_timeout_ seconds at most.
+            // After a timeout, frames are dropped without waiting until the consumer releases a slot.
+            double start = MPI_Wtime();
+            while( write_count - read_count >= nslots_ ) {
+                if( read_count == stalled_read_count_ || ( block_timeout_ > 0. && MPI_Wtime() - start > block_timeout_ ) ) {
+                    if( read_count != stalled_read_count_ ) {
+                        int rank;
+                        MPI_Comm_rank( MPI_COMM_WORLD, &rank );
+                        __header( "WARNING proc " << rank, "Stream diagnostic #" << n_stream_ << ": no frame released by the consumer during "
+                                  << block_timeout_ << " s, frames are dropped until it resumes" );
+                        stalled_read_count_ = read_count;
+                    }
+                    __atomic_store_n( &header_->dropped, header_->dropped+1, __ATOMIC_RELEASE );
+                    return NULL;
+                }
+                usleep( 100 );
+                read_count = __atomic_load_n( &header_->read_count, __ATOMIC_ACQUIRE );
+            }
+        } else {
+            // Drop the frame, and publish less often when decimating
+            __atomic_store_n( &header_->dropped, header_->dropped+1, __ATOMIC_RELEASE );
+            if( policy_ == 2 && header_->decimation < 1024 ) {
+                __atomic_store_n( &header_->decimation, 2*header_->decimation, __ATOMIC_RELEASE );
+            }
+            return NULL;
+        }
+    } else if( policy_ == 2 && write_count == read_count && header_->decimation > 1 ) {
+        // The consumer has caught up: publish more often
+        __atomic_store_n( &header_->decimation, header_->decimation/2, __ATOMIC_RELEASE );
+    }
+
+    return segment_ + header_size_ + ( write_count % nslots_ ) * slot_size_;
+}
+
+
+void DiagnosticStream::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers )
+{
+    #pragma omp master
+    {
+        slot_ = reserveSlot();
+        if( slot_ ) {
+            // Patches that fit in the slot
+            npatches_ = min( ( unsigned int )vecPatches.size(), max_patches_ );
+
+            // Offset of each patch in the particle arrays, truncated to the capacity
+            bool truncated = npatches_ < vecPatches.size();
+            particle_start_.resize( species_.size() );
+            for( unsigned int i=0; i<species_.size(); i++ ) {
+                particle_start_[i].resize( npatches_+1 );
+                uint64_t n = 0;
+                for( unsigned int ipatch=0; ipatch<npatches_; ipatch++ ) {
+                    particle_start_[i][ipatch] = n;
+                    uint64_t npart = vecPatches( ipatch )->vecSpecies[species_[i]]->particles->size();
+                    n += ( npart + particle_stride_ - 1 ) / particle_stride_;
+                    if( n > max_particles_ ) {
+                        n = max_particles_;
+                        truncated = true;
+                    }
+                }
+                particle_start_[i][npatches_] = n;
+                *( uint64_t * )( slot_ + count_offset_[i] ) = n;
+            }
+            if( truncated && ! truncation_warned_ ) {
+                WARNING( "Stream diagnostic #" << n_stream_ << ": frame truncated to " << npatches_ << " patches and " << max_particles_ << " particles per species (see `max_particles`)" );
+                truncation_warned_ = true;
+            }
+
+            StreamSlotHeader *slot_header = ( StreamSlotHeader * )slot_;
+            slot_header->frame    = header_->write_count;
+            slot_header->timestep = itime;
+            slot_header->time     = itime * dt_;
+            slot_header->x_moved  = simWindow ? simWindow->getXmoved() : 0.;
+            slot_header->npatches = npatches_;
+        }
+    }
+    #pragma omp barrier
+    if( ! slot_ ) {
+        return;
+    }
+
+    // All threads copy the patches in the slot
+    #pragma omp for schedule(runtime)
+    for( unsigned int ipatch=0 ; ipatch<npatches_ ; ipatch++ ) {
+        Patch *patch = vecPatches( ipatch );
+        int32_t *table = ( int32_t * )( slot_ + patch_table_offset_ ) + 4*ipatch;
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            table[idim] = idim < ndim_ ? patch->Pcoordinates[idim] : 0;
+        }
+        table[3] = patch->Hindex();
+        copyFields( patch, ipatch, slot_ );
+        copyParticles( patch, ipatch, slot_ );
+    }
+
+    // Publish the frame
+    #pragma omp master
+    __atomic_store_n( &header_->write_count, header_->write_count+1, __ATOMIC_RELEASE );
+}
+
+
+void DiagnosticStream::copyFields( Patch *patch, unsigned int ipatch, char *slot )
+{
+    unsigned int nx = n_space_[0];
+    unsigned int ny = ndim_ > 1 ? n_space_[1] : 1;
+    unsigned int nz = ndim_ > 2 ? n_space_[2] : 1;
+    for( unsigned int ifield=0; ifield<fields_indexes_.size(); ifield++ ) {
+        Field *field = patch->EMfields->allFields[fields_indexes_[ifield]];
+        double *out = ( double * )( slot + field_offset_[ifield] ) + ( uint64_t )ipatch * cells_per_patch_;
+        if( field->data_ == NULL ) {
+            memset( out, 0, cells_per_patch_*sizeof( double ) );
+            continue;
+        }
+        unsigned int sy = ndim_ > 1 ? field->dims_[1] : 1;
+        unsigned int sz = ndim_ > 2 ? field->dims_[2] : 1;
+        unsigned int ox = oversize_[0];
+        unsigned int oy = ndim_ > 1 ? oversize_[1] : 0;
+        unsigned int oz = ndim_ > 2 ? oversize_[2] : 0;
+        for( unsigned int i=0; i<nx; i++ ) {
+            for( unsigned int j=0; j<ny; j++ ) {
+                memcpy( out, &field->data_[( ( i+ox )*sy + j+oy )*sz + oz], nz*sizeof( double ) );
+                out += nz;
+            }
+        }
+    }
+}
+
+
+void DiagnosticStream::copyParticles( Patch *patch, unsigned int ipatch, char *slot )
+{
+    for( unsigned int i=0; i<species_.size(); i++ ) {
+        Particles *particles = patch->vecSpecies[species_[i]]->particles;
+        uint64_t start = particle_start_[i][ipatch];
+        uint64_t n = particle_start_[i][ipatch+1] - start;
+        if( n == 0 ) {
+            continue;
+        }
+        for( unsigned int j=0; j<attributes_.size(); j++ ) {
+            double *out = ( double * )( slot + attribute_offset_[i][j] ) + start;
+            unsigned int iattr = attributes_[j];
+            if( iattr < 3 ) {
+                double *x = &( particles->position( iattr, 0 ) );
+                for( uint64_t ip=0; ip<n; ip++ ) {
+                    out[ip] = x[ip*particle_stride_];
+                }
+            } else if( iattr < 6 ) {
+                double *p = &( particles->momentum( iattr-3, 0 ) );
+                for( uint64_t ip=0; ip<n; ip++ ) {
+                    out[ip] = p[ip*particle_stride_];
+                }
+            } else if( iattr == 6 ) {
+                double *w = &( particles->weight( 0 ) );
+                for( uint64_t ip=0; ip<n; ip++ ) {
+                    out[ip] = w[ip*particle_stride_];
+                }
+            } else {
+                short *q = &( particles->charge( 0 ) );
+                for( uint64_t ip=0; ip<n; ip++ ) {
+                    out[ip] = ( double )q[ip*particle_stride_];
+                }
+            }
+        }
+    }
+}
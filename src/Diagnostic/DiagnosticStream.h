@@ -0,0 +1,168 @@
+#ifndef DIAGNOSTICSTREAM_H
+#define DIAGNOSTICSTREAM_H
+
+#include "Diagnostic.h"
+#include "VectorPatch.h"
+
+//! Header at the beginning of the shared-memory segment of a stream diagnostic
+//! It is followed by a JSON schema describing the content of the slots, then by the slots
+struct StreamHeader {
+    //! "SMILEIST"
+    char magic[8];
+    //! Version of the layout
+    uint32_t version;
+    //! Size of the header, including the JSON schema (offset of the first slot)
+    uint32_t header_size;
+    //! Size of each slot
+    uint64_t slot_size;
+    //! Number of slots in the ring buffer
+    uint32_t nslots;
+    //! Backpressure policy (0: block, 1: drop, 2: decimate)
+    uint32_t policy;
+    //! Number of frames published so far (written by the simulation)
+    uint64_t write_count;
+    //! Number of frames released so far (written by the consumer)
+    uint64_t read_count;
+    //! Number of frames dropped because the ring buffer was full
+    uint64_t dropped;
+    //! Current decimation factor (policy "decimate")
+    uint32_t decimation;
+    //! Set to 1 when the simulation has finished
+    uint32_t finished;
+};
+
+//! Header of each slot, followed by the number of particles of each species
+struct StreamSlotHeader {
+    //! Index of the frame
+    uint64_t frame;
+    //! Timestep of the frame
+    int64_t timestep;
+    //! Time of the frame
+    double time;
+    //! Distance travelled by the moving window
+    double x_moved;
+    //! Number of patches in the frame
+    uint64_t npatches;
+};
+
+class DiagnosticStream : public Diagnostic
+{
+public :
+
+    //! Default constructor
+    DiagnosticStream( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches, unsigned int n_stream );
+    //! Default destructor
+    ~DiagnosticStream() override;
+
+    //! Creates and maps the shared-memory segment
+    void openFile( Params &params, SmileiMPI *smpi, bool newfile ) override;
+
+    //! Marks the stream as finished, unmaps and unlinks the shared-memory segment
+    void closeFile() override;
+
+    void init( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches ) override;
+
+    bool prepare( int itime ) override;
+
+    void run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers ) override;
+
+    bool needsRhoJs( int itime ) override
+    {
+        return hasRhoJs && timeSelection->theTimeIsNow( itime );
+    }
+
+    //! Get memory footprint of current diagnostic (the shared-memory segment)
+    int getMemFootPrint() override
+    {
+        uint64_t size = header_size_ + ( uint64_t )nslots_ * slot_size_;
+        return size > 2147483647 ? 2147483647 : ( int )size;
+    };
+
+private :
+
+    //! Waits for, or gives up, a free slot according to the policy. Returns NULL if the frame is dropped
+    char *reserveSlot();
+
+    //! Copies the requested fields of one patch in the slot
+    void copyFields( Patch *patch, unsigned int ipatch, char *slot );
+
+    //! Copies the selected particles of one patch in the slot
+    void copyParticles( Patch *patch, unsigned int ipatch, char *slot );
+
+    //! Builds the JSON schema of the stream
+    std::string schema( Params &params, SmileiMPI *smpi, VectorPatch &vecPatches );
+
+    //! Index of the stream diagnostic
+    unsigned int n_stream_;
+
+    //! Name of the shared-memory segment
+    std::string segment_name_;
+
+    //! Whether the fields J or Rho are needed
+    bool hasRhoJs;
+
+    //! Indices and names of the fields in ElectroMagn::allFields
+    std::vector<unsigned int> fields_indexes_;
+    std::vector<std::string> fields_names_;
+
+    //! Indices of the species, and of the particle attributes (0-2: position, 3-5: momentum, 6: weight, 7: charge)
+    std::vector<unsigned int> species_;
+    std::vector<unsigned int> attributes_;
+    std::vector<std::string> attributes_names_;
+
+    //! Only one particle out of particle_stride_ is published
+    unsigned int particle_stride_;
+
+    //! Capacity of a slot: number of patches, and particles for each species
+    unsigned int max_patches_;
+    uint64_t max_particles_;
+
+    //! Backpressure policy (0: block, 1: drop, 2: decimate)
+    uint32_t policy_;
+
+    //! Number of slots and their size
+    unsigned int nslots_;
+    uint64_t slot_size_;
+    uint64_t header_size_;
+
+    //! Offsets in a slot: patch table, fields, particle counts and particle attributes
+    uint64_t patch_table_offset_;
+    std::vector<uint64_t> field_offset_;
+    std::vector<uint64_t> count_offset_;
+    std::vector<std::vector<uint64_t> > attribute_offset_;
+
+    //! Geometry of the patches
+    unsigned int ndim_;
+    std::vector<unsigned int> n_space_, oversize_;
+    unsigned int cells_per_patch_;
+
+    //! Mapped segment
+    char *segment_;
+    StreamHeader *header_;
+
+    //! JSON schema, written after the header
+    std::string schema_;
+
+    //! Slot of the current frame (NULL if dropped)
+    char *slot_;
+
+    //! Number of patches published in the current frame, and offset of each patch in the particle arrays
+    unsigned int npatches_;
+    std::vector<std::vector<uint64_t> > particle_start_;
+
+    //! Number of frames that were due (for the decimation)
+    uint64_t ndue_;
+
+    //! Policy "block": longest wait for a free slot (seconds, 0 for no limit),
+    //! and number of frames released by the consumer when it stopped releasing them (UINT64_MAX if not stalled)
+    double block_timeout_;
+    uint64_t stalled_read_count_;
+
+    //! Whether the truncation of a frame has already been reported
+    bool truncation_warned_;
+
+    //! Timestep
+    double dt_;
+};
+
+#endif
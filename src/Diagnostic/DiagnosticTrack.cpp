@@ -2,12 +2,15 @@
 
 #include <string>
 #include <sstream>
+#include <limits>
+#include <algorithm>
 
 #include "ParticleData.h"
 #include "PeekAtSpecies.h"
 #include "DiagnosticTrack.h"
 #include "VectorPatch.h"
 #include "Params.h"
+#include "Function.h"
 
 using namespace std;
 
@@ -48,19 +51,64 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         vecPatches( ipatch )->vecSpecies[speciesId_]->tracking_diagnostic = idiag;
     }
     
-    // Get parameter "filter" which gives a python function to select particles
+    // Get parameter "filter" which gives a python function or an expression to select particles
     filter = PyTools::extract_py( "filter", "DiagTrackParticles", iDiagTrackParticles );
     has_filter = ( filter != Py_None );
+    compiled_filter_ = NULL;
+    filter_uses_charge_ = false;
+    filter_uses_id_ = false;
     if( has_filter ) {
-#ifdef SMILEI_USE_NUMPY
         PyTools::setIteration( 0 );
-        // Test the filter with temporary, "fake" particles
         name << " filter:";
-        bool *dummy = NULL;
-        ParticleData test( nDim_particle, filter, name.str(), dummy );
+        
+        // Try to translate the filter into a program evaluated natively (see pyprofiles.py):
+        // always for an expression, and for a python function only if compile_filter is set
+        // Variables: position, momentum, weight, charge, id, chi, then the iteration
+        unsigned int nvariables = nDim_particle + 8;
+        string expression;
+        bool is_expression = PyTools::py2scalar( filter, expression );
+        bool compile_filter = false;
+        PyTools::extract( "compile_filter", compile_filter, "DiagTrackParticles", iDiagTrackParticles );
+        PyObject *compile = NULL;
+        if( compile_filter || is_expression ) {
+            compile = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_compile_filter" );
+        }
+        if( compile ) {
+            PyObject *program = PyObject_CallFunction( compile, const_cast<char *>( "Oi" ), filter, nDim_particle );
+            PyTools::checkPyError( false, false );
+            vector<string> operations;
+            vector<double> values;
+            if( program && PyTuple_Check( program ) && PyTuple_Size( program ) == 2
+                    && PyTools::py2vector( PyTuple_GetItem( program, 0 ), operations )
+                    && PyTools::py2vector( PyTuple_GetItem( program, 1 ), values ) ) {
+                compiled_filter_ = new Function_Compiled( operations, values, nvariables );
+                if( ! compiled_filter_->isValid() ) {
+                    delete compiled_filter_;
+                    compiled_filter_ = NULL;
+                }
+            }
+            Py_XDECREF( program );
+            Py_DECREF( compile );
+        }
+        PyTools::checkPyError( false, false );
+        
+        if( compiled_filter_ ) {
+            if( compiled_filter_->usesVariable( nDim_particle+6 ) && ! vecPatches( 0 )->vecSpecies[speciesId_]->particles->isQuantumParameter ) {
+                ERROR( name.str() << " attribute `chi` not available for this species" );
+            }
+            filter_uses_charge_ = compiled_filter_->usesVariable( nDim_particle+4 );
+            filter_uses_id_     = compiled_filter_->usesVariable( nDim_particle+5 );
+        } else if( is_expression ) {
+            ERROR( name.str() << " expression `" << expression << "` could not be compiled" );
+        } else {
+#ifdef SMILEI_USE_NUMPY
+            // Test the filter with temporary, "fake" particles
+            bool *dummy = NULL;
+            ParticleData test( nDim_particle, filter, name.str(), dummy );
 #else
-        ERROR( name.str() << " with a filter requires the numpy package" );
+            ERROR( name.str() << " requires the numpy package (or an expression which can be compiled)" );
 #endif
+        }
     }
     
     // Get the parameter "attributes": a list of attribute name that must be written
@@ -139,15 +187,60 @@ DiagnosticTrack::DiagnosticTrack( Params &params, SmileiMPI *smpi, VectorPatch &
         ERROR( "DiagTrackParticles #" << iDiagTrackParticles << ": attribute `chi` not available for this species" );
     }
     
+    // Get parameter "ordered" which writes the particles in ID order
+    PyTools::extract( "ordered", ordered_, "DiagTrackParticles", iDiagTrackParticles );
+    nslots_ = 0;
+    nslots_written_ = 0;
+    ntimes_ordered_ = 0;
+    if( ordered_ ) {
+        ordered_datasets_.push_back( "Id" );
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_position[idim] ) {
+                ordered_datasets_.push_back( string( 1, "xyz"[idim] ) );
+            }
+        }
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_momentum[idim] ) {
+                ordered_datasets_.push_back( "p" + string( 1, "xyz"[idim] ) );
+            }
+        }
+        if( write_charge ) {
+            ordered_datasets_.push_back( "q" );
+        }
+        if( write_weight ) {
+            ordered_datasets_.push_back( "w" );
+        }
+        if( write_chi ) {
+            ordered_datasets_.push_back( "chi" );
+        }
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_E[idim] ) {
+                ordered_datasets_.push_back( "E" + string( 1, "xyz"[idim] ) );
+            }
+        }
+        for( unsigned int idim=0; idim<3; idim++ ) {
+            if( write_B[idim] ) {
+                ordered_datasets_.push_back( "B" + string( 1, "xyz"[idim] ) );
+            }
+        }
+        // Chunks of about 1 MB covering many iterations, so that trajectories are read in few chunks
+        int ndumps = timeSelection->howManyTimesBefore( params.n_time ) + 1;
+        chunk_times_ = min( max( ndumps, 1 ), 128 );
+        chunk_slots_ = 131072 / chunk_times_;
+    }
+    
     // Create the filename
     ostringstream hdf_filename( "" );
-    hdf_filename << "TrackParticlesDisordered_" << species_name  << ".h5" ;
+    hdf_filename << ( ordered_ ? "TrackParticles_" : "TrackParticlesDisordered_" ) << species_name  << ".h5" ;
     filename = hdf_filename.str();
     
     // Print some info
     if( smpi->isMaster() ) {
         MESSAGE( 1, "Created TrackParticles #" << iDiagTrackParticles << ": species " << species_name );
         MESSAGE( 2, attr_list.str() );
+        if( ordered_ ) {
+            MESSAGE( 2, "written in ID order" );
+        }
     }
     
     // Obtain the approximate number of particles in the species
@@ -165,6 +258,7 @@ DiagnosticTrack::~DiagnosticTrack()
     delete flush_timeSelection;
     H5Pclose( transfer );
     Py_DECREF( filter );
+    delete compiled_filter_;
 }
 
 
@@ -178,11 +272,33 @@ void DiagnosticTrack::openFile( Params &params, SmileiMPI *smpi, bool newfile )
         fileId_ = H5Fcreate( filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, pid );
         H5Pclose( pid );
         
-        // Attributes for openPMD
-        openPMD_->writeRootAttributes( fileId_, "no_meshes", "particles/" );
-        
-        // Create "data" group for openPMD compatibility
-        data_group_id = H5::group( fileId_, "data" );
+        if( ordered_ ) {
+            // Same structure as the file ordered by happi, which thus needs no ordering
+            H5::attr( fileId_, "finished_ordering", 1 );
+            H5::attr( fileId_, "ordered_by_smilei", 1 );
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            short zero_short = 0;
+            int zero_int = 0;
+            uint64_t zero_uint64 = 0;
+            for( unsigned int i=0; i<ordered_datasets_.size(); i++ ) {
+                if( ordered_datasets_[i] == "Id" ) {
+                    createOrderedDataset( "Id", H5T_NATIVE_UINT64, &zero_uint64, {chunk_times_, chunk_slots_} );
+                } else if( ordered_datasets_[i] == "q" ) {
+                    createOrderedDataset( "q", H5T_NATIVE_SHORT, &zero_short, {chunk_times_, chunk_slots_} );
+                } else {
+                    createOrderedDataset( ordered_datasets_[i], H5T_NATIVE_DOUBLE, &nan, {chunk_times_, chunk_slots_} );
+                }
+            }
+            createOrderedDataset( "unique_Ids", H5T_NATIVE_UINT64, &zero_uint64, {chunk_times_*chunk_slots_} );
+            createOrderedDataset( "Times", H5T_NATIVE_INT, &zero_int, {chunk_times_} );
+            createOrderedDataset( "x_moved", H5T_NATIVE_DOUBLE, &nan, {chunk_times_} );
+        } else {
+            // Attributes for openPMD
+            openPMD_->writeRootAttributes( fileId_, "no_meshes", "particles/" );
+            
+            // Create "data" group for openPMD compatibility
+            data_group_id = H5::group( fileId_, "data" );
+        }
         
     } else {
         // Open the file
@@ -198,7 +314,9 @@ void DiagnosticTrack::openFile( Params &params, SmileiMPI *smpi, bool newfile )
 void DiagnosticTrack::closeFile()
 {
     if( fileId_>0 ) {
-        H5Gclose( data_group_id );
+        if( ! ordered_ ) {
+            H5Gclose( data_group_id );
+        }
         H5Fclose( fileId_ );
         fileId_=0;
     }
@@ -222,6 +340,11 @@ void DiagnosticTrack::init( Params &params, SmileiMPI *smpi, VectorPatch &vecPat
     openFile( params, smpi, true );
     H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
     
+    // After a restart, the IDs keep the slots they had in the previous run
+    if( ordered_ && params.restart ) {
+        restoreOrderedLayout( smpi );
+    }
+    
 }
 
 
@@ -233,66 +356,22 @@ bool DiagnosticTrack::prepare( int itime )
 
 void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow, Timers &timers )
 {
+    // Select the particles and obtain their partition among the patches
+    selectParticles( vecPatches, itime );
+    
+    if( ordered_ ) {
+        runOrdered( smpi, vecPatches, itime, simWindow );
+        return;
+    }
+    
     uint64_t nParticles_global = 0;
     string xyz = "xyz";
     
     hid_t momentum_group=0, position_group=0, iteration_group=0, particles_group=0, species_group=0;
     hid_t plist=0, file_space=0, mem_space=0;
+    
     #pragma omp master
     {
-        // Obtain the particle partition of all the patches in this MPI
-        nParticles_local = 0;
-        patch_start.resize( vecPatches.size() );
-        
-        if( has_filter ) {
-        
-#ifdef SMILEI_USE_NUMPY
-            // Set a python variable "Main.iteration" to itime so that it can be accessed in the filter
-            PyTools::setIteration( itime );
-            
-            patch_selection.resize( vecPatches.size() );
-            PyArrayObject *ret;
-            ParticleData particleData( 0 );
-            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-                patch_selection[ipatch].resize( 0 );
-                Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
-                unsigned int npart = p->size();
-                if( npart > 0 ) {
-                    // Expose particle data as numpy arrays
-                    particleData.resize( npart );
-                    particleData.set( p );
-                    // run the filter function
-                    ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
-                    PyTools::checkPyError();
-                    particleData.clear();
-                    if( ret == NULL ) {
-                        ERROR( "A DiagTrackParticles filter has not provided a correct result" );
-                    }
-                    // Loop the return value and store the particle IDs
-                    bool *arr = ( bool * ) PyArray_GETPTR1( ret, 0 );
-                    for( unsigned int i=0; i<npart; i++ ) {
-                        if( arr[i] ) {
-                            patch_selection[ipatch].push_back( i );
-                            // If particle not tracked before (ID==0), then set its ID
-                            if( p->id( i ) == 0 ) {
-                                p->id( i ) = ++latest_Id;
-                            }
-                        }
-                    }
-                    Py_DECREF( ret );
-                }
-                patch_start[ipatch] = nParticles_local;
-                nParticles_local += patch_selection[ipatch].size();
-            }
-#endif
-            
-        } else {
-            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
-                patch_start[ipatch] = nParticles_local;
-                nParticles_local += vecPatches( ipatch )->vecSpecies[speciesId_]->getNbrOfParticles();
-            }
-        }
-        
         // Specify the memory dataspace (the size of the local buffer)
         hsize_t count_ = nParticles_local;
         mem_space = H5Screate_simple( 1, &count_, NULL );
@@ -487,34 +566,8 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
         #pragma omp master
         data_double.resize( nParticles_local*6 );
         
-        // Do the interpolation
-        unsigned int nPatches=vecPatches.size();
-        #pragma omp barrier
-        
-        if( has_filter ) {
-            #pragma omp for schedule(static)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
-                    vecPatches.emfields( ipatch ),
-                    *( vecPatches.species( ipatch, speciesId_ )->particles ),
-                    &data_double[patch_start[ipatch]],
-                    ( int ) nParticles_local,
-                    &patch_selection[ipatch]
-                );
-            }
-        } else {
-            #pragma omp for schedule(static)
-            for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
-                vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
-                    vecPatches.emfields( ipatch ),
-                    *( vecPatches.species( ipatch, speciesId_ )->particles ),
-                    &data_double[patch_start[ipatch]],
-                    ( int ) nParticles_local,
-                    NULL
-                );
-            }
-        }
         #pragma omp barrier
+        interpolateFields( vecPatches );
         
         // Write out the fields
         #pragma omp master
@@ -578,6 +631,540 @@ void DiagnosticTrack::run( SmileiMPI *smpi, VectorPatch &vecPatches, int itime,
 }
 
 
+void DiagnosticTrack::selectParticles( VectorPatch &vecPatches, int itime )
+{
+    // The compiled filter is evaluated by all threads, without python
+    if( compiled_filter_ ) {
+        #pragma omp single
+        patch_selection.resize( vecPatches.size() );
+        
+        vector<const double *> variables( nDim_particle+7, NULL );
+        vector<double> values, charge, id;
+        #pragma omp for schedule(dynamic)
+        for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+            patch_selection[ipatch].resize( 0 );
+            Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+            unsigned int npart = p->size();
+            if( npart == 0 ) {
+                continue;
+            }
+            for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+                variables[idim] = &( p->Position[idim][0] );
+            }
+            for( unsigned int idim=0; idim<3; idim++ ) {
+                variables[nDim_particle+idim] = &( p->Momentum[idim][0] );
+            }
+            variables[nDim_particle+3] = &( p->Weight[0] );
+            if( filter_uses_charge_ ) {
+                charge.resize( npart );
+                short *q = &( p->Charge[0] );
+                #pragma omp simd
+                for( unsigned int i=0; i<npart; i++ ) {
+                    charge[i] = q[i];
+                }
+                variables[nDim_particle+4] = &charge[0];
+            }
+            if( filter_uses_id_ ) {
+                id.resize( npart );
+                uint64_t *pid = &( p->Id[0] );
+                for( unsigned int i=0; i<npart; i++ ) {
+                    id[i] = ( double ) pid[i];
+                }
+                variables[nDim_particle+5] = &id[0];
+            }
+            if( p->isQuantumParameter ) {
+                variables[nDim_particle+6] = &( p->Chi[0] );
+            }
+            values.resize( npart );
+            compiled_filter_->valuesAt( &variables[0], ( double ) itime, npart, &values[0] );
+            for( unsigned int i=0; i<npart; i++ ) {
+                if( values[i] != 0. ) {
+                    patch_selection[ipatch].push_back( i );
+                }
+            }
+        }
+    }
+    
+    #pragma omp master
+    {
+        // Obtain the particle partition of all the patches in this MPI
+        nParticles_local = 0;
+        patch_start.resize( vecPatches.size() );
+        
+        if( has_filter ) {
+        
+            if( ! compiled_filter_ ) {
+#ifdef SMILEI_USE_NUMPY
+                // Set a python variable "Main.iteration" to itime so that it can be accessed in the filter
+                PyTools::setIteration( itime );
+                
+                patch_selection.resize( vecPatches.size() );
+                PyArrayObject *ret;
+                ParticleData particleData( 0 );
+                for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                    patch_selection[ipatch].resize( 0 );
+                    Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+                    unsigned int npart = p->size();
+                    if( npart > 0 ) {
+                        // Expose particle data as numpy arrays
+                        particleData.resize( npart );
+                        particleData.set( p );
+                        // run the filter function
+                        ret = ( PyArrayObject * )PyObject_CallFunctionObjArgs( filter, particleData.get(), NULL );
+                        PyTools::checkPyError();
+                        particleData.clear();
+                        if( ret == NULL ) {
+                            ERROR( "A DiagTrackParticles filter has not provided a correct result" );
+                        }
+                        // Loop the return value and store the particle IDs
+                        bool *arr = ( bool * ) PyArray_GETPTR1( ret, 0 );
+                        for( unsigned int i=0; i<npart; i++ ) {
+                            if( arr[i] ) {
+                                patch_selection[ipatch].push_back( i );
+                            }
+                        }
+                        Py_DECREF( ret );
+                    }
+                }
+#endif
+            }
+            
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                // If particle not tracked before (ID==0), then set its ID
+                Particles *p = vecPatches( ipatch )->vecSpecies[speciesId_]->particles;
+                for( unsigned int i=0; i<patch_selection[ipatch].size(); i++ ) {
+                    if( p->id( patch_selection[ipatch][i] ) == 0 ) {
+                        p->id( patch_selection[ipatch][i] ) = ++latest_Id;
+                    }
+                }
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += patch_selection[ipatch].size();
+            }
+            
+        } else {
+            for( unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++ ) {
+                patch_start[ipatch] = nParticles_local;
+                nParticles_local += vecPatches( ipatch )->vecSpecies[speciesId_]->getNbrOfParticles();
+            }
+        }
+    }
+    #pragma omp barrier
+}
+
+
+void DiagnosticTrack::interpolateFields( VectorPatch &vecPatches )
+{
+    unsigned int nPatches=vecPatches.size();
+    if( has_filter ) {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
+                vecPatches.emfields( ipatch ),
+                *( vecPatches.species( ipatch, speciesId_ )->particles ),
+                &data_double[patch_start[ipatch]],
+                ( int ) nParticles_local,
+                &patch_selection[ipatch]
+            );
+        }
+    } else {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<nPatches ; ipatch++ ) {
+            vecPatches.species( ipatch, speciesId_ )->Interp->fieldsSelection(
+                vecPatches.emfields( ipatch ),
+                *( vecPatches.species( ipatch, speciesId_ )->particles ),
+                &data_double[patch_start[ipatch]],
+                ( int ) nParticles_local,
+                NULL
+            );
+        }
+    }
+    #pragma omp barrier
+}
+
+
+void DiagnosticTrack::runOrdered( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow )
+{
+    // Id (also provides the slots of the particles)
+    #pragma omp master
+    data_uint64.resize( nParticles_local );
+    #pragma omp barrier
+    fill_buffer( vecPatches, 0, data_uint64 );
+    #pragma omp master
+    {
+        prepareOrdered( smpi, itime, simWindow );
+        writeOrdered( "Id", data_uint64.data(), H5T_NATIVE_UINT64, ( uint64_t ) 0 );
+        data_uint64.resize( 0 );
+    }
+    
+    // Charge
+    if( write_charge ) {
+        #pragma omp master
+        data_short.resize( nParticles_local );
+        #pragma omp barrier
+        fill_buffer( vecPatches, 0, data_short );
+        #pragma omp master
+        {
+            writeOrdered( "q", data_short.data(), H5T_NATIVE_SHORT, ( short ) 0 );
+            data_short.resize( 0 );
+        }
+    }
+    
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    #pragma omp master
+    data_double.resize( nParticles_local * ( interpolate ? 6 : 1 ) );
+    
+    // Weight
+    if( write_weight ) {
+        #pragma omp barrier
+        fill_buffer( vecPatches, nDim_particle+3, data_double );
+        #pragma omp master
+        writeOrdered( "w", data_double.data(), H5T_NATIVE_DOUBLE, nan );
+    }
+    
+    // Momentum
+    for( unsigned int idim=0; idim<3; idim++ ) {
+        if( write_momentum[idim] ) {
+            #pragma omp barrier
+            fill_buffer( vecPatches, nDim_particle+idim, data_double );
+            #pragma omp master
+            {
+                // Multiply by the mass to obtain an actual momentum (except for photons (mass = 0))
+                double mass = vecPatches( 0 )->vecSpecies[speciesId_]->mass_;
+                if( mass != 1. && mass > 0 ) {
+                    for( unsigned int ip=0; ip<nParticles_local; ip++ ) {
+                        data_double[ip] *= mass;
+                    }
+                }
+                writeOrdered( "p" + string( 1, "xyz"[idim] ), data_double.data(), H5T_NATIVE_DOUBLE, nan );
+            }
+        }
+    }
+    
+    // Position
+    for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
+        if( write_position[idim] ) {
+            #pragma omp barrier
+            fill_buffer( vecPatches, idim, data_double );
+            #pragma omp master
+            writeOrdered( string( 1, "xyz"[idim] ), data_double.data(), H5T_NATIVE_DOUBLE, nan );
+        }
+    }
+    
+    // Chi - quantum parameter
+    if( write_chi ) {
+        #pragma omp barrier
+#ifdef  __DEBUG
+        fill_buffer( vecPatches, nDim_particle+3+3+1, data_double );
+#else
+        fill_buffer( vecPatches, nDim_particle+3+1, data_double );
+#endif
+        #pragma omp master
+        writeOrdered( "chi", data_double.data(), H5T_NATIVE_DOUBLE, nan );
+    }
+    
+    // Fields
+    if( interpolate ) {
+        #pragma omp barrier
+        interpolateFields( vecPatches );
+        #pragma omp master
+        {
+            for( unsigned int idim=0; idim<3; idim++ ) {
+                if( write_E[idim] ) {
+                    writeOrdered( "E" + string( 1, "xyz"[idim] ), &data_double[idim*nParticles_local], H5T_NATIVE_DOUBLE, nan );
+                }
+            }
+            for( unsigned int idim=0; idim<3; idim++ ) {
+                if( write_B[idim] ) {
+                    writeOrdered( "B" + string( 1, "xyz"[idim] ), &data_double[( 3+idim )*nParticles_local], H5T_NATIVE_DOUBLE, nan );
+                }
+            }
+        }
+    }
+    
+    #pragma omp master
+    {
+        data_double.resize( 0 );
+        patch_selection.resize( 0 );
+        ntimes_ordered_++;
+        if( flush_timeSelection->theTimeIsNow( itime ) ) {
+            H5Fflush( fileId_, H5F_SCOPE_GLOBAL );
+        }
+    }
+    #pragma omp barrier
+}
+
+
+void DiagnosticTrack::prepareOrdered( SmileiMPI *smpi, int itime, SimWindow *simWindow )
+{
+    int nranks = smpi->getSize();
+    int rank = smpi->getRank();
+    
+    // Slots for the IDs created since the last output, by any rank, appended after the existing slots
+    // The IDs created by a rank are (rank<<32)+1, (rank<<32)+2, ... up to its latest_Id
+    vector<uint64_t> latest( nranks );
+    MPI_Allgather( &latest_Id, 1, MPI_UNSIGNED_LONG_LONG, &latest[0], 1, MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD );
+    for( int irank=0; irank<nranks; irank++ ) {
+        uint64_t creator = latest[irank] >> 32;
+        uint64_t last = latest[irank] & 0xffffffff;
+        vector<IDBlock> &blocks = id_blocks_[creator];
+        uint64_t covered = blocks.empty() ? 0 : blocks.back().first_id + blocks.back().count - 1;
+        if( last > covered ) {
+            IDBlock block = { covered+1, last-covered, nslots_ };
+            blocks.push_back( block );
+            nslots_ += block.count;
+        }
+    }
+    
+    // IDs of the slots not yet written in this file: the new slots, and after a restart those of the previous run
+    vector<uint64_t> new_ids;
+    if( rank == 0 && nslots_ > nslots_written_ ) {
+        new_ids.resize( nslots_ - nslots_written_ );
+        for( map<uint64_t, vector<IDBlock> >::iterator it = id_blocks_.begin(); it != id_blocks_.end(); it++ ) {
+            for( unsigned int ib=0; ib<it->second.size(); ib++ ) {
+                IDBlock &block = it->second[ib];
+                for( uint64_t slot = max( block.first_slot, nslots_written_ ); slot < block.first_slot + block.count; slot++ ) {
+                    new_ids[slot - nslots_written_] = ( it->first<<32 ) + block.first_id + slot - block.first_slot;
+                }
+            }
+        }
+    }
+    
+    // Extend the datasets (collective operation)
+    hsize_t dims[2] = { ntimes_ordered_+1, nslots_ };
+    for( unsigned int i=0; i<ordered_datasets_.size(); i++ ) {
+        hid_t did = H5Dopen( fileId_, ordered_datasets_[i].c_str(), H5P_DEFAULT );
+        H5Dset_extent( did, dims );
+        H5Dclose( did );
+    }
+    
+    // Rank 0 writes the IDs of the new slots, the iteration and x_moved
+    double x_moved = simWindow ? simWindow->getXmoved() : 0.;
+    vector<string> names = { "unique_Ids", "Times", "x_moved" };
+    vector<hid_t> types = { H5T_NATIVE_UINT64, H5T_NATIVE_INT, H5T_NATIVE_DOUBLE };
+    vector<const void *> values = { new_ids.data(), &itime, &x_moved };
+    vector<hsize_t> starts = { nslots_written_, ntimes_ordered_, ntimes_ordered_ };
+    vector<hsize_t> sizes = { nslots_, ntimes_ordered_+1, ntimes_ordered_+1 };
+    for( unsigned int i=0; i<names.size(); i++ ) {
+        hid_t did = H5Dopen( fileId_, names[i].c_str(), H5P_DEFAULT );
+        H5Dset_extent( did, &sizes[i] );
+        hid_t file_space = H5Dget_space( did );
+        hsize_t count = rank == 0 ? sizes[i] - starts[i] : 0;
+        hid_t mem_space = H5Screate_simple( 1, &count, NULL );
+        if( count > 0 ) {
+            H5Sselect_hyperslab( file_space, H5S_SELECT_SET, &starts[i], NULL, &count, NULL );
+        } else {
+            H5Sselect_none( file_space );
+            H5Sselect_none( mem_space );
+        }
+        H5Dwrite( did, types[i], mem_space, file_space, transfer, values[i] );
+        H5Sclose( mem_space );
+        H5Sclose( file_space );
+        H5Dclose( did );
+    }
+    nslots_written_ = nslots_;
+    
+    // Each rank writes a contiguous range of slots
+    slot_start_ = ( nslots_ * rank ) / nranks;
+    slot_end_   = ( nslots_ * ( rank+1 ) ) / nranks;
+    
+    // Find the slot of each local particle, and the rank owning this slot
+    vector<uint64_t> slot( nParticles_local );
+    vector<int> owner( nParticles_local, -1 );
+    send_count_.assign( nranks, 0 );
+    for( unsigned int ip=0; ip<nParticles_local; ip++ ) {
+        map<uint64_t, vector<IDBlock> >::iterator it = id_blocks_.find( data_uint64[ip] >> 32 );
+        if( it == id_blocks_.end() ) {
+            continue;
+        }
+        uint64_t id = data_uint64[ip] & 0xffffffff;
+        vector<IDBlock> &blocks = it->second;
+        unsigned int ib = upper_bound( blocks.begin(), blocks.end(), id, []( uint64_t i, const IDBlock &b ) {
+            return i < b.first_id;
+        } ) - blocks.begin();
+        if( ib == 0 || id >= blocks[ib-1].first_id + blocks[ib-1].count ) {
+            continue;
+        }
+        slot[ip] = blocks[ib-1].first_slot + id - blocks[ib-1].first_id;
+        int r = ( int )( ( slot[ip] * nranks ) / nslots_ );
+        while( r+1 < nranks && slot[ip] >= ( nslots_ * ( r+1 ) ) / nranks ) {
+            r++;
+        }
+        while( r > 0 && slot[ip] < ( nslots_ * r ) / nranks ) {
+            r--;
+        }
+        owner[ip] = r;
+        send_count_[r]++;
+    }
+    
+    // Exchange the numbers of particles and the slots
+    recv_count_.resize( nranks );
+    MPI_Alltoall( &send_count_[0], 1, MPI_INT, &recv_count_[0], 1, MPI_INT, MPI_COMM_WORLD );
+    send_displ_.resize( nranks );
+    recv_displ_.resize( nranks );
+    int nsend = 0, nrecv = 0;
+    for( int irank=0; irank<nranks; irank++ ) {
+        send_displ_[irank] = nsend;
+        recv_displ_[irank] = nrecv;
+        nsend += send_count_[irank];
+        nrecv += recv_count_[irank];
+    }
+    vector<int> filled( send_displ_ );
+    send_index_.resize( nParticles_local );
+    vector<uint64_t> send_slot( nsend );
+    for( unsigned int ip=0; ip<nParticles_local; ip++ ) {
+        if( owner[ip] < 0 ) {
+            send_index_[ip] = -1;
+        } else {
+            send_index_[ip] = filled[owner[ip]]++;
+            send_slot[send_index_[ip]] = slot[ip];
+        }
+    }
+    recv_index_.resize( nrecv );
+    MPI_Alltoallv( send_slot.data(), &send_count_[0], &send_displ_[0], MPI_UNSIGNED_LONG_LONG,
+                   recv_index_.data(), &recv_count_[0], &recv_displ_[0], MPI_UNSIGNED_LONG_LONG, MPI_COMM_WORLD );
+    for( int j=0; j<nrecv; j++ ) {
+        recv_index_[j] -= slot_start_;
+    }
+}
+
+
+void DiagnosticTrack::restoreOrderedLayout( SmileiMPI *smpi )
+{
+    // The master reads the IDs of all slots in the ordered file of the previous run,
+    // and gathers consecutive IDs of the same creator at consecutive slots into blocks
+    vector<uint64_t> flat_blocks; // creator, first_id, count, first_slot of each block
+    if( smpi->isMaster() ) {
+        string restart_dir;
+        PyTools::extract( "restart_dir", restart_dir, "Checkpoints" );
+        string previous = restart_dir + "/" + filename;
+        if( ! Tools::fileExists( previous ) || H5Fis_hdf5( previous.c_str() ) <= 0 ) {
+            WARNING( "DiagTrackParticles: file " << previous << " not found, IDs get new positions in " << filename );
+        } else {
+            hid_t fid = H5Fopen( previous.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT );
+            hid_t did = H5Dopen( fid, "unique_Ids", H5P_DEFAULT );
+            hid_t file_space = H5Dget_space( did );
+            hsize_t nslots = H5Sget_simple_extent_npoints( file_space );
+            map<uint64_t, vector<IDBlock> > blocks;
+            vector<uint64_t> ids( min( nslots, ( hsize_t ) 1048576 ) );
+            for( hsize_t start = 0; start < nslots; start += ids.size() ) {
+                hsize_t count = min( nslots - start, ( hsize_t ) ids.size() );
+                hid_t mem_space = H5Screate_simple( 1, &count, NULL );
+                H5Sselect_hyperslab( file_space, H5S_SELECT_SET, &start, NULL, &count, NULL );
+                H5Dread( did, H5T_NATIVE_UINT64, mem_space, file_space, H5P_DEFAULT, ids.data() );
+                H5Sclose( mem_space );
+                for( hsize_t i = 0; i < count; i++ ) {
+                    if( ids[i] == 0 ) {
+                        continue;
+                    }
+                    uint64_t creator = ids[i] >> 32, id = ids[i] & 0xffffffff, slot = start + i;
+                    vector<IDBlock> &b = blocks[creator];
+                    if( ! b.empty() && b.back().first_id + b.back().count == id && b.back().first_slot + b.back().count == slot ) {
+                        b.back().count++;
+                    } else {
+                        IDBlock block = { id, 1, slot };
+                        b.push_back( block );
+                    }
+                }
+            }
+            H5Sclose( file_space );
+            H5Dclose( did );
+            H5Fclose( fid );
+            for( map<uint64_t, vector<IDBlock> >::iterator it = blocks.begin(); it != blocks.end(); it++ ) {
+                for( unsigned int ib=0; ib<it->second.size(); ib++ ) {
+                    flat_blocks.push_back( it->first );
+                    flat_blocks.push_back( it->second[ib].first_id );
+                    flat_blocks.push_back( it->second[ib].count );
+                    flat_blocks.push_back( it->second[ib].first_slot );
+                }
+            }
+        }
+    }
+    
+    // All ranks rebuild the same blocks
+    uint64_t n = flat_blocks.size();
+    MPI_Bcast( &n, 1, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD );
+    flat_blocks.resize( n );
+    MPI_Bcast( flat_blocks.data(), n, MPI_UNSIGNED_LONG_LONG, 0, MPI_COMM_WORLD );
+    id_blocks_.clear();
+    nslots_ = 0;
+    for( uint64_t i=0; i<n; i+=4 ) {
+        IDBlock block = { flat_blocks[i+1], flat_blocks[i+2], flat_blocks[i+3] };
+        id_blocks_[flat_blocks[i]].push_back( block );
+        nslots_ += block.count;
+    }
+    
+    // The blocks of each creator must be sorted by ID for the search in prepareOrdered
+    for( map<uint64_t, vector<IDBlock> >::iterator it = id_blocks_.begin(); it != id_blocks_.end(); it++ ) {
+        sort( it->second.begin(), it->second.end(), []( const IDBlock &a, const IDBlock &b ) {
+            return a.first_id < b.first_id;
+        } );
+    }
+}
+
+
+template<typename T>
+void DiagnosticTrack::writeOrdered( string name, T *buffer, hid_t dtype, T fill )
+{
+    int nranks = send_count_.size();
+    
+    // Send the values to the ranks owning their slots
+    // (counted in values of type T, so that the counts do not overflow as byte counts would)
+    MPI_Datatype mpi_type;
+    MPI_Type_contiguous( sizeof( T ), MPI_BYTE, &mpi_type );
+    MPI_Type_commit( &mpi_type );
+    vector<T> send( send_displ_[nranks-1] + send_count_[nranks-1] );
+    vector<T> recv( recv_index_.size() );
+    for( unsigned int ip=0; ip<nParticles_local; ip++ ) {
+        if( send_index_[ip] >= 0 ) {
+            send[send_index_[ip]] = buffer[ip];
+        }
+    }
+    MPI_Alltoallv( send.data(), &send_count_[0], &send_displ_[0], mpi_type,
+                   recv.data(), &recv_count_[0], &recv_displ_[0], mpi_type, MPI_COMM_WORLD );
+    MPI_Type_free( &mpi_type );
+    
+    // Slots without particle (lost or not selected) receive the fill value
+    vector<T> row( slot_end_ - slot_start_, fill );
+    for( unsigned int j=0; j<recv.size(); j++ ) {
+        row[recv_index_[j]] = recv[j];
+    }
+    
+    // Collective write of the slot range of this rank at the current iteration
+    hid_t did = H5Dopen( fileId_, name.c_str(), H5P_DEFAULT );
+    hid_t file_space = H5Dget_space( did );
+    hsize_t start[2] = { ntimes_ordered_, slot_start_ };
+    hsize_t count[2] = { 1, row.size() };
+    hid_t mem_space = H5Screate_simple( 1, &count[1], NULL );
+    if( count[1] > 0 ) {
+        H5Sselect_hyperslab( file_space, H5S_SELECT_SET, start, NULL, count, NULL );
+    } else {
+        H5Sselect_none( file_space );
+        H5Sselect_none( mem_space );
+    }
+    H5Dwrite( did, dtype, mem_space, file_space, transfer, row.data() );
+    H5Sclose( mem_space );
+    H5Sclose( file_space );
+    H5Dclose( did );
+}
+
+
+void DiagnosticTrack::createOrderedDataset( string name, hid_t dtype, const void *fill, vector<hsize_t> chunk )
+{
+    unsigned int ndim = chunk.size();
+    vector<hsize_t> dims( ndim, 0 ), maxdims( ndim, H5S_UNLIMITED );
+    hid_t space = H5Screate_simple( ndim, &dims[0], &maxdims[0] );
+    hid_t plist = H5Pcreate( H5P_DATASET_CREATE );
+    H5Pset_layout( plist, H5D_CHUNKED );
+    H5Pset_chunk( plist, ndim, &chunk[0] );
+    H5Pset_alloc_time( plist, H5D_ALLOC_TIME_EARLY ); // necessary for collective dump
+    H5Pset_fill_value( plist, dtype, fill );
+    hid_t did = H5Dcreate( fileId_, name.c_str(), dtype, space, H5P_DEFAULT, plist, H5P_DEFAULT );
+    H5Dclose( did );
+    H5Pclose( plist );
+    H5Sclose( space );
+}
+
+
 void DiagnosticTrack::setIDs( Patch *patch )
 {
     // If filter, IDs are set on-the-fly
@@ -3,9 +3,12 @@
 
 #include "Diagnostic.h"
 
+#include <map>
+
 class Patch;
 class Params;
 class SmileiMPI;
+class Function_Compiled;
 
 
 class DiagnosticTrack : public Diagnostic
@@ -51,6 +54,12 @@ public :
     //! Set a given particles with the required IDs
     void setIDs( Particles & );
     
+    //! Select the particles (filter) and obtain their partition among the patches
+    void selectParticles( VectorPatch &vecPatches, int itime );
+    
+    //! Interpolate the fields at the positions of the selected particles, in data_double
+    void interpolateFields( VectorPatch &vecPatches );
+    
     //! Index of the species used
     unsigned int speciesId_;
     
@@ -77,6 +86,12 @@ private :
     //! Tells whether this diag includes a particle filter
     PyObject *filter;
     
+    //! Filter translated into a program evaluated natively (NULL if the python filter is used)
+    Function_Compiled *compiled_filter_;
+    
+    //! Tells whether the compiled filter uses the charge and the id (converted to double)
+    bool filter_uses_charge_, filter_uses_id_;
+    
     //! Selection of the filtered particles in each patch
     std::vector<std::vector<unsigned int> > patch_selection;
     
@@ -93,6 +108,56 @@ private :
     //! Number of particles shared among patches in this proc
     uint32_t nParticles_local;
     
+    //! Tells whether the particles are written in ID order (see runOrdered)
+    bool ordered_;
+    
+    //! Writes the selected particles at fixed positions (slots) given by their IDs
+    void runOrdered( SmileiMPI *smpi, VectorPatch &vecPatches, int itime, SimWindow *simWindow );
+    
+    //! Assigns slots to the new IDs and prepares the redistribution of the particles to the ranks owning their slots
+    void prepareOrdered( SmileiMPI *smpi, int itime, SimWindow *simWindow );
+    
+    //! After a restart, reads the slots of the IDs in the ordered file of the previous run
+    void restoreOrderedLayout( SmileiMPI *smpi );
+    
+    //! Redistributes a particle property and writes it at the current iteration of the ordered datasets
+    template<typename T> void writeOrdered( std::string name, T *buffer, hid_t dtype, T fill );
+    
+    //! Creates an extendable dataset in the ordered file
+    void createOrderedDataset( std::string name, hid_t dtype, const void *fill, std::vector<hsize_t> chunk );
+    
+    //! Consecutive IDs created by one MPI rank, written at consecutive slots
+    struct IDBlock {
+        uint64_t first_id;
+        uint64_t count;
+        uint64_t first_slot;
+    };
+    
+    //! Blocks of IDs of each creator (the upper 32 bits of the IDs)
+    std::map<uint64_t, std::vector<IDBlock> > id_blocks_;
+    
+    //! Total number of slots in the ordered datasets, and number of slots whose ID is written in this file
+    uint64_t nslots_, nslots_written_;
+    
+    //! Number of iterations written in the ordered datasets
+    hsize_t ntimes_ordered_;
+    
+    //! Range of slots written by this MPI rank
+    uint64_t slot_start_, slot_end_;
+    
+    //! Names of the ordered datasets of shape (iterations, slots)
+    std::vector<std::string> ordered_datasets_;
+    
+    //! Chunk size of the ordered datasets along the iterations and along the slots
+    hsize_t chunk_times_, chunk_slots_;
+    
+    //! Number of particles sent to and received from each rank, and their displacements
+    std::vector<int> send_count_, send_displ_, recv_count_, recv_displ_;
+    
+    //! Location of each local particle in the send buffer (-1 if not sent), and of each received particle in the slot range
+    std::vector<int> send_index_;
+    std::vector<uint64_t> recv_index_;
+    
     //! Booleans to determine which attributes to write out
     std::vector<bool> write_position;
     std::vector<bool> write_momentum;
@@ -7,18 +7,21 @@
 using namespace std;
 
 // Loop on the different axes requested and compute the output index of each particle
+// (particles istart to istart+npart-1, stored from index 0 in the buffers)
 void Histogram::digitize( Species *s,
                           std::vector<double> &double_buffer,
                           std::vector<int>    &int_buffer,
+                          unsigned int istart,
+                          unsigned int npart,
                           SimWindow *simWindow )
 {
-    unsigned int ipart, npart=s->particles->size();
+    unsigned int ipart;
     int ind;
     
     for( unsigned int iaxis=0 ; iaxis < axes.size() ; iaxis++ ) {
     
         // first loop on particles to store the indexing (axis) quantity
-        axes[iaxis]->digitize( s, double_buffer, int_buffer, npart, simWindow );
+        axes[iaxis]->digitize( s, double_buffer, int_buffer, istart, npart, simWindow );
         // Now, double_buffer has the location of each particle along the axis
         
         // if log scale, loop again and convert to log
@@ -86,10 +89,11 @@ void Histogram::digitize( Species *s,
 void Histogram::distribute(
     std::vector<double> &double_buffer,
     std::vector<int>    &int_buffer,
+    unsigned int npart,
     std::vector<double> &output_array )
 {
 
-    unsigned int ipart, npart=double_buffer.size();
+    unsigned int ipart;
     int ind;
     
     // Sum the data into the data_sum according to the indexes
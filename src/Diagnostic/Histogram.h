@@ -17,8 +17,9 @@ public:
     
     void init( std::string, double, double, int, bool, bool, std::vector<double> );
     
-    //! Function that goes through the particles and find where they should go in the axis
-    virtual void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int, SimWindow * ) {};
+    //! Function that goes through the particles istart to istart+npart-1 and find where they should go in the axis
+    //! (the buffers are indexed from 0 for particle istart)
+    virtual void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int istart, unsigned int npart, SimWindow * ) {};
     
     //! Print some info about the axis
     std::string info( std::string title = "" ) {
@@ -59,29 +60,53 @@ public:
 };
 
 
+// Buffers for binning a set of particles, reused by several diagnostics
+struct HistogramBuffers {
+    //! Index of each particle in the histogram (negative for discarded particles)
+    std::vector<int> int_buffer;
+    //! Location of each particle along an axis, then quantity deposited by each particle
+    std::vector<double> double_buffer;
+    //! Particles crossing a screen in the opposite direction
+    std::vector<bool> opposite;
+    
+    inline void resize( unsigned int npart )
+    {
+        if( int_buffer.size() < npart ) {
+            int_buffer   .resize( npart );
+            double_buffer.resize( npart );
+            opposite     .resize( npart );
+        }
+    }
+};
+
+
 // Class for making a histogram of particle data
 class Histogram
 {
 public:
-    Histogram() {};
+    Histogram() : calls_python( false ) {};
     virtual ~Histogram() {
         for( unsigned int iaxe=0; iaxe<axes.size(); iaxe++ ) {
             delete axes[iaxe];
         }
     };
     
-    //! Compute the index of each particle in the final histogram
-    void digitize( Species *, std::vector<double> &, std::vector<int> &, SimWindow * );
-    //! Calculate the quantity of each particle to be summed in the histogram
-    virtual void valuate( Species *, std::vector<double> &, std::vector<int> & ) {
+    //! Compute the index of each particle (istart to istart+npart-1) in the final histogram
+    void digitize( Species *, std::vector<double> &, std::vector<int> &, unsigned int istart, unsigned int npart, SimWindow * );
+    //! Calculate the quantity of each particle (istart to istart+npart-1) to be summed in the histogram
+    virtual void valuate( Species *, std::vector<double> &, std::vector<int> &, unsigned int istart, unsigned int npart ) {
         ERROR( "`deposited_quantity` should not be empty" );
     };
     //! Add the contribution of each particle in the histogram
-    void distribute( std::vector<double> &, std::vector<int> &, std::vector<double> & );
+    void distribute( std::vector<double> &, std::vector<int> &, unsigned int npart, std::vector<double> & );
 
     std::string deposited_quantity;
 
     std::vector<HistogramAxis *> axes;
+    
+    //! True if an axis or the deposited quantity is a python function: the particles of
+    //! a species must then be binned in a single call, as each call goes through the interpreter
+    bool calls_python;
 };
 
 
@@ -89,60 +114,60 @@ public:
 class HistogramAxis_x : public HistogramAxis
 {
     ~HistogramAxis_x() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[0][ipart];
+            array[ipart] = s->particles->Position[0][istart+ipart];
         }
     };
 };
 class HistogramAxis_moving_x : public HistogramAxis
 {
     ~HistogramAxis_moving_x() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         double x_moved = simWindow->getXmoved();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[0][ipart]-x_moved;
+            array[ipart] = s->particles->Position[0][istart+ipart]-x_moved;
         }
     };
 };
 class HistogramAxis_y : public HistogramAxis
 {
     ~HistogramAxis_y() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[1][ipart];
+            array[ipart] = s->particles->Position[1][istart+ipart];
         }
     };
 };
 class HistogramAxis_z : public HistogramAxis
 {
     ~HistogramAxis_z() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Position[2][ipart];
+            array[ipart] = s->particles->Position[2][istart+ipart];
         }
     };
 };
 class HistogramAxis_vector : public HistogramAxis
 {
     ~HistogramAxis_vector() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim, ndim = coefficients.size()/2;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
@@ -151,7 +176,7 @@ class HistogramAxis_vector : public HistogramAxis
             }
             array[ipart] = 0.;
             for( idim=0; idim<ndim; idim++ ) {
-                array[ipart] += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+ndim];
+                array[ipart] += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+ndim];
             }
         }
     };
@@ -159,15 +184,15 @@ class HistogramAxis_vector : public HistogramAxis
 class HistogramAxis_theta2D : public HistogramAxis
 {
     ~HistogramAxis_theta2D() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         double X, Y;
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            X = s->particles->Position[0][ipart] - coefficients[0];
-            Y = s->particles->Position[1][ipart] - coefficients[1];
+            X = s->particles->Position[0][istart+ipart] - coefficients[0];
+            Y = s->particles->Position[1][istart+ipart] - coefficients[1];
             array[ipart] = atan2( coefficients[2]*Y - coefficients[3]*X, coefficients[2]*X + coefficients[3]*Y );
         }
     };
@@ -175,15 +200,15 @@ class HistogramAxis_theta2D : public HistogramAxis
 class HistogramAxis_theta3D : public HistogramAxis
 {
     ~HistogramAxis_theta3D() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = ( s->particles->Position[0][ipart] - coefficients[0] ) * coefficients[3]
-                           + ( s->particles->Position[1][ipart] - coefficients[1] ) * coefficients[4]
-                           + ( s->particles->Position[2][ipart] - coefficients[2] ) * coefficients[5];
+            array[ipart] = ( s->particles->Position[0][istart+ipart] - coefficients[0] ) * coefficients[3]
+                           + ( s->particles->Position[1][istart+ipart] - coefficients[1] ) * coefficients[4]
+                           + ( s->particles->Position[2][istart+ipart] - coefficients[2] ) * coefficients[5];
             if( array[ipart]> 1. ) {
                 array[ipart] = 0.;
             } else if( array[ipart]<-1. ) {
@@ -197,7 +222,7 @@ class HistogramAxis_theta3D : public HistogramAxis
 class HistogramAxis_phi : public HistogramAxis
 {
     ~HistogramAxis_phi() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         unsigned int idim;
         double a, b;
@@ -208,8 +233,8 @@ class HistogramAxis_phi : public HistogramAxis
             a = 0.;
             b = 0.;
             for( idim=0; idim<3; idim++ ) {
-                a += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+3];
-                b += ( s->particles->Position[idim][ipart] - coefficients[idim] ) * coefficients[idim+6];
+                a += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+3];
+                b += ( s->particles->Position[idim][istart+ipart] - coefficients[idim] ) * coefficients[idim+6];
             }
             array[ipart] = atan2( b, a );
         }
@@ -218,7 +243,7 @@ class HistogramAxis_phi : public HistogramAxis
 class HistogramAxis_px : public HistogramAxis
 {
     ~HistogramAxis_px() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -226,7 +251,7 @@ class HistogramAxis_px : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Momentum[0][ipart];
+                array[ipart] = s->mass_ * s->particles->Momentum[0][istart+ipart];
             }
         }
         // Photons
@@ -235,7 +260,7 @@ class HistogramAxis_px : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart];
+                array[ipart] = s->particles->Momentum[0][istart+ipart];
             }
         }
     };
@@ -243,7 +268,7 @@ class HistogramAxis_px : public HistogramAxis
 class HistogramAxis_py : public HistogramAxis
 {
     ~HistogramAxis_py() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -251,7 +276,7 @@ class HistogramAxis_py : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Momentum[1][ipart];
+                array[ipart] = s->mass_ * s->particles->Momentum[1][istart+ipart];
             }
         }
         // Photons
@@ -260,7 +285,7 @@ class HistogramAxis_py : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart];
+                array[ipart] = s->particles->Momentum[1][istart+ipart];
             }
         }
     };
@@ -268,7 +293,7 @@ class HistogramAxis_py : public HistogramAxis
 class HistogramAxis_pz : public HistogramAxis
 {
     ~HistogramAxis_pz() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -276,7 +301,7 @@ class HistogramAxis_pz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Momentum[2][ipart];
+                array[ipart] = s->mass_ * s->particles->Momentum[2][istart+ipart];
             }
         }
         // Photons
@@ -285,7 +310,7 @@ class HistogramAxis_pz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart];
+                array[ipart] = s->particles->Momentum[2][istart+ipart];
             }
         }
     };
@@ -293,7 +318,7 @@ class HistogramAxis_pz : public HistogramAxis
 class HistogramAxis_p : public HistogramAxis
 {
     ~HistogramAxis_p() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -301,9 +326,9 @@ class HistogramAxis_p : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                               + pow( s->particles->Momentum[1][ipart], 2 )
-                                               + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                               + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                               + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -312,9 +337,9 @@ class HistogramAxis_p : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -322,7 +347,7 @@ class HistogramAxis_p : public HistogramAxis
 class HistogramAxis_gamma : public HistogramAxis
 {
     ~HistogramAxis_gamma() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -330,9 +355,9 @@ class HistogramAxis_gamma : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -341,9 +366,9 @@ class HistogramAxis_gamma : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -351,7 +376,7 @@ class HistogramAxis_gamma : public HistogramAxis
 class HistogramAxis_ekin : public HistogramAxis
 {
     ~HistogramAxis_ekin() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -359,9 +384,9 @@ class HistogramAxis_ekin : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * ( sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                                 + pow( s->particles->Momentum[1][ipart], 2 )
-                                                 + pow( s->particles->Momentum[2][ipart], 2 ) ) - 1. );
+                array[ipart] = s->mass_ * ( sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) - 1. );
             }
         }
         // Photons
@@ -370,9 +395,9 @@ class HistogramAxis_ekin : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -380,7 +405,7 @@ class HistogramAxis_ekin : public HistogramAxis
 class HistogramAxis_vx : public HistogramAxis
 {
     ~HistogramAxis_vx() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -388,10 +413,10 @@ class HistogramAxis_vx : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[0][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -400,10 +425,10 @@ class HistogramAxis_vx : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -411,7 +436,7 @@ class HistogramAxis_vx : public HistogramAxis
 class HistogramAxis_vy : public HistogramAxis
 {
     ~HistogramAxis_vy() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -419,10 +444,10 @@ class HistogramAxis_vy : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -431,10 +456,10 @@ class HistogramAxis_vy : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -442,7 +467,7 @@ class HistogramAxis_vy : public HistogramAxis
 class HistogramAxis_vz : public HistogramAxis
 {
     ~HistogramAxis_vz() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -450,10 +475,10 @@ class HistogramAxis_vz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -462,10 +487,10 @@ class HistogramAxis_vz : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -473,22 +498,22 @@ class HistogramAxis_vz : public HistogramAxis
 class HistogramAxis_v : public HistogramAxis
 {
     ~HistogramAxis_v() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = pow( 1. + 1./( pow( s->particles->Momentum[0][ipart], 2 )
-                                          + pow( s->particles->Momentum[1][ipart], 2 )
-                                          + pow( s->particles->Momentum[2][ipart], 2 ) ), -0.5 );
+            array[ipart] = pow( 1. + 1./( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                          + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                          + pow( s->particles->Momentum[2][istart+ipart], 2 ) ), -0.5 );
         }
     };
 };
 class HistogramAxis_vperp2 : public HistogramAxis
 {
     ~HistogramAxis_vperp2() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         // Matter Particles
         if( s->mass_ > 0 ) {
@@ -496,11 +521,11 @@ class HistogramAxis_vperp2 : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = ( pow( s->particles->Momentum[1][ipart], 2 )
-                                 + pow( s->particles->Momentum[2][ipart], 2 )
-                               ) / ( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = ( pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                 + pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               ) / ( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -509,11 +534,11 @@ class HistogramAxis_vperp2 : public HistogramAxis
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = ( pow( s->particles->Momentum[1][ipart], 2 )
-                                 + pow( s->particles->Momentum[2][ipart], 2 )
-                               ) / ( pow( s->particles->Momentum[0][ipart], 2 )
-                                     + pow( s->particles->Momentum[1][ipart], 2 )
-                                     + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = ( pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                 + pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               ) / ( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                     + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -521,26 +546,26 @@ class HistogramAxis_vperp2 : public HistogramAxis
 class HistogramAxis_charge : public HistogramAxis
 {
     ~HistogramAxis_charge() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = ( double ) s->particles->Charge[ipart];
+            array[ipart] = ( double ) s->particles->Charge[istart+ipart];
         }
     };
 };
 class HistogramAxis_chi : public HistogramAxis
 {
     ~HistogramAxis_chi() {};
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Chi[ipart];
+            array[ipart] = s->particles->Chi[istart+ipart];
         }
     };
 };
@@ -559,11 +584,12 @@ public:
         Py_DECREF( function );
     };
 private:
-    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int npart, SimWindow *simWindow )
+    void digitize( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart, SimWindow *simWindow )
     {
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
+            particleData.startAt( istart );
             particleData.resize( npart );
             particleData.set( s->particles );
             // run the function
@@ -591,48 +617,45 @@ private:
 class Histogram_number : public Histogram
 {
     ~Histogram_number() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart];
+            array[ipart] = s->particles->Weight[istart+ipart];
         }
     };
 };
 class Histogram_charge : public Histogram
 {
     ~Histogram_charge() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] );
+            array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] );
         }
     };
 };
 class Histogram_jx : public Histogram
 {
     ~Histogram_jx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -641,11 +664,11 @@ class Histogram_jx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -653,20 +676,19 @@ class Histogram_jx : public Histogram
 class Histogram_jy : public Histogram
 {
     ~Histogram_jy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -675,11 +697,11 @@ class Histogram_jy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -687,20 +709,19 @@ class Histogram_jy : public Histogram
 class Histogram_jz : public Histogram
 {
     ~Histogram_jz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * ( double )( s->particles->Charge[ipart] )
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart] * ( double )( s->particles->Charge[istart+ipart] )
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -709,11 +730,11 @@ class Histogram_jz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -721,19 +742,18 @@ class Histogram_jz : public Histogram
 class Histogram_ekin : public Histogram
 {
     ~Histogram_ekin() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * ( sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                         + pow( s->particles->Momentum[1][ipart], 2 )
-                                         + pow( s->particles->Momentum[2][ipart], 2 ) ) - 1. );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * ( sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) - 1. );
             }
         }
         // Photons
@@ -742,10 +762,10 @@ class Histogram_ekin : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * ( sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                         + pow( s->particles->Momentum[1][ipart], 2 )
-                                         + pow( s->particles->Momentum[2][ipart], 2 ) ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * ( sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                         + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) );
             }
         }
     };
@@ -766,34 +786,32 @@ public:
             }
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
             if( index[ipart]<0 ) {
                 continue;
             }
-            array[ipart] = s->particles->Weight[ipart]
-                           * s->particles->Chi[ipart];
+            array[ipart] = s->particles->Weight[istart+ipart]
+                           * s->particles->Chi[istart+ipart];
         }
     };
 };
 class Histogram_p : public Histogram
 {
     ~Histogram_p() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -802,10 +820,10 @@ class Histogram_p : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -813,16 +831,15 @@ class Histogram_p : public Histogram
 class Histogram_px : public Histogram
 {
     ~Histogram_px() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart] * s->particles->Momentum[0][ipart];
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart] * s->particles->Momentum[0][istart+ipart];
             }
         }
         // Photons
@@ -831,7 +848,7 @@ class Histogram_px : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[0][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[0][istart+ipart];
             }
         }
     };
@@ -839,16 +856,15 @@ class Histogram_px : public Histogram
 class Histogram_py : public Histogram
 {
     ~Histogram_py() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart] * s->particles->Momentum[1][ipart];
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart] * s->particles->Momentum[1][istart+ipart];
             }
         }
         // Photons
@@ -857,7 +873,7 @@ class Histogram_py : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[1][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[1][istart+ipart];
             }
         }
     };
@@ -865,16 +881,15 @@ class Histogram_py : public Histogram
 class Histogram_pz : public Histogram
 {
     ~Histogram_pz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart] * s->particles->Momentum[2][ipart];
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart] * s->particles->Momentum[2][istart+ipart];
             }
         }
         // Photons
@@ -883,7 +898,7 @@ class Histogram_pz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart] * s->particles->Momentum[2][ipart];
+                array[ipart] = s->particles->Weight[istart+ipart] * s->particles->Momentum[2][istart+ipart];
             }
         }
     };
@@ -891,20 +906,19 @@ class Histogram_pz : public Histogram
 class Histogram_pressure_xx : public Histogram
 {
     ~Histogram_pressure_xx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[0][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[0][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -913,11 +927,11 @@ class Histogram_pressure_xx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[0][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[0][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -925,20 +939,19 @@ class Histogram_pressure_xx : public Histogram
 class Histogram_pressure_yy : public Histogram
 {
     ~Histogram_pressure_yy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[1][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[1][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -947,11 +960,11 @@ class Histogram_pressure_yy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[1][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[1][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -959,20 +972,19 @@ class Histogram_pressure_yy : public Histogram
 class Histogram_pressure_zz : public Histogram
 {
     ~Histogram_pressure_zz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[2][ipart], 2 )
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -981,11 +993,11 @@ class Histogram_pressure_zz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * pow( s->particles->Momentum[2][ipart], 2 )
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * pow( s->particles->Momentum[2][istart+ipart], 2 )
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -993,21 +1005,20 @@ class Histogram_pressure_zz : public Histogram
 class Histogram_pressure_xy : public Histogram
 {
     ~Histogram_pressure_xy() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -1016,12 +1027,12 @@ class Histogram_pressure_xy : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[1][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -1029,21 +1040,20 @@ class Histogram_pressure_xy : public Histogram
 class Histogram_pressure_xz : public Histogram
 {
     ~Histogram_pressure_xz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -1052,12 +1062,12 @@ class Histogram_pressure_xz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -1065,21 +1075,20 @@ class Histogram_pressure_xz : public Histogram
 class Histogram_pressure_yz : public Histogram
 {
     ~Histogram_pressure_yz() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
         // Photons
@@ -1088,12 +1097,12 @@ class Histogram_pressure_yz : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[1][ipart]
-                               * s->particles->Momentum[2][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[1][istart+ipart]
+                               * s->particles->Momentum[2][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -1101,20 +1110,19 @@ class Histogram_pressure_yz : public Histogram
 class Histogram_ekin_vx : public Histogram
 {
     ~Histogram_ekin_vx() {};
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         // Matter Particles
         if( s->mass_ > 0 ) {
             for( unsigned int ipart = 0 ; ipart < npart ; ipart++ ) {
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->mass_ * s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               * ( 1. - 1./sqrt( 1. + pow( s->particles->Momentum[0][ipart], 2 )
-                                                 + pow( s->particles->Momentum[1][ipart], 2 )
-                                                 + pow( s->particles->Momentum[2][ipart], 2 ) ) );
+                array[ipart] = s->mass_ * s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               * ( 1. - 1./sqrt( 1. + pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                                 + pow( s->particles->Momentum[2][istart+ipart], 2 ) ) );
             }
         }
         // Photons
@@ -1123,11 +1131,11 @@ class Histogram_ekin_vx : public Histogram
                 if( index[ipart]<0 ) {
                     continue;
                 }
-                array[ipart] = s->particles->Weight[ipart]
-                               * s->particles->Momentum[0][ipart]
-                               / sqrt( pow( s->particles->Momentum[0][ipart], 2 )
-                                       + pow( s->particles->Momentum[1][ipart], 2 )
-                                       + pow( s->particles->Momentum[2][ipart], 2 ) );
+                array[ipart] = s->particles->Weight[istart+ipart]
+                               * s->particles->Momentum[0][istart+ipart]
+                               / sqrt( pow( s->particles->Momentum[0][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[1][istart+ipart], 2 )
+                                       + pow( s->particles->Momentum[2][istart+ipart], 2 ) );
             }
         }
     };
@@ -1147,12 +1155,12 @@ public:
         Py_DECREF( function );
     };
 private:
-    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index )
+    void valuate( Species *s, std::vector<double> &array, std::vector<int> &index, unsigned int istart, unsigned int npart )
     {
-        unsigned int npart = array.size();
         #pragma omp critical
         {
             // Expose particle data as numpy arrays
+            particleData.startAt( istart );
             particleData.resize( npart );
             particleData.set( s->particles );
             // run the function
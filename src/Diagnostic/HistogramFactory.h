@@ -89,6 +89,7 @@ public:
             ParticleData test( params.nDim_particle, deposited_quantity_object, deposited_quantityPrefix, dummy );
             histogram = new Histogram_user_function( deposited_quantity_object );
             histogram->deposited_quantity = "user_function";
+            histogram->calls_python = true;
 #else
             ERROR( deposited_quantityPrefix << " should be a string" );
 #endif
@@ -102,6 +103,9 @@ public:
             HistogramAxis *axis = createAxis( pyAxes[iaxis], params, species, patch, excluded_axes, t.str() );
             
             histogram->axes.push_back( axis );
+            if( axis->type.substr( 0, 13 ) == "user_function" ) {
+                histogram->calls_python = true;
+            }
         }
 
         return histogram;
@@ -0,0 +1,99 @@
+#include "ParticleBinningEngine.h"
+
+#include "Patch.h"
+#include "Species.h"
+
+using namespace std;
+
+ParticleBinningEngine::ParticleBinningEngine()
+{
+    int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    buffers_.resize( nthreads );
+    uses_patch_.resize( nthreads );
+    for( int ithread=0; ithread<nthreads; ithread++ ) {
+        buffers_[ithread].resize( chunk_size );
+    }
+}
+
+
+void ParticleBinningEngine::select( vector<Diagnostic *> &globalDiags, unsigned int nspecies )
+{
+    diags_.resize( 0 );
+    selected_.assign( globalDiags.size(), false );
+    species_diags_.resize( nspecies );
+    for( unsigned int ispec=0; ispec<nspecies; ispec++ ) {
+        species_diags_[ispec].resize( 0 );
+    }
+    
+    for( unsigned int idiag=0; idiag<globalDiags.size(); idiag++ ) {
+        DiagnosticParticleBinningBase *diag = dynamic_cast<DiagnosticParticleBinningBase *>( globalDiags[idiag] );
+        if( diag && diag->theTimeIsNow ) {
+            for( unsigned int ispec=0; ispec<nspecies; ispec++ ) {
+                if( diag->hasSpecies( ispec ) ) {
+                    species_diags_[ispec].push_back( diags_.size() );
+                }
+            }
+            diags_.push_back( diag );
+            selected_[idiag] = true;
+        }
+    }
+}
+
+
+void ParticleBinningEngine::run( Patch *patch, SimWindow *simWindow )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    HistogramBuffers &buffers = buffers_[ithread];
+    vector<bool> &uses_patch = uses_patch_[ithread];
+    
+    uses_patch.resize( diags_.size() );
+    for( unsigned int idiag=0; idiag<diags_.size(); idiag++ ) {
+        uses_patch[idiag] = diags_[idiag]->usesPatch( patch );
+    }
+    
+    // Each chunk of particles is binned by all the diagnostics of its species
+    for( unsigned int ispec=0; ispec<species_diags_.size(); ispec++ ) {
+        vector<unsigned int> &diags = species_diags_[ispec];
+        if( diags.empty() ) {
+            continue;
+        }
+        Species *s = patch->vecSpecies[ispec];
+        unsigned int npart = s->particles->size();
+        // Diagnostics calling python functions bin all the particles at once, as in their own run()
+        bool chunked = false;
+        for( unsigned int i=0; i<diags.size(); i++ ) {
+            if( ! uses_patch[diags[i]] ) {
+                continue;
+            }
+            if( diags_[diags[i]]->binsWholeSpecies() ) {
+                buffers.resize( npart );
+                diags_[diags[i]]->binParticles( s, 0, npart, buffers, simWindow );
+            } else {
+                chunked = true;
+            }
+        }
+        if( ! chunked ) {
+            continue;
+        }
+        for( unsigned int istart=0; istart<npart; istart+=chunk_size ) {
+            unsigned int n = min( npart-istart, ( unsigned int ) chunk_size );
+            for( unsigned int i=0; i<diags.size(); i++ ) {
+                if( uses_patch[diags[i]] && ! diags_[diags[i]]->binsWholeSpecies() ) {
+                    diags_[diags[i]]->binParticles( s, istart, n, buffers, simWindow );
+                }
+            }
+        }
+    }
+    
+    for( unsigned int idiag=0; idiag<diags_.size(); idiag++ ) {
+        if( uses_patch[idiag] ) {
+            diags_[idiag]->endPatch();
+        }
+    }
+}
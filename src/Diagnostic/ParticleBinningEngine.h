@@ -0,0 +1,59 @@
+#ifndef PARTICLEBINNINGENGINE_H
+#define PARTICLEBINNINGENGINE_H
+
+#include <vector>
+
+#include "DiagnosticParticleBinningBase.h"
+
+class Patch;
+class SimWindow;
+
+//! Runs together all the particle binning diagnostics (ParticleBinning, Screen, RadiationSpectrum)
+//! due at the same timestep: the particles of each species are swept once, by chunks which
+//! stay in cache while they are binned by all the diagnostics using this species.
+class ParticleBinningEngine
+{
+public:
+    ParticleBinningEngine();
+    ~ParticleBinningEngine() {};
+    
+    //! Selects the particle binning diagnostics due at this timestep (called by one thread,
+    //! after the diagnostics prepare) and groups them by species
+    void select( std::vector<Diagnostic *> &globalDiags, unsigned int nspecies );
+    
+    //! Bins the particles of one patch in all the selected diagnostics
+    void run( Patch *patch, SimWindow *simWindow );
+    
+    //! True if the diagnostic globalDiags[idiag] has been selected
+    inline bool isSelected( unsigned int idiag )
+    {
+        return idiag < selected_.size() && selected_[idiag];
+    }
+    
+    //! Number of selected diagnostics
+    inline unsigned int size()
+    {
+        return diags_.size();
+    }
+    
+    //! Number of particles binned together by all the diagnostics
+    static const unsigned int chunk_size = 1024;
+
+private:
+    //! Selected diagnostics
+    std::vector<DiagnosticParticleBinningBase *> diags_;
+    
+    //! Flags of the global diagnostics selected
+    std::vector<bool> selected_;
+    
+    //! For each species, indices (in diags_) of the diagnostics binning this species
+    std::vector<std::vector<unsigned int> > species_diags_;
+    
+    //! Buffers of each thread
+    std::vector<HistogramBuffers> buffers_;
+    
+    //! Flags of the diagnostics which use the current patch, for each thread
+    std::vector<std::vector<bool> > uses_patch_;
+};
+
+#endif
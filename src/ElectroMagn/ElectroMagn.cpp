@@ -7,6 +7,9 @@
 #include "Species.h"
 #include "Projector.h"
 #include "Field.h"
+#include "Field1D.h"
+#include "Field2D.h"
+#include "Field3D.h"
 #include "ElectroMagnBC.h"
 #include "ElectroMagnBC_Factory.h"
 #include "SimWindow.h"
@@ -89,6 +92,7 @@ ElectroMagn::ElectroMagn( Params &params, DomainDecomposition *domain_decomposit
     emBoundCond = ElectroMagnBC_Factory::create( params, patch );
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellFusedSolver_   = SolverFactory::createFused( params );
     
     envelope = NULL;
     
@@ -147,6 +151,7 @@ ElectroMagn::ElectroMagn( ElectroMagn *emFields, Params &params, Patch *patch )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA( params );
     MaxwellFaradaySolver_ = SolverFactory::createMF( params );
+    MaxwellFusedSolver_   = SolverFactory::createFused( params );
     
     envelope = NULL;
 }
@@ -356,6 +361,9 @@ ElectroMagn::~ElectroMagn()
         
     delete MaxwellAmpereSolver_;
     delete MaxwellFaradaySolver_;
+    if( MaxwellFusedSolver_ ) {
+        delete MaxwellFusedSolver_;
+    }
     
     if( envelope != NULL ) {
         delete envelope;
@@ -367,6 +375,13 @@ ElectroMagn::~ElectroMagn()
         antenna->field=NULL;
     }
 
+    for( unsigned int iExt = 0 ; iExt < extTimeFields.size() ; iExt++ ) {
+        delete extTimeFields[iExt].savedField;
+        if( extTimeFields[iExt].space_values ) {
+            delete extTimeFields[iExt].space_values;
+        }
+    }
+    
 //     for ( unsigned int iExt = 0 ; iExt < extTimeFields.size() ; iExt++ ) {
 //     	delete extTimeFields[iExt].savedField;
 //     	#pragma omp single
@@ -553,8 +568,34 @@ void ElectroMagn::applyPrescribedFields( Patch *patch, double time )
 {
     for( vector<ExtTimeField>::iterator extfield=extTimeFields.begin(); extfield!=extTimeFields.end(); extfield++ ) {
         if( extfield->index < allFields.size() ) {
-            extfield->savedField->copyFrom(allFields[extfield->index]);
-            applyPrescribedField( allFields[extfield->index], extfield->profile, patch, time );
+            Field *field = allFields[extfield->index];
+            extfield->savedField->copyFrom( field );
+            if( ! extfield->time_profile ) {
+                applyPrescribedField( field, extfield->profile, patch, time );
+                continue;
+            }
+            // Separable profile: the space part is evaluated once, only the time part at each step
+            if( ! extfield->space_values ) {
+                if( nDim_field == 1 ) {
+                    extfield->space_values = new Field1D( field->dims() );
+                } else if( nDim_field == 2 ) {
+                    extfield->space_values = new Field2D( field->dims() );
+                } else {
+                    extfield->space_values = new Field3D( field->dims() );
+                }
+                extfield->space_values->isDual_ = field->isDual_;
+                extfield->space_values->name = field->name;
+                extfield->space_values->put_to( 0. );
+                applyExternalField( extfield->space_values, extfield->profile, patch );
+            }
+            double g = extfield->time_profile->valueAt( time );
+            double *f = field->data();
+            double *s = extfield->space_values->data();
+            unsigned int size = field->globalDims_;
+            #pragma omp simd
+            for( unsigned int i=0 ; i<size ; i++ ) {
+                f[i] += g * s[i];
+            }
         }
     }
 }
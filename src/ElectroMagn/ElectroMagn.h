@@ -48,8 +48,15 @@ struct ExtTimeField {
    
     Profile *profile;
     
+    //! time part of a separable prescribed field (NULL if not separable)
+    //! in that case, `profile` only holds the space part
+    Profile *time_profile;
+    
     Field *savedField;
     
+    //! space part of a separable prescribed field, evaluated on the patch at the first use
+    Field *space_values;
+    
     unsigned int index;
 };
 
@@ -274,6 +281,10 @@ public:
     virtual double compute_pAp() = 0;
     virtual void update_pand_r( double r_dot_r, double p_dot_Ap ) = 0;
     virtual void update_p( double rnew_dot_rnew, double r_dot_r ) = 0;
+    //! Preconditioner: symmetric Gauss-Seidel sweeps on A z = r, on the nodes of the patch only (z stored in Ap_)
+    virtual void compute_z( unsigned int sweeps ) = 0;
+    virtual double compute_rz() = 0;
+    virtual void update_p_from_z( double rnew_dot_znew, double r_dot_z ) = 0;
     virtual void initE( Patch *patch ) = 0;
     virtual void initE_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
     virtual void initB_relativistic_Poisson( Patch *patch, double gamma_mean ) = 0;
@@ -318,6 +329,8 @@ public:
     Solver *MaxwellAmpereSolver_;
     //! Maxwell Faraday Solver
     Solver *MaxwellFaradaySolver_;
+    //! Fused Maxwell Solver (saving B, Maxwell-Ampere and Maxwell-Faraday), NULL if not used
+    Solver *MaxwellFusedSolver_;
     virtual void saveMagneticFields( bool ) = 0;
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter(unsigned int ipass, std::vector<unsigned int> passes ) = 0;
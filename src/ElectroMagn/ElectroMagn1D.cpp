@@ -341,6 +341,47 @@ void ElectroMagn1D::update_p( double rnew_dot_rnew, double r_dot_r )
     }
 } // update_p
 
+void ElectroMagn1D::compute_z( unsigned int sweeps )
+{
+    double one_ov_dx_sq = 1.0/( dx*dx );
+    double inv_diag     = -0.5*dx*dx;
+    unsigned int imin = index_min_p_[0];
+    unsigned int imax = index_max_p_[0];
+    
+    // Block symmetric Gauss-Seidel: z = 0 out of the nodes of the patch
+    Ap_->put_to( 0. );
+    for( unsigned int isweep=0 ; isweep<sweeps ; isweep++ ) {
+        // Forward then backward sweeps, so that the preconditioner is symmetric
+        for( unsigned int i=imin ; i<=imax ; i++ ) {
+            double z_left  = i>imin ? ( *Ap_ )( i-1 ) : 0.;
+            double z_right = i<imax ? ( *Ap_ )( i+1 ) : 0.;
+            ( *Ap_ )( i ) = ( ( *r_ )( i ) - one_ov_dx_sq*( z_left + z_right ) ) * inv_diag;
+        }
+        for( unsigned int i=imax+1 ; i-- > imin ; ) {
+            double z_left  = i>imin ? ( *Ap_ )( i-1 ) : 0.;
+            double z_right = i<imax ? ( *Ap_ )( i+1 ) : 0.;
+            ( *Ap_ )( i ) = ( ( *r_ )( i ) - one_ov_dx_sq*( z_left + z_right ) ) * inv_diag;
+        }
+    }
+} // compute_z
+
+double ElectroMagn1D::compute_rz()
+{
+    double r_dot_z_local( 0. );
+    for( unsigned int i=index_min_p_[0] ; i<=index_max_p_[0] ; i++ ) {
+        r_dot_z_local += ( *r_ )( i )*( *Ap_ )( i );
+    }
+    return r_dot_z_local;
+} // compute_rz
+
+void ElectroMagn1D::update_p_from_z( double rnew_dot_znew, double r_dot_z )
+{
+    double beta_k = rnew_dot_znew/r_dot_z;
+    for( unsigned int i=0 ; i<dimPrim[0] ; i++ ) {
+        ( *p_ )( i ) = ( *Ap_ )( i ) + beta_k * ( *p_ )( i );
+    }
+} // update_p_from_z
+
 void ElectroMagn1D::initE( Patch *patch )
 {
     Field1D *Ex1D  = static_cast<Field1D *>( Ex_ );
@@ -774,11 +815,23 @@ void ElectroMagn1D::applyExternalField( Field *my_field,  Profile *profile, Patc
     int N = ( int )field1D->dims()[0];
     
     // USING UNSIGNED INT CREATES PB WITH PERIODIC BCs
+    // Create the x map where profiles will be evaluated
+    vector<Field *> x( 1 );
+    vector<unsigned int> n_space_to_create( 1, N );
+    x[0] = new Field1D( n_space_to_create );
+    Field1D values( n_space_to_create );
     for( int i=0 ; i<N ; i++ ) {
-        ( *field1D )( i ) += profile->valueAt( pos );
+        ( *x[0] )( i ) = pos[0];
         pos[0] += dx;
     }
     
+    profile->valuesAt( x, values );
+    for( int i=0 ; i<N ; i++ ) {
+        ( *field1D )( i ) += values( i );
+    }
+    
+    delete x[0];
+    
 }
 
 void ElectroMagn1D::applyPrescribedField( Field *my_field,  Profile *profile, Patch *patch, double time )
@@ -790,11 +843,23 @@ void ElectroMagn1D::applyPrescribedField( Field *my_field,  Profile *profile, Pa
     int N = ( int )field1D->dims()[0];
     
     // USING UNSIGNED INT CREATES PB WITH PERIODIC BCs
+    // Create the x map where profiles will be evaluated
+    vector<Field *> x( 1 );
+    vector<unsigned int> n_space_to_create( 1, N );
+    x[0] = new Field1D( n_space_to_create );
+    Field1D values( n_space_to_create );
     for( int i=0 ; i<N ; i++ ) {
-        ( *field1D )( i ) += profile->valueAt( pos, time ); 
+        ( *x[0] )( i ) = pos[0];
         pos[0] += dx;
     }
     
+    profile->valuesAtTime( x, time, values );
+    for( int i=0 ; i<N ; i++ ) {
+        ( *field1D )( i ) += values( i );
+    }
+    
+    delete x[0];
+    
 }
 
 
@@ -29,6 +29,9 @@ public:
     double compute_pAp();
     void update_pand_r( double r_dot_r, double p_dot_Ap );
     void update_p( double rnew_dot_rnew, double r_dot_r );
+    void compute_z( unsigned int sweeps ) override;
+    double compute_rz() override;
+    void update_p_from_z( double rnew_dot_znew, double r_dot_z ) override;
     void initE( Patch *patch );
     void initE_relativistic_Poisson( Patch *patch, double gamma_mean );
     void initB_relativistic_Poisson( Patch *patch, double gamma_mean );
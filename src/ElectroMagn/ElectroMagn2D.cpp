@@ -474,6 +474,59 @@ void ElectroMagn2D::update_p( double rnew_dot_rnew, double r_dot_r )
     }
 } // update_p
 
+void ElectroMagn2D::compute_z( unsigned int sweeps )
+{
+    double one_ov_dx_sq = 1.0/( dx*dx );
+    double one_ov_dy_sq = 1.0/( dy*dy );
+    double inv_diag     = -1.0/( 2.0*( one_ov_dx_sq+one_ov_dy_sq ) );
+    unsigned int imin = index_min_p_[0];
+    unsigned int imax = index_max_p_[0];
+    unsigned int jmin = index_min_p_[1];
+    unsigned int jmax = index_max_p_[1];
+    
+    // Block symmetric Gauss-Seidel: z = 0 out of the nodes of the patch
+    // (along y, the nodes out of the patch are ghost cells, always available)
+    Ap_->put_to( 0. );
+    for( unsigned int isweep=0 ; isweep<sweeps ; isweep++ ) {
+        // Forward then backward sweeps, so that the preconditioner is symmetric
+        for( unsigned int i=imin ; i<=imax ; i++ ) {
+            for( unsigned int j=jmin ; j<=jmax ; j++ ) {
+                double z_x = ( i>imin ? ( *Ap_ )( i-1, j ) : 0. ) + ( i<imax ? ( *Ap_ )( i+1, j ) : 0. );
+                double z_y = ( *Ap_ )( i, j-1 ) + ( *Ap_ )( i, j+1 );
+                ( *Ap_ )( i, j ) = ( ( *r_ )( i, j ) - one_ov_dx_sq*z_x - one_ov_dy_sq*z_y ) * inv_diag;
+            }
+        }
+        for( unsigned int i=imax+1 ; i-- > imin ; ) {
+            for( unsigned int j=jmax+1 ; j-- > jmin ; ) {
+                double z_x = ( i>imin ? ( *Ap_ )( i-1, j ) : 0. ) + ( i<imax ? ( *Ap_ )( i+1, j ) : 0. );
+                double z_y = ( *Ap_ )( i, j-1 ) + ( *Ap_ )( i, j+1 );
+                ( *Ap_ )( i, j ) = ( ( *r_ )( i, j ) - one_ov_dx_sq*z_x - one_ov_dy_sq*z_y ) * inv_diag;
+            }
+        }
+    }
+} // compute_z
+
+double ElectroMagn2D::compute_rz()
+{
+    double r_dot_z_local( 0. );
+    for( unsigned int i=index_min_p_[0]; i<=index_max_p_[0]; i++ ) {
+        for( unsigned int j=index_min_p_[1]; j<=index_max_p_[1]; j++ ) {
+            r_dot_z_local += ( *r_ )( i, j )*( *Ap_ )( i, j );
+        }
+    }
+    return r_dot_z_local;
+} // compute_rz
+
+void ElectroMagn2D::update_p_from_z( double rnew_dot_znew, double r_dot_z )
+{
+    double beta_k = rnew_dot_znew/r_dot_z;
+    for( unsigned int i=0; i<nx_p; i++ ) {
+        for( unsigned int j=0; j<ny_p; j++ ) {
+            ( *p_ )( i, j ) = ( *Ap_ )( i, j ) + beta_k * ( *p_ )( i, j );
+        }
+    }
+} // update_p_from_z
+
 void ElectroMagn2D::initE( Patch *patch )
 {
     Field2D *Ex2D  = static_cast<Field2D *>( Ex_ );
@@ -1354,15 +1407,39 @@ void ElectroMagn2D::applyExternalField( Field *my_field,  Profile *profile, Patc
     int N1 = ( int )field2D->dims()[1];
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
+    // Create the x,y maps where profiles will be evaluated
+    vector<Field *> xy( 2 );
+    vector<unsigned int> n_space_to_create( 2 );
+    n_space_to_create[0] = N0;
+    n_space_to_create[1] = N1;
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        xy[idim] = new Field2D( n_space_to_create );
+    }
+    Field2D values( n_space_to_create );
+    
     for( int i=0 ; i<N0 ; i++ ) {
         pos[1] = pos1;
         for( int j=0 ; j<N1 ; j++ ) {
-            ( *field2D )( i, j ) += profile->valueAt( pos );
+            for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+                ( *xy[idim] )( i, j ) = pos[idim];
+            }
             pos[1] += dy;
         }
         pos[0] += dx;
     }
     
+    profile->valuesAt( xy, values );
+    for( int i=0 ; i<N0 ; i++ ) {
+        for( int j=0 ; j<N1 ; j++ ) {
+            ( *field2D )( i, j ) += values( i, j );
+        }
+    }
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        delete xy[idim];
+    }
+    
 }
 
 void ElectroMagn2D::applyPrescribedField( Field *my_field,  Profile *profile, Patch *patch, double time )
@@ -1377,15 +1454,39 @@ void ElectroMagn2D::applyPrescribedField( Field *my_field,  Profile *profile, Pa
     int N1 = ( int )field2D->dims()[1];
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
+    // Create the x,y maps where profiles will be evaluated
+    vector<Field *> xy( 2 );
+    vector<unsigned int> n_space_to_create( 2 );
+    n_space_to_create[0] = N0;
+    n_space_to_create[1] = N1;
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        xy[idim] = new Field2D( n_space_to_create );
+    }
+    Field2D values( n_space_to_create );
+    
     for( int i=0 ; i<N0 ; i++ ) {
         pos[1] = pos1;
         for( int j=0 ; j<N1 ; j++ ) {
-            ( *field2D )( i, j ) += profile->valueAt( pos, time );
+            for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+                ( *xy[idim] )( i, j ) = pos[idim];
+            }
             pos[1] += dy;
         }
         pos[0] += dx;
     }
     
+    profile->valuesAtTime( xy, time, values );
+    for( int i=0 ; i<N0 ; i++ ) {
+        for( int j=0 ; j<N1 ; j++ ) {
+            ( *field2D )( i, j ) += values( i, j );
+        }
+    }
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        delete xy[idim];
+    }
+    
 }
 
 
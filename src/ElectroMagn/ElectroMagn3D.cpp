@@ -531,6 +531,72 @@ void ElectroMagn3D::update_p( double rnew_dot_rnew, double r_dot_r )
     }
 } // update_p
 
+void ElectroMagn3D::compute_z( unsigned int sweeps )
+{
+    double one_ov_dx_sq = 1.0/( dx*dx );
+    double one_ov_dy_sq = 1.0/( dy*dy );
+    double one_ov_dz_sq = 1.0/( dz*dz );
+    double inv_diag     = -1.0/( 2.0*( one_ov_dx_sq+one_ov_dy_sq+one_ov_dz_sq ) );
+    unsigned int imin = index_min_p_[0];
+    unsigned int imax = index_max_p_[0];
+    unsigned int jmin = index_min_p_[1];
+    unsigned int jmax = index_max_p_[1];
+    unsigned int kmin = index_min_p_[2];
+    unsigned int kmax = index_max_p_[2];
+    
+    // Block symmetric Gauss-Seidel: z = 0 out of the nodes of the patch
+    // (along y and z, the nodes out of the patch are ghost cells, always available)
+    Ap_->put_to( 0. );
+    for( unsigned int isweep=0 ; isweep<sweeps ; isweep++ ) {
+        // Forward then backward sweeps, so that the preconditioner is symmetric
+        for( unsigned int i=imin ; i<=imax ; i++ ) {
+            for( unsigned int j=jmin ; j<=jmax ; j++ ) {
+                for( unsigned int k=kmin ; k<=kmax ; k++ ) {
+                    double z_x = ( i>imin ? ( *Ap_ )( i-1, j, k ) : 0. ) + ( i<imax ? ( *Ap_ )( i+1, j, k ) : 0. );
+                    double z_y = ( *Ap_ )( i, j-1, k ) + ( *Ap_ )( i, j+1, k );
+                    double z_z = ( *Ap_ )( i, j, k-1 ) + ( *Ap_ )( i, j, k+1 );
+                    ( *Ap_ )( i, j, k ) = ( ( *r_ )( i, j, k ) - one_ov_dx_sq*z_x - one_ov_dy_sq*z_y - one_ov_dz_sq*z_z ) * inv_diag;
+                }
+            }
+        }
+        for( unsigned int i=imax+1 ; i-- > imin ; ) {
+            for( unsigned int j=jmax+1 ; j-- > jmin ; ) {
+                for( unsigned int k=kmax+1 ; k-- > kmin ; ) {
+                    double z_x = ( i>imin ? ( *Ap_ )( i-1, j, k ) : 0. ) + ( i<imax ? ( *Ap_ )( i+1, j, k ) : 0. );
+                    double z_y = ( *Ap_ )( i, j-1, k ) + ( *Ap_ )( i, j+1, k );
+                    double z_z = ( *Ap_ )( i, j, k-1 ) + ( *Ap_ )( i, j, k+1 );
+                    ( *Ap_ )( i, j, k ) = ( ( *r_ )( i, j, k ) - one_ov_dx_sq*z_x - one_ov_dy_sq*z_y - one_ov_dz_sq*z_z ) * inv_diag;
+                }
+            }
+        }
+    }
+} // compute_z
+
+double ElectroMagn3D::compute_rz()
+{
+    double r_dot_z_local( 0. );
+    for( unsigned int i=index_min_p_[0]; i<=index_max_p_[0]; i++ ) {
+        for( unsigned int j=index_min_p_[1]; j<=index_max_p_[1]; j++ ) {
+            for( unsigned int k=index_min_p_[2]; k<=index_max_p_[2]; k++ ) {
+                r_dot_z_local += ( *r_ )( i, j, k )*( *Ap_ )( i, j, k );
+            }
+        }
+    }
+    return r_dot_z_local;
+} // compute_rz
+
+void ElectroMagn3D::update_p_from_z( double rnew_dot_znew, double r_dot_z )
+{
+    double beta_k = rnew_dot_znew/r_dot_z;
+    for( unsigned int i=0; i<nx_p; i++ ) {
+        for( unsigned int j=0; j<ny_p; j++ ) {
+            for( unsigned int k=0; k<nz_p; k++ ) {
+                ( *p_ )( i, j, k ) = ( *Ap_ )( i, j, k ) + beta_k * ( *p_ )( i, j, k );
+            }
+        }
+    }
+} // update_p_from_z
+
 void ElectroMagn3D::initE( Patch *patch )
 {
     Field3D *Ex3D  = static_cast<Field3D *>( Ex_ );
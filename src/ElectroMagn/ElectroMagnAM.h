@@ -59,6 +59,9 @@ public:
     void update_pand_r( double r_dot_r, double p_dot_Ap ) override {;};
     void update_p( double rnew_dot_rnew, double r_dot_r );
     void update_pand_r_AM( double r_dot_r, std::complex<double> p_dot_Ap );
+    void compute_z( unsigned int sweeps ) override {;};
+    double compute_rz() override {return 0.;};
+    void update_p_from_z( double rnew_dot_znew, double r_dot_z ) override {;};
     void initE( Patch *patch ) override;
     void delete_phi_r_p_Ap( Patch *patch );
     void delete_relativistic_fields( Patch *patch );
@@ -113,13 +113,29 @@ public:
             PyObject *profile;
             std::string fieldName("");
             PyTools::extract( "field", fieldName, "PrescribedField", n_extfield );
-            // Now import the profile
+            // Now import the profile, or the space and time profiles of a separable field
             std::ostringstream name( "" );
             name << "PrescribedField[" << n_extfield <<"].profile";
-            if( !PyTools::extract_pyProfile( "profile", profile, "PrescribedField", n_extfield ) ) {
-                ERROR( "PrescribedField #"<<n_extfield<<": parameter 'profile' not understood" );
+            extField.time_profile = NULL;
+            extField.space_values = NULL;
+            if( PyTools::extract_pyProfile( "profile", profile, "PrescribedField", n_extfield ) ) {
+                extField.profile = new Profile( profile, params.nDim_field+1, name.str(), true );
+            } else {
+                PyObject *time_profile;
+                if( !PyTools::extract_pyProfile( "space_profile", profile, "PrescribedField", n_extfield )
+                    || !PyTools::extract_pyProfile( "time_profile", time_profile, "PrescribedField", n_extfield ) ) {
+                    ERROR( "PrescribedField #"<<n_extfield<<": requires either 'profile', or both 'space_profile' and 'time_profile'" );
+                }
+                if( params.geometry == "AMcylindrical" ) {
+                    ERROR( "PrescribedField #"<<n_extfield<<": 'space_profile' and 'time_profile' not available in AM geometry" );
+                }
+                name.str( "" );
+                name << "PrescribedField[" << n_extfield <<"].space_profile";
+                extField.profile = new Profile( profile, params.nDim_field, name.str(), true );
+                name.str( "" );
+                name << "PrescribedField[" << n_extfield <<"].time_profile";
+                extField.time_profile = new Profile( time_profile, 1, name.str() );
             }
-            extField.profile = new Profile( profile, params.nDim_field+1, name.str(), true );
             // Find which index the field is in the allFields vector
             extField.index = 1000;
             for( unsigned int ifield=0; ifield<EMfields->allFields.size(); ifield++ ) {
@@ -144,6 +160,9 @@ public:
             }
             
             MESSAGE(1, "Prescribed field " << fieldName << ": " << extField.profile->getInfo());
+            if( extField.time_profile ) {
+                MESSAGE(2, "with time profile: " << extField.time_profile->getInfo());
+            }
             EMfields->extTimeFields.push_back( extField );
         }
         
@@ -235,12 +254,17 @@ public:
         // -----------------
         // Clone time-average fields
         // -----------------
+        // In cartesian geometries, they are compact 1D accumulators (see DiagnosticFields)
         newEMfields->allFields_avg.resize( EMfields->allFields_avg.size() );
         for( unsigned int idiag=0; idiag<EMfields->allFields_avg.size(); idiag++ ) {
-            for( unsigned int ifield=0; ifield<EMfields->allFields_avg[idiag].size(); ifield++ )
-                newEMfields->allFields_avg[idiag].push_back(
-                                                            newEMfields->createField( EMfields->allFields_avg[idiag][ifield]->name, params )
-                );
+            for( unsigned int ifield=0; ifield<EMfields->allFields_avg[idiag].size(); ifield++ ) {
+                Field *avg = EMfields->allFields_avg[idiag][ifield];
+                if( params.geometry != "AMcylindrical" ) {
+                    newEMfields->allFields_avg[idiag].push_back( new Field1D( avg->dims_, avg->name ) );
+                } else {
+                    newEMfields->allFields_avg[idiag].push_back( newEMfields->createField( avg->name, params ) );
+                }
+            }
         }
         
         // -----------------
@@ -286,9 +310,20 @@ public:
         // -----------------
         for( unsigned int n_extfield = 0; n_extfield < EMfields->extTimeFields.size(); n_extfield++ ) {
             ExtTimeField extField;
-            extField.savedField   = EMfields->extTimeFields[n_extfield].savedField;
-            extField.profile = EMfields->extTimeFields[n_extfield].profile;
-            extField.index   = EMfields->extTimeFields[n_extfield].index;
+            extField.profile      = EMfields->extTimeFields[n_extfield].profile;
+            extField.time_profile = EMfields->extTimeFields[n_extfield].time_profile;
+            extField.index        = EMfields->extTimeFields[n_extfield].index;
+            extField.space_values = NULL;
+            // Each patch saves its own field (filled when the prescribed field is applied)
+            Field *field = newEMfields->allFields[extField.index];
+            if( params.nDim_field == 1 ) {
+                extField.savedField = new Field1D( field->dims() );
+            } else if( params.nDim_field == 2 ) {
+                extField.savedField = new Field2D( field->dims() );
+            } else {
+                extField.savedField = new Field3D( field->dims() );
+            }
+            extField.savedField->name = field->name;
             newEMfields->extTimeFields.push_back( extField );
         }
         
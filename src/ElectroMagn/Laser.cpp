@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <string>
+#include <limits>
 
 using namespace std;
 
@@ -264,6 +265,11 @@ LaserProfileSeparable::LaserProfileSeparable(
 {
     space_envelope = NULL;
     phase = NULL;
+    amplitude_ = NULL;
+    delayed_time_ = NULL;
+    time_envelope_ = NULL;
+    amplitude_time_ = numeric_limits<double>::quiet_NaN();
+    uniform_phase_ = false;
 }
 // Separable laser profile cloning constructor
 LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
@@ -277,6 +283,11 @@ LaserProfileSeparable::LaserProfileSeparable( LaserProfileSeparable *lp ) :
 {
     space_envelope = NULL;
     phase = NULL;
+    amplitude_ = NULL;
+    delayed_time_ = NULL;
+    time_envelope_ = NULL;
+    amplitude_time_ = numeric_limits<double>::quiet_NaN();
+    uniform_phase_ = false;
 }
 // Separable laser profile destructor
 LaserProfileSeparable::~LaserProfileSeparable()
@@ -300,6 +311,11 @@ LaserProfileSeparable::~LaserProfileSeparable()
     if( phase ) {
         delete phase;
     }
+    if( amplitude_ ) {
+        delete amplitude_;
+        delete delayed_time_;
+        delete time_envelope_;
+    }
 }
 
 
@@ -374,13 +390,16 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[0] = primal_ ? ny_p : ny_d;
 
         // Assign profile
-        vector<double> pos( 1 );
-        pos[0] = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
+        vector<Field *> pos( 1 );
+        pos[0] = new Field2D( space_envelope->dims() );
+        double y = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
-            ( *space_envelope )( j, 0 ) = spaceProfile_->valueAt( pos );
-            ( *phase )( j, 0 ) = phaseProfile_->valueAt( pos );
-            pos[0] += dy;
+            ( *pos[0] )( j, 0 ) = y;
+            y += dy;
         }
+        spaceProfile_->valuesAt( pos, *space_envelope );
+        phaseProfile_->valuesAt( pos, *phase );
+        delete pos[0];
 
     } else if( params.geometry=="AMcylindrical" ) {
     
@@ -391,12 +410,14 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[0] = nr_p + nr_d; // Need to account for both primal and dual positions
 
         // Assign profile
-        vector<double> pos( 1 );
+        vector<Field *> pos( 1 );
+        pos[0] = new Field2D( space_envelope->dims() );
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
-            pos[0] = patch->getDomainLocalMin( 1 ) + ( j*0.5 - 0.5 - oversize[1] )*dr ; // Increment half cells
-            ( *space_envelope )( j, 0 ) = spaceProfile_->valueAt( pos );
-            ( *phase )( j, 0 ) = phaseProfile_->valueAt( pos );
+            ( *pos[0] )( j, 0 ) = patch->getDomainLocalMin( 1 ) + ( j*0.5 - 0.5 - oversize[1] )*dr ; // Increment half cells
         }
+        spaceProfile_->valuesAt( pos, *space_envelope );
+        phaseProfile_->valuesAt( pos, *phase );
+        delete pos[0];
 
     } else if( params.geometry=="3Dcartesian" ) {
         unsigned int ny_p = n_space[1]+1+2*oversize[1];
@@ -410,31 +431,97 @@ void LaserProfileSeparable::initFields( Params &params, Patch *patch )
         dim[1] = primal_ ? nz_d : nz_p;
 
         // Assign profile
-        vector<double> pos( 2 );
-        pos[0] = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
+        vector<Field *> pos( 2 );
+        pos[0] = new Field2D( space_envelope->dims() );
+        pos[1] = new Field2D( space_envelope->dims() );
+        double y = patch->getDomainLocalMin( 1 ) - ( ( primal_?0.:0.5 ) + oversize[1] )*dy;
         for( unsigned int j=0 ; j<dim[0] ; j++ ) {
-            pos[1] = patch->getDomainLocalMin( 2 ) - ( ( primal_?0.5:0. ) + oversize[2] )*dz;
+            double z = patch->getDomainLocalMin( 2 ) - ( ( primal_?0.5:0. ) + oversize[2] )*dz;
             for( unsigned int k=0 ; k<dim[1] ; k++ ) {
-                ( *space_envelope )( j, k ) = spaceProfile_->valueAt( pos );
-                ( *phase )( j, k ) = phaseProfile_->valueAt( pos );
-                pos[1] += dz;
+                ( *pos[0] )( j, k ) = y;
+                ( *pos[1] )( j, k ) = z;
+                z += dz;
             }
-            pos[0] += dy;
+            y += dy;
         }
+        spaceProfile_->valuesAt( pos, *space_envelope );
+        phaseProfile_->valuesAt( pos, *phase );
+        delete pos[0];
+        delete pos[1];
+    }
+    
+    // The amplitudes must be computed again
+    amplitude_time_ = numeric_limits<double>::quiet_NaN();
+    if( amplitude_ ) {
+        delete amplitude_;
+        delete delayed_time_;
+        delete time_envelope_;
+        amplitude_ = NULL;
     }
 }
 
 // Amplitude of a separable laser profile
-double LaserProfileSeparable::getAmplitude( std::vector<double> pos, double t, int j, int k )
+// All the points are computed at once when a new time is requested
+double LaserProfileSeparable::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
+{
+    if( t != amplitude_time_ ) {
+        computeAmplitudes( t );
+    }
+    return ( *amplitude_ )( j, k );
+}
+
+void LaserProfileSeparable::computeAmplitudes( double t )
 {
-    double amp;
+    // Buffers allocated at the first call (the laser fields may have been received from another process)
+    if( ! amplitude_ ) {
+        amplitude_     = new Field2D( space_envelope->dims() );
+        delayed_time_  = new Field2D( space_envelope->dims() );
+        time_envelope_ = new Field2D( space_envelope->dims() );
+        uniform_phase_ = true;
+        for( unsigned int i=1; i<phase->globalDims_; i++ ) {
+            if( phase->data_[i] != phase->data_[0] ) {
+                uniform_phase_ = false;
+                break;
+            }
+        }
+    }
+    
+    unsigned int n = space_envelope->globalDims_;
+    double *phi            = phase->data_;
+    double *space          = space_envelope->data_;
+    double *delayed_time   = delayed_time_->data_;
+    double *time_envelope  = time_envelope_->data_;
+    double *amplitude      = amplitude_->data_;
+    
+    // The chirp only depends on time, and the time envelope on the phase
+    double omega;
     #pragma omp critical
     {
-        double omega = omega_ * chirpProfile_->valueAt( t );
-        double phi = ( *phase )( j, k );
-        amp = timeProfile_->valueAt( t-( phi+delay_phase_ )/omega ) * ( *space_envelope )( j, k ) * sin( omega*t - phi );
+        omega = omega_ * chirpProfile_->valueAt( t );
+        if( uniform_phase_ ) {
+            time_envelope[0] = timeProfile_->valueAt( t-( phi[0]+delay_phase_ )/omega );
+        } else {
+            #pragma omp simd
+            for( unsigned int i=0; i<n; i++ ) {
+                delayed_time[i] = t-( phi[i]+delay_phase_ )/omega;
+            }
+            vector<Field *> delayed_time_field( 1, delayed_time_ );
+            timeProfile_->valuesAt( delayed_time_field, *time_envelope_ );
+        }
     }
-    return amp;
+    if( uniform_phase_ ) {
+        double envelope = time_envelope[0];
+        #pragma omp simd
+        for( unsigned int i=0; i<n; i++ ) {
+            time_envelope[i] = envelope;
+        }
+    }
+    
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        amplitude[i] = time_envelope[i] * space[i] * sin( omega*t - phi[i] );
+    }
+    amplitude_time_ = t;
 }
 
 //Destructor
@@ -559,7 +646,7 @@ void LaserProfileFile::initFields( Params &params, Patch *patch )
 }
 
 // Amplitude of a laser profile from a file (see LaserOffset)
-double LaserProfileFile::getAmplitude( std::vector<double> pos, double t, int j, int k )
+double LaserProfileFile::getAmplitude( const std::vector<double> &pos, double t, int j, int k )
 {
     double amp = 0;
     unsigned int n = omega.size();
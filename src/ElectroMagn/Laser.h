@@ -24,11 +24,11 @@ class LaserProfile
 public:
     LaserProfile() {};
     virtual ~LaserProfile() {};
-    virtual double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    virtual double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
-    virtual std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    virtual std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     };
@@ -59,17 +59,17 @@ public:
     void clean();
     
     //! Gets the amplitude from both time and space profiles (By)
-    inline double getAmplitude0( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude0( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[0]->getAmplitude( pos, t, j, k );
     }
     //! Gets the amplitude from both time and space profiles (Bz)
-    inline double getAmplitude1( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude1( const std::vector<double> &pos, double t, int j, int k )
     {
         return profiles[1]->getAmplitude( pos, t, j, k );
     }
 
-    inline std::complex<double> getAmplitudecomplexN( std::vector<double> pos, double t, int j, int k, int imode )
+    inline std::complex<double> getAmplitudecomplexN( const std::vector<double> &pos, double t, int j, int k, int imode )
     {
         return profiles[imode]->getAmplitudecomplex( pos, t, j, k );
     }
@@ -118,7 +118,7 @@ public:
     ~LaserProfileSeparable();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field *space_envelope, *phase;
 private:
@@ -126,6 +126,14 @@ private:
     double omega_;
     Profile *timeProfile_, *chirpProfile_, *spaceProfile_, *phaseProfile_;
     double delay_phase_;
+    
+    //! Computes the amplitude at all the points of space_envelope for the time t
+    void computeAmplitudes( double t );
+    //! Amplitudes computed at time amplitude_time_, and buffers for the delayed times and the time envelope
+    Field *amplitude_, *delayed_time_, *time_envelope_;
+    double amplitude_time_;
+    //! True if the phase is the same at all points, so that the time envelope is evaluated only once
+    bool uniform_phase_;
 };
 
 // Laser profile for non-separable space and time
@@ -138,7 +146,7 @@ public:
     LaserProfileNonSeparable( LaserProfileNonSeparable *lp )
         : spaceAndTimeProfile_( new Profile( lp->spaceAndTimeProfile_ ) ) {};
     ~LaserProfileNonSeparable();
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         double amp;
         #pragma omp critical
@@ -146,7 +154,7 @@ public:
         return amp;
     }
 
-    inline std::complex<double> getAmplitudecomplex( std::vector<double> pos, double t, int j, int k )
+    inline std::complex<double> getAmplitudecomplex( const std::vector<double> &pos, double t, int j, int k )
     {
         std::complex<double> amp;
         #pragma omp critical
@@ -171,7 +179,7 @@ public:
     ~LaserProfileFile();
     void createFields( Params &params, Patch *patch );
     void initFields( Params &params, Patch *patch );
-    double getAmplitude( std::vector<double> pos, double t, int j, int k );
+    double getAmplitude( const std::vector<double> &pos, double t, int j, int k );
 protected:
     Field3D *magnitude, *phase;
     std::vector<double> omega;
@@ -188,7 +196,7 @@ public:
     LaserProfileNULL() {};
     ~LaserProfileNULL() {};
     
-    inline double getAmplitude( std::vector<double> pos, double t, int j, int k )
+    inline double getAmplitude( const std::vector<double> &pos, double t, int j, int k )
     {
         return 0.;
     }
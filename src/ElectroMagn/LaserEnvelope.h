@@ -29,6 +29,14 @@ public:
     void boundaryConditions( int itime, double time_dual, Patch *patch, Params &params, SimWindow *simWindow, ElectroMagn *EMfields );
     virtual void savePhiAndGradPhi() = 0;
     virtual void centerPhiAndGradPhi() = 0;
+    //! Computes Phi, |A|, |E| and GradPhi from the new envelope, then centers Phi and GradPhi in time
+    //! (some geometries fuse these steps in a single pass)
+    virtual void updatePhiAndGradPhi( ElectroMagn *EMfields )
+    {
+        computePhiEnvAEnvE( EMfields );
+        computeGradientPhi( EMfields );
+        centerPhiAndGradPhi();
+    }
     
     Profile *profile_;
     const std::vector<double> cell_length;
@@ -122,6 +130,7 @@ public:
     void computeGradientPhi( ElectroMagn *EMfields ) override final;
     void savePhiAndGradPhi() override final;
     void centerPhiAndGradPhi() override final;
+    void updatePhiAndGradPhi( ElectroMagn *EMfields ) override final;
 };
 
 // Class for envelope with cylindrical symmetry
@@ -138,6 +147,7 @@ public:
     void computeGradientPhi( ElectroMagn *EMfields ) override final;
     void savePhiAndGradPhi() override final;
     void centerPhiAndGradPhi() override final;
+    void updatePhiAndGradPhi( ElectroMagn *EMfields ) override final;
 };
 
 
@@ -83,25 +83,40 @@ void LaserEnvelope1D::initEnvelope( Patch *patch, ElectroMagn *EMfields )
     
     
     vector<double> position( 1, 0 );
-    double t;
-    double t_previous_timestep;
-    
     
     // position[0]: x coordinate
     // t: time coordinate --> x/c for the envelope initialization
     
-    position[0]           = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A1D->isDual( 0 )?-0.5:0. ) );
-    t                     = position[0];          // x-ct     , t=0
-    t_previous_timestep   = position[0]+timestep; // x-c(t-dt), t=0
+    position[0] = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A1D->isDual( 0 )?-0.5:0. ) );
+    int N0 = ( int )A1D->dims()[0];
+    
+    // Create the x,t maps where profiles will be evaluated
+    vector<Field *> x( 1 );
+    Field *t;
+    Field *t_previous_timestep;
+    vector<unsigned int> n_space_to_create( 1, N0 );
+    
+    x[0]                = new Field1D( n_space_to_create );
+    t                   = new Field1D( n_space_to_create );
+    t_previous_timestep = new Field1D( n_space_to_create );
+    
+    for( int i=0 ; i<N0 ; i++ ) {
+        ( *x[0] )( i )                = position[0];
+        ( *t )( i )                   = position[0];          // x-ct     , t=0
+        ( *t_previous_timestep )( i ) = position[0]+timestep; // x-c(t-dt), t=0
+        position[0] += cell_length[0];
+    }
     
+    // init envelope through Python function
+    profile_->complexValuesAt( x, t, *A1D );
+    profile_->complexValuesAt( x, t_previous_timestep, *A01D );
+    
+    delete x[0];
+    delete t;
+    delete t_previous_timestep;
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
     for( unsigned int i=0 ; i<A_->dims_[0] ; i++ ) { // x loop
-    
-        // init envelope through Python function
-        ( *A1D )( i )      += profile_->complexValueAt( position, t );
-        ( *A01D )( i )     += profile_->complexValueAt( position, t_previous_timestep );
-        
         // |A|
         ( *Env_Aabs1D )( i )= std::abs( ( *A1D )( i ) );
         // |E envelope| = |-(dA/dt-ik0cA)|
@@ -112,10 +127,6 @@ void LaserEnvelope1D::initEnvelope( Patch *patch, ElectroMagn *EMfields )
         ( *Phi_m1D )( i )   = std::abs( ( *A01D )( i ) ) * std::abs( ( *A01D )( i ) ) * 0.5;
         // interpolate in time
         ( *Phi_m1D )( i )   = 0.5*( ( *Phi_m1D )( i )+( *Phi1D )( i ) );
-        
-        position[0]          += cell_length[0];
-        t                     = position[0];
-        t_previous_timestep   = position[0]+timestep;
     } // end x loop
     
     // Compute gradient of ponderomotive potential
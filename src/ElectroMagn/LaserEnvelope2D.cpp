@@ -90,26 +90,56 @@ void LaserEnvelope2D::initEnvelope( Patch *patch, ElectroMagn *EMfields )
     
     
     vector<double> position( 2, 0 );
-    double t;
-    double t_previous_timestep;
     
     // position[0]: x coordinate
     // position[1]: y coordinate
     // t: time coordinate --> x/c for the envelope initialization
     
-    position[0]           = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A2D->isDual( 0 )?-0.5:0. ) );
-    t                     = position[0];          // x-ct     , t=0
-    t_previous_timestep   = position[0]+timestep; // x-c(t-dt), t=0
+    position[0] = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A2D->isDual( 0 )?-0.5:0. ) );
     double pos1 = cell_length[1]*( ( double )( patch->getCellStartingGlobalIndex( 1 ) )+( A2D->isDual( 1 )?-0.5:0. ) );
+    int N0 = ( int )A2D->dims()[0];
+    int N1 = ( int )A2D->dims()[1];
+    
+    // Create the x,y,t maps where profiles will be evaluated
+    vector<Field *> xy( 2 );
+    Field *t;
+    Field *t_previous_timestep;
+    vector<unsigned int> n_space_to_create( 2 );
+    n_space_to_create[0] = N0;
+    n_space_to_create[1] = N1;
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        xy[idim] = new Field2D( n_space_to_create );
+    }
+    t                   = new Field2D( n_space_to_create );
+    t_previous_timestep = new Field2D( n_space_to_create );
+    
+    for( int i=0 ; i<N0 ; i++ ) {
+        position[1] = pos1;
+        for( int j=0 ; j<N1 ; j++ ) {
+            for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+                ( *xy[idim] )( i, j ) = position[idim];
+            }
+            ( *t )( i, j )                   = position[0];          // x-ct     , t=0
+            ( *t_previous_timestep )( i, j ) = position[0]+timestep; // x-c(t-dt), t=0
+            position[1] += cell_length[1];
+        }
+        position[0] += cell_length[0];
+    }
+    
+    // init envelope through Python function
+    profile_->complexValuesAt( xy, t, *A2D );
+    profile_->complexValuesAt( xy, t_previous_timestep, *A02D );
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        delete xy[idim];
+    }
+    delete t;
+    delete t_previous_timestep;
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
     for( unsigned int i=0 ; i<A_->dims_[0] ; i++ ) { // x loop
-        position[1] = pos1;
         for( unsigned int j=0 ; j<A_->dims_[1] ; j++ ) { // y loop
-            // init envelope through Python function
-            ( *A2D )( i, j )      += profile_->complexValueAt( position, t );
-            ( *A02D )( i, j )     += profile_->complexValueAt( position, t_previous_timestep );
-            
             // |A|
             ( *Env_Aabs2D )( i, j )= std::abs( ( *A2D )( i, j ) );
             // |E envelope| = |-(dA/dt-ik0cA)|
@@ -120,12 +150,7 @@ void LaserEnvelope2D::initEnvelope( Patch *patch, ElectroMagn *EMfields )
             ( *Phi_m2D )( i, j )   = std::abs( ( *A02D )( i, j ) ) * std::abs( ( *A02D )( i, j ) ) * 0.5;
             // interpolate in time
             ( *Phi_m2D )( i, j )   = 0.5*( ( *Phi_m2D )( i, j )+( *Phi2D )( i, j ) );
-            
-            position[1] += cell_length[1];
         } // end y loop
-        position[0]          += cell_length[0];
-        t                     = position[0];
-        t_previous_timestep   = position[0]+timestep;
     } // end x loop
     
     // Compute gradient of ponderomotive potential
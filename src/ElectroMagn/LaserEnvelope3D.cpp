@@ -201,6 +201,22 @@ void LaserEnvelope3D::initEnvelope( Patch *patch, ElectroMagn *EMfields )
 }
 
 
+// Exchanges A and A0 in the plane i, except in the ghost cells along y and z
+// (final back-substitution of the explicit solvers)
+static void swapPlane( cField3D *A, cField3D *A0, unsigned int i )
+{
+    unsigned int ny = A->dims_[1], nz = A->dims_[2];
+    for( unsigned int j=1 ; j < ny-1 ; j++ ) {
+        complex<double> *a  = &( A->cdata_[( i*ny+j )*nz] );
+        complex<double> *a0 = &( A0->cdata_[( i*ny+j )*nz] );
+        for( unsigned int k=1 ; k < nz-1; k++ ) {
+            complex<double> tmp = a[k];
+            a[k]  = a0[k];
+            a0[k] = tmp;
+        }
+    }
+}
+
 LaserEnvelope3D::~LaserEnvelope3D()
 {
 }
@@ -225,42 +241,56 @@ void LaserEnvelope3D::updateEnvelope( ElectroMagn *EMfields )
     cField3D *A03D         = static_cast<cField3D *>( A0_ );              // the envelope at timestep n-1
     Field3D *Env_Chi3D     = static_cast<Field3D *>( EMfields->Env_Chi_ ); // source term of envelope equation
     
-    // temporary variable for updated envelope
-    cField3D *A3Dnew;
-    A3Dnew  = new cField3D( A_->dims_ );
+    // The complex numbers are split in real and imaginary parts so that the z loops are vectorized.
+    // The new envelope at a point only requires A0 at the same point: it is written in A0,
+    // then A and A0 are exchanged in each x plane which is not needed anymore by the stencil.
+    double *a            = reinterpret_cast<double *>( A3D->cdata_ );
+    double *a0           = reinterpret_cast<double *>( A03D->cdata_ );
+    const double *chi    = Env_Chi3D->data();
+    unsigned int nx = A_->dims_[0], ny = A_->dims_[1], nz = A_->dims_[2];
+    int sx = 2*ny*nz, sy = 2*nz; // strides of the split arrays (signed: offsets are negative)
+    const double cr = real( i1_2k0_over_2dx ), ci = imag( i1_2k0_over_2dx );
+    const double qr = real( one_plus_ik0dt ), qi = imag( one_plus_ik0dt );
+    const double Cr = real( one_plus_ik0dt_ov_one_plus_k0sq_dtsq ), Ci = imag( one_plus_ik0dt_ov_one_plus_k0sq_dtsq );
     
     //// explicit solver
-    for( unsigned int i=1 ; i <A_->dims_[0]-1; i++ ) { // x loop
-        for( unsigned int j=1 ; j < A_->dims_[1]-1 ; j++ ) { // y loop
-            for( unsigned int k=1 ; k < A_->dims_[2]-1; k++ ) { // z loop
-                ( *A3Dnew )( i, j, k ) -= ( *Env_Chi3D )( i, j, k )*( *A3D )( i, j, k ); // subtract here source term Chi*A from plasma
-                // A3Dnew = laplacian - source term
-                ( *A3Dnew )( i, j, k ) += ( ( *A3D )( i-1, j, k )-2.*( *A3D )( i, j, k )+( *A3D )( i+1, j, k ) )*one_ov_dx_sq; // x part
-                ( *A3Dnew )( i, j, k ) += ( ( *A3D )( i, j-1, k )-2.*( *A3D )( i, j, k )+( *A3D )( i, j+1, k ) )*one_ov_dy_sq; // y part
-                ( *A3Dnew )( i, j, k ) += ( ( *A3D )( i, j, k-1 )-2.*( *A3D )( i, j, k )+( *A3D )( i, j, k+1 ) )*one_ov_dz_sq; // z part
-                // A3Dnew = A3Dnew+2ik0*dA/dx
-                ( *A3Dnew )( i, j, k ) += i1_2k0_over_2dx*( ( *A3D )( i+1, j, k )-( *A3D )( i-1, j, k ) );
-                // A3Dnew = A3Dnew*dt^2
-                ( *A3Dnew )( i, j, k )  = ( *A3Dnew )( i, j, k )*dt_sq;
-                // A3Dnew = A3Dnew + 2/c^2 A3D - (1+ik0cdt)A03D/c^2
-                ( *A3Dnew )( i, j, k ) += 2.*( *A3D )( i, j, k )-one_plus_ik0dt*( *A03D )( i, j, k );
-                // A3Dnew = A3Dnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-                ( *A3Dnew )( i, j, k )  = ( *A3Dnew )( i, j, k )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-            } // end z loop
-        } // end y loop
-    } // end x loop
-    
-    for( unsigned int i=1 ; i <A_->dims_[0]-1; i++ ) { // x loop
-        for( unsigned int j=1 ; j < A_->dims_[1]-1 ; j++ ) { // y loop
-            for( unsigned int k=1 ; k < A_->dims_[2]-1; k++ ) { // z loop
-                // final back-substitution
-                ( *A03D )( i, j, k )       = ( *A3D )( i, j, k );
-                ( *A3D )( i, j, k )        = ( *A3Dnew )( i, j, k );
+    for( unsigned int i=1 ; i <nx-1; i++ ) { // x loop
+        for( unsigned int j=1 ; j < ny-1 ; j++ ) { // y loop
+            const double *A  = &a[( i*ny+j )*2*nz];
+            double *A0       = &a0[( i*ny+j )*2*nz];
+            const double *Ch = &chi[( i*ny+j )*nz];
+            #pragma omp simd
+            for( unsigned int k=1 ; k < nz-1; k++ ) { // z loop
+                int p = 2*k;
+                double ar = A[p], ai = A[p+1];
+                // laplacian - source term Chi*A from plasma
+                double rr = -Ch[k]*ar, ri = -Ch[k]*ai;
+                rr += ( A[p-sx]-2.*ar+A[p+sx] )*one_ov_dx_sq; // x part
+                ri += ( A[p-sx+1]-2.*ai+A[p+sx+1] )*one_ov_dx_sq;
+                rr += ( A[p-sy]-2.*ar+A[p+sy] )*one_ov_dy_sq; // y part
+                ri += ( A[p-sy+1]-2.*ai+A[p+sy+1] )*one_ov_dy_sq;
+                rr += ( A[p-2]-2.*ar+A[p+2] )*one_ov_dz_sq; // z part
+                ri += ( A[p-1]-2.*ai+A[p+3] )*one_ov_dz_sq;
+                // +2ik0*dA/dx
+                double dar = A[p+sx]-A[p-sx], dai = A[p+sx+1]-A[p-sx+1];
+                rr += cr*dar - ci*dai;
+                ri += cr*dai + ci*dar;
+                // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+                double a0r = A0[p], a0i = A0[p+1];
+                rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+                ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+                // * (1+ik0dct)/(1+k0^2c^2dt^2)
+                A0[p]   = rr*Cr - ri*Ci;
+                A0[p+1] = rr*Ci + ri*Cr;
             } // end z loop
         } // end y loop
+        // final back-substitution of the previous plane
+        if( i > 1 ) {
+            swapPlane( A3D, A03D, i-1 );
+        }
     } // end x loop
+    swapPlane( A3D, A03D, nx-2 );
     
-    delete A3Dnew;
 } // end LaserEnvelope3D::updateEnvelope
 
 void LaserEnvelope3D::updateEnvelopeReducedDispersion( ElectroMagn *EMfields )
@@ -289,46 +319,64 @@ void LaserEnvelope3D::updateEnvelopeReducedDispersion( ElectroMagn *EMfields )
     cField3D *A3D          = static_cast<cField3D *>( A_ );               // the envelope at timestep n
     cField3D *A03D         = static_cast<cField3D *>( A0_ );              // the envelope at timestep n-1
     Field3D *Env_Chi3D     = static_cast<Field3D *>( EMfields->Env_Chi_ ); // source term of envelope equation
-  
     
-    // temporary variable for updated envelope
-    cField3D *A3Dnew;
-    A3Dnew  = new cField3D( A_->dims_ );
+    // Split real and imaginary parts, new envelope written in A0 (see updateEnvelope)
+    double *a            = reinterpret_cast<double *>( A3D->cdata_ );
+    double *a0           = reinterpret_cast<double *>( A03D->cdata_ );
+    const double *chi    = Env_Chi3D->data();
+    unsigned int nx = A_->dims_[0], ny = A_->dims_[1], nz = A_->dims_[2];
+    int sx = 2*ny*nz, sy = 2*nz; // strides of the split arrays (signed: offsets are negative)
+    const complex<double> c1 = i1_2k0_over_2dx*( 1.+delta ), c2 = i1_2k0_over_2dx*delta*0.5;
+    const double c1r = real( c1 ), c1i = imag( c1 ), c2r = real( c2 ), c2i = imag( c2 );
+    const double qr = real( one_plus_ik0dt ), qi = imag( one_plus_ik0dt );
+    const double Cr = real( one_plus_ik0dt_ov_one_plus_k0sq_dtsq ), Ci = imag( one_plus_ik0dt_ov_one_plus_k0sq_dtsq );
     
     //// explicit solver
-    for( unsigned int i=2 ; i <A_->dims_[0]-2; i++ ) { // x loop
-        for( unsigned int j=1 ; j < A_->dims_[1]-1 ; j++ ) { // y loop
-            for( unsigned int k=1 ; k < A_->dims_[2]-1; k++ ) { // z loop
-                ( *A3Dnew )( i, j, k ) -= ( *Env_Chi3D )( i, j, k )*( *A3D )( i, j, k ); // subtract here source term Chi*A from plasma
-                // A3Dnew = laplacian - source term
-                ( *A3Dnew )( i, j, k ) += (1.+delta)*    ( ( *A3D )( i-1, j, k )-2.*( *A3D )( i, j, k )+( *A3D )( i+1, j, k ) )*one_ov_dx_sq; // x part with optimized derivative
-                ( *A3Dnew )( i, j, k ) -= delta*         ( ( *A3D )( i-2, j, k )-2.*( *A3D )( i, j, k )+( *A3D )( i+2, j, k ) )*one_ov_dx_sq*0.25;
-                ( *A3Dnew )( i, j, k ) +=                ( ( *A3D )( i, j-1, k )-2.*( *A3D )( i, j, k )+( *A3D )( i, j+1, k ) )*one_ov_dy_sq; // y part
-                ( *A3Dnew )( i, j, k ) +=                ( ( *A3D )( i, j, k-1 )-2.*( *A3D )( i, j, k )+( *A3D )( i, j, k+1 ) )*one_ov_dz_sq; // z part
-                // A3Dnew = A3Dnew+2ik0*dA/dx, where dA/dx uses the optimized form
-                ( *A3Dnew )( i, j, k ) += i1_2k0_over_2dx*(1.+delta)*( ( *A3D )( i+1, j, k )-( *A3D )( i-1, j, k ) );
-                ( *A3Dnew )( i, j, k ) -= i1_2k0_over_2dx*delta*0.5 *( ( *A3D )( i+2, j, k )-( *A3D )( i-2, j, k ) );
-                // A3Dnew = A3Dnew*dt^2
-                ( *A3Dnew )( i, j, k )  = ( *A3Dnew )( i, j, k )*dt_sq;
-                // A3Dnew = A3Dnew + 2/c^2 A3D - (1+ik0cdt)A03D/c^2
-                ( *A3Dnew )( i, j, k ) += 2.*( *A3D )( i, j, k )-one_plus_ik0dt*( *A03D )( i, j, k );
-                // A3Dnew = A3Dnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-                ( *A3Dnew )( i, j, k )  = ( *A3Dnew )( i, j, k )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-            } // end z loop
-        } // end y loop
-    } // end x loop
-    
-    for( unsigned int i=2 ; i <A_->dims_[0]-2; i++ ) { // x loop
-        for( unsigned int j=1 ; j < A_->dims_[1]-1 ; j++ ) { // y loop
-            for( unsigned int k=1 ; k < A_->dims_[2]-1; k++ ) { // z loop
-                // final back-substitution
-                ( *A03D )( i, j, k )       = ( *A3D )( i, j, k );
-                ( *A3D )( i, j, k )        = ( *A3Dnew )( i, j, k );
+    for( unsigned int i=2 ; i <nx-2; i++ ) { // x loop
+        for( unsigned int j=1 ; j < ny-1 ; j++ ) { // y loop
+            const double *A  = &a[( i*ny+j )*2*nz];
+            double *A0       = &a0[( i*ny+j )*2*nz];
+            const double *Ch = &chi[( i*ny+j )*nz];
+            #pragma omp simd
+            for( unsigned int k=1 ; k < nz-1; k++ ) { // z loop
+                int p = 2*k;
+                double ar = A[p], ai = A[p+1];
+                // laplacian - source term Chi*A from plasma
+                double rr = -Ch[k]*ar, ri = -Ch[k]*ai;
+                rr += ( 1.+delta )*( A[p-sx]-2.*ar+A[p+sx] )*one_ov_dx_sq; // x part with optimized derivative
+                ri += ( 1.+delta )*( A[p-sx+1]-2.*ai+A[p+sx+1] )*one_ov_dx_sq;
+                rr -= delta*( A[p-2*sx]-2.*ar+A[p+2*sx] )*one_ov_dx_sq*0.25;
+                ri -= delta*( A[p-2*sx+1]-2.*ai+A[p+2*sx+1] )*one_ov_dx_sq*0.25;
+                rr += ( A[p-sy]-2.*ar+A[p+sy] )*one_ov_dy_sq; // y part
+                ri += ( A[p-sy+1]-2.*ai+A[p+sy+1] )*one_ov_dy_sq;
+                rr += ( A[p-2]-2.*ar+A[p+2] )*one_ov_dz_sq; // z part
+                ri += ( A[p-1]-2.*ai+A[p+3] )*one_ov_dz_sq;
+                // +2ik0*dA/dx, where dA/dx uses the optimized form
+                double dar = A[p+sx]-A[p-sx], dai = A[p+sx+1]-A[p-sx+1];
+                rr += c1r*dar - c1i*dai;
+                ri += c1r*dai + c1i*dar;
+                dar = A[p+2*sx]-A[p-2*sx];
+                dai = A[p+2*sx+1]-A[p-2*sx+1];
+                rr -= c2r*dar - c2i*dai;
+                ri -= c2r*dai + c2i*dar;
+                // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+                double a0r = A0[p], a0i = A0[p+1];
+                rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+                ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+                // * (1+ik0dct)/(1+k0^2c^2dt^2)
+                A0[p]   = rr*Cr - ri*Ci;
+                A0[p+1] = rr*Ci + ri*Cr;
             } // end z loop
         } // end y loop
+        // final back-substitution of the plane which is not needed anymore
+        if( i > 3 ) {
+            swapPlane( A3D, A03D, i-2 );
+        }
     } // end x loop
+    for( unsigned int i=max( nx-4, 2u ) ; i <nx-2; i++ ) {
+        swapPlane( A3D, A03D, i );
+    }
     
-    delete A3Dnew;
 } // end LaserEnvelope3D::updateEnvelopeReducedDispersion
 
 
@@ -391,6 +439,84 @@ void LaserEnvelope3D::computeGradientPhi( ElectroMagn *EMfields )
 } // end LaserEnvelope3D::computeGradientPhi
 
 
+void LaserEnvelope3D::updatePhiAndGradPhi( ElectroMagn *EMfields )
+{
+    // Same as computePhiEnvAEnvE, computeGradientPhi and centerPhiAndGradPhi, fused in a single pass along x:
+    // the plane i+1 of Phi is computed, then the gradient in the plane i, which is then centered in time
+    
+    const double *a   = reinterpret_cast<const double *>( static_cast<cField3D *>( A_ )->cdata_ );
+    const double *a0  = reinterpret_cast<const double *>( static_cast<cField3D *>( A0_ )->cdata_ );
+    double *phi       = Phi_->data();
+    double *phi_m     = Phi_m->data();
+    double *env_aabs  = EMfields->Env_A_abs_->data();
+    double *env_eabs  = EMfields->Env_E_abs_->data();
+    double *gx        = GradPhix_->data();
+    double *gy        = GradPhiy_->data();
+    double *gz        = GradPhiz_->data();
+    double *gx_m      = GradPhix_m->data();
+    double *gy_m      = GradPhiy_m->data();
+    double *gz_m      = GradPhiz_m->data();
+    unsigned int nx = A_->dims_[0], ny = A_->dims_[1], nz = A_->dims_[2];
+    unsigned int sx = ny*nz;
+    
+    for( unsigned int i=0 ; i < nx; i++ ) { // x loop
+    
+        // Ponderomotive potential Phi=|A|^2/2, |A| and |E|, at timestep n+1, including ghost cells
+        if( i < nx-1 ) {
+            for( unsigned int j=0 ; j < ny-1; j++ ) { // y loop
+                unsigned int p0 = ( i*ny+j )*nz;
+                #pragma omp simd
+                for( unsigned int k=0 ; k < nz-1; k++ ) { // z loop
+                    unsigned int p = p0+k;
+                    double ar = a[2*p], ai = a[2*p+1];
+                    double abs_a = sqrt( ar*ar + ai*ai );
+                    phi[p]      = abs_a * abs_a * 0.5;
+                    env_aabs[p] = abs_a;
+                    // |E envelope| = |-(dA/dt-ik0cA)|, forward finite differences for the time derivative
+                    double er = ( ar-a0[2*p] )/timestep + ai;
+                    double ei = ( ai-a0[2*p+1] )/timestep - ar;
+                    env_eabs[p] = sqrt( er*er + ei*ei );
+                } // end z loop
+            } // end y loop
+        }
+        
+        if( i == 0 ) {
+            continue;
+        }
+        unsigned int ic = i-1; // plane where Phi is known on both sides
+        
+        // Gradients of Phi
+        if( ic >= 1 ) {
+            for( unsigned int j=1 ; j < ny-1; j++ ) { // y loop
+                unsigned int p0 = ( ic*ny+j )*nz;
+                #pragma omp simd
+                for( unsigned int k=1 ; k < nz-1; k++ ) { // z loop
+                    unsigned int p = p0+k;
+                    gx[p] = ( phi[p+sx]-phi[p-sx] ) * one_ov_2dx;
+                    gy[p] = ( phi[p+nz]-phi[p-nz] ) * one_ov_2dy;
+                    gz[p] = ( phi[p+1]-phi[p-1] ) * one_ov_2dz;
+                } // end z loop
+            } // end y loop
+        }
+        
+        // Phi and GradPhi at time n+1/2, from their values at timestep n+1 and n (the latter in Phi_m and GradPhi_m)
+        for( unsigned int j=0 ; j < ny-1; j++ ) { // y loop
+            unsigned int p0 = ( ic*ny+j )*nz;
+            #pragma omp simd
+            for( unsigned int k=0 ; k < nz-1; k++ ) { // z loop
+                unsigned int p = p0+k;
+                phi_m[p] = 0.5*( phi_m[p]+phi[p] );
+                gx_m[p]  = 0.5*( gx_m[p]+gx[p] );
+                gy_m[p]  = 0.5*( gy_m[p]+gy[p] );
+                gz_m[p]  = 0.5*( gz_m[p]+gz[p] );
+            } // end z loop
+        } // end y loop
+        
+    } // end x loop
+    
+} // end LaserEnvelope3D::updatePhiAndGradPhi
+
+
 void LaserEnvelope3D::savePhiAndGradPhi()
 {
     // Static cast of the fields
@@ -94,26 +94,56 @@ void LaserEnvelopeAM::initEnvelope( Patch *patch, ElectroMagn *EMfields )
     
     
     vector<double> position( 2, 0 );
-    double t;
-    double t_previous_timestep;    
     
     // position[0]: x coordinate
     // position[1]: r coordinate
     // t: time coordinate --> x/c for the envelope initialization
     
-    position[0]           = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A2Dcyl->isDual( 0 )?-0.5:0. ) );
-    t                     = position[0];          // x-ct     , t=0
-    t_previous_timestep   = position[0]+timestep; // x-c(t-dt), t=0
+    position[0] = cell_length[0]*( ( double )( patch->getCellStartingGlobalIndex( 0 ) )+( A2Dcyl->isDual( 0 )?-0.5:0. ) );
     double pos1 = cell_length[1]*( ( double )( patch->getCellStartingGlobalIndex( 1 ) )+( A2Dcyl->isDual( 1 )?-0.5:0. ) );
+    int N0 = ( int )A2Dcyl->dims()[0];
+    int N1 = ( int )A2Dcyl->dims()[1];
+    
+    // Create the x,r,t maps where profiles will be evaluated
+    vector<Field *> xr( 2 );
+    Field *t;
+    Field *t_previous_timestep;
+    vector<unsigned int> n_space_to_create( 2 );
+    n_space_to_create[0] = N0;
+    n_space_to_create[1] = N1;
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        xr[idim] = new Field2D( n_space_to_create );
+    }
+    t                   = new Field2D( n_space_to_create );
+    t_previous_timestep = new Field2D( n_space_to_create );
+    
+    for( int i=0 ; i<N0 ; i++ ) {
+        position[1] = pos1;
+        for( int j=0 ; j<N1 ; j++ ) {
+            for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+                ( *xr[idim] )( i, j ) = position[idim];
+            }
+            ( *t )( i, j )                   = position[0];          // x-ct     , t=0
+            ( *t_previous_timestep )( i, j ) = position[0]+timestep; // x-c(t-dt), t=0
+            position[1] += cell_length[1];
+        }
+        position[0] += cell_length[0];
+    }
+    
+    // init envelope through Python function
+    profile_->complexValuesAt( xr, t, *A2Dcyl );
+    profile_->complexValuesAt( xr, t_previous_timestep, *A02Dcyl );
+    
+    for( unsigned int idim=0 ; idim<2 ; idim++ ) {
+        delete xr[idim];
+    }
+    delete t;
+    delete t_previous_timestep;
     
     // UNSIGNED INT LEADS TO PB IN PERIODIC BCs
     for( unsigned int i=0 ; i<A_->dims_[0] ; i++ ) { // x loop
-        position[1] = pos1;
         for( unsigned int j=0 ; j<A_->dims_[1] ; j++ ) { // r loop
-            // init envelope through Python function
-            ( *A2Dcyl )( i, j )      += profile_->complexValueAt( position, t );
-            ( *A02Dcyl )( i, j )     += profile_->complexValueAt( position, t_previous_timestep );
-            
             // |A|
             ( *Env_Aabs2Dcyl )( i, j )= std::abs( ( *A2Dcyl )( i, j ) );
             // |E envelope| = |-(dA/dt-ik0cA)|
@@ -124,12 +154,7 @@ void LaserEnvelopeAM::initEnvelope( Patch *patch, ElectroMagn *EMfields )
             ( *Phi_m2Dcyl )( i, j )   = std::abs( ( *A02Dcyl )( i, j ) ) * std::abs( ( *A02Dcyl )( i, j ) ) * 0.5;
             // interpolate in time
             ( *Phi_m2Dcyl )( i, j )   = 0.5*( ( *Phi_m2Dcyl )( i, j )+( *Phi2Dcyl )( i, j ) );
-            
-            position[1] += cell_length[1];
-        } // end y loop
-        position[0]          += cell_length[0];
-        t                     = position[0];
-        t_previous_timestep   = position[0]+timestep;
+        } // end r loop
     } // end x loop
     
     // Compute gradient of ponderomotive potential
@@ -150,6 +175,20 @@ void LaserEnvelopeAM::initEnvelope( Patch *patch, ElectroMagn *EMfields )
 }
 
 
+// Exchanges A and A0 in the row i, except in the ghost cells along r
+// (final back-substitution of the explicit solvers)
+static void swapRow( cField2D *A, cField2D *A0, unsigned int i, bool isYmin )
+{
+    unsigned int nr = A->dims_[1];
+    complex<double> *a  = &( A->cdata_[i*nr] );
+    complex<double> *a0 = &( A0->cdata_[i*nr] );
+    for( unsigned int j=isYmin*2 ; j < nr-1 ; j++ ) {
+        complex<double> tmp = a[j];
+        a[j]  = a0[j];
+        a0[j] = tmp;
+    }
+}
+
 LaserEnvelopeAM::~LaserEnvelopeAM()
 {
 }
@@ -177,62 +216,82 @@ void LaserEnvelopeAM::updateEnvelope( ElectroMagn *EMfields )
   
     int  j_glob = ( static_cast<ElectroMagnAM *>( EMfields ) )->j_glob_;
     bool isYmin = ( static_cast<ElectroMagnAM *>( EMfields ) )->isYmin;
-  
-
-    // temporary variable for updated envelope
-    cField2D *A2Dcylnew;
-    A2Dcylnew  = new cField2D( A_->dims_ );
- 
+    
+    // The complex numbers are split in real and imaginary parts so that the r loops are vectorized.
+    // The new envelope at a point only requires A0 at the same point: it is written in A0,
+    // then A and A0 are exchanged in each l row which is not needed anymore by the stencil.
+    double *a            = reinterpret_cast<double *>( A2Dcyl->cdata_ );
+    double *a0           = reinterpret_cast<double *>( A02Dcyl->cdata_ );
+    const double *chi    = Env_Chi2Dcyl->data();
+    unsigned int nl = A_->dims_[0], nr = A_->dims_[1];
+    int sl = 2*nr; // stride of the split arrays (signed: offsets are negative)
+    const double cr = real( i1_2k0_over_2dl ), ci = imag( i1_2k0_over_2dl );
+    const double qr = real( one_plus_ik0dt ), qi = imag( one_plus_ik0dt );
+    const double Cr = real( one_plus_ik0dt_ov_one_plus_k0sq_dtsq ), Ci = imag( one_plus_ik0dt_ov_one_plus_k0sq_dtsq );
+    unsigned int jmin = std::max( 3*isYmin, 1 );
+    
     //// explicit solver
-    for( unsigned int i=1 ; i <A_->dims_[0]-1; i++ ) { // l loop
-        for( unsigned int j=std::max(3*isYmin,1) ; j < A_->dims_[1]-1 ; j++ ) { // r loop
-            ( *A2Dcylnew )( i, j ) -= ( *Env_Chi2Dcyl )( i, j )*( *A2Dcyl )( i, j ); // subtract here source term Chi*A from plasma
-            // A2Dcylnew = laplacian - source term
-            ( *A2Dcylnew )( i, j ) += ( ( *A2Dcyl )( i-1, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+1, j ) )*one_ov_dl_sq; // l part
-            ( *A2Dcylnew )( i, j ) += ( ( *A2Dcyl )( i, j-1 )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i, j+1 ) )*one_ov_dr_sq; // r part
-            ( *A2Dcylnew )( i, j ) += ( ( *A2Dcyl )( i, j+1 )-( *A2Dcyl )( i, j-1 ) ) * one_ov_2dr / ( ( double )( j_glob+j )*dr ); // r part         
-
-            // A2Dcylnew = A2Dcylnew+2ik0*dA/dl
-            ( *A2Dcylnew )( i, j ) += i1_2k0_over_2dl*( ( *A2Dcyl )( i+1, j )-( *A2Dcyl )( i-1, j ) );
-            // A2Dcylnew = A2Dcylnew*dt^2
-            ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*dt_sq;
-            // A2Dcylnew = A2Dcylnew + 2/c^2 A2Dcyl - (1+ik0cdt)A02Dcyl/c^2
-            ( *A2Dcylnew )( i, j ) += 2.*( *A2Dcyl )( i, j )-one_plus_ik0dt*( *A02Dcyl )( i, j );
-            // A2Dcylnew = A2Dcylnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-            ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-        } // end r loop
-    } // end l loop
-
-    if (isYmin){ // axis BC
-        for( unsigned int i=1 ; i <A_->dims_[0]-1; i++ ) { // l loop
-           unsigned int j = 2; // j_p = 2 corresponds to r=0
-
-           ( *A2Dcylnew )( i, j ) -= ( *Env_Chi2Dcyl )( i, j )*( *A2Dcyl )( i, j ); // subtract here source term Chi*A from plasma
-           ( *A2Dcylnew )( i, j ) += ( ( *A2Dcyl )( i-1, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+1, j ) )*one_ov_dl_sq; // l part
-           ( *A2Dcylnew )( i, j ) += 4. * ( ( *A2Dcyl )( i, j+1 )-( *A2Dcyl )( i, j ) ) * one_ov_dr_sq; // r part
-
-           // A2Dcylnew = A2Dcylnew+2ik0*dA/dl
-           ( *A2Dcylnew )( i, j ) += i1_2k0_over_2dl*( ( *A2Dcyl )( i+1, j )-( *A2Dcyl )( i-1, j ) );
-           // A2Dcylnew = A2Dcylnew*dt^2
-           ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*dt_sq;
-           // A2Dcylnew = A2Dcylnew + 2/c^2 A2Dcyl - (1+ik0cdt)A02Dcyl/c^2
-           ( *A2Dcylnew )( i, j ) += 2.*( *A2Dcyl )( i, j )-one_plus_ik0dt*( *A02Dcyl )( i, j );
-           // A2Dcylnew = A2Dcylnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-           ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-           
-        } 
-    }    
-
-    for( unsigned int i=1 ; i <A_->dims_[0]-1; i++ ) { // x loop
-        for( unsigned int j=isYmin*2 ; j < A_->dims_[1]-1 ; j++ ) { // r loop
-            // final back-substitution
-            ( *A02Dcyl )( i, j )       = ( *A2Dcyl )( i, j );
-            ( *A2Dcyl )( i, j )        = ( *A2Dcylnew )( i, j );
+    for( unsigned int i=1 ; i <nl-1; i++ ) { // l loop
+        const double *A  = &a[i*sl];
+        double *A0       = &a0[i*sl];
+        const double *Ch = &chi[i*nr];
+        #pragma omp simd
+        for( unsigned int j=jmin ; j < nr-1 ; j++ ) { // r loop
+            int p = 2*j;
+            double ar = A[p], ai = A[p+1];
+            // laplacian - source term Chi*A from plasma
+            double rr = -Ch[j]*ar, ri = -Ch[j]*ai;
+            rr += ( A[p-sl]-2.*ar+A[p+sl] )*one_ov_dl_sq; // l part
+            ri += ( A[p-sl+1]-2.*ai+A[p+sl+1] )*one_ov_dl_sq;
+            rr += ( A[p-2]-2.*ar+A[p+2] )*one_ov_dr_sq; // r part
+            ri += ( A[p-1]-2.*ai+A[p+3] )*one_ov_dr_sq;
+            rr += ( A[p+2]-A[p-2] ) * one_ov_2dr / ( ( double )( j_glob+j )*dr );
+            ri += ( A[p+3]-A[p-1] ) * one_ov_2dr / ( ( double )( j_glob+j )*dr );
+            // +2ik0*dA/dl
+            double dar = A[p+sl]-A[p-sl], dai = A[p+sl+1]-A[p-sl+1];
+            rr += cr*dar - ci*dai;
+            ri += cr*dai + ci*dar;
+            // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+            double a0r = A0[p], a0i = A0[p+1];
+            rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+            ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+            // * (1+ik0dct)/(1+k0^2c^2dt^2)
+            A0[p]   = rr*Cr - ri*Ci;
+            A0[p+1] = rr*Ci + ri*Cr;
         } // end r loop
+        
+        if( isYmin ) { // axis BC
+            int p = 2*2; // j_p = 2 corresponds to r=0
+            double ar = A[p], ai = A[p+1];
+            double rr = -Ch[2]*ar, ri = -Ch[2]*ai;
+            rr += ( A[p-sl]-2.*ar+A[p+sl] )*one_ov_dl_sq; // l part
+            ri += ( A[p-sl+1]-2.*ai+A[p+sl+1] )*one_ov_dl_sq;
+            rr += 4. * ( A[p+2]-ar ) * one_ov_dr_sq; // r part
+            ri += 4. * ( A[p+3]-ai ) * one_ov_dr_sq;
+            // +2ik0*dA/dl
+            double dar = A[p+sl]-A[p-sl], dai = A[p+sl+1]-A[p-sl+1];
+            rr += cr*dar - ci*dai;
+            ri += cr*dai + ci*dar;
+            // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+            double a0r = A0[p], a0i = A0[p+1];
+            rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+            ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+            // * (1+ik0dct)/(1+k0^2c^2dt^2)
+            A0[p]   = rr*Cr - ri*Ci;
+            A0[p+1] = rr*Ci + ri*Cr;
+        } else {
+            // the ghost cell j=0 is not computed: it is set to zero
+            A0[0] = 0.;
+            A0[1] = 0.;
+        }
+        
+        // final back-substitution of the previous row
+        if( i > 1 ) {
+            swapRow( A2Dcyl, A02Dcyl, i-1, isYmin );
+        }
     } // end l loop
-
-
-    delete A2Dcylnew;
+    swapRow( A2Dcyl, A02Dcyl, nl-2, isYmin );
+    
 } // end LaserEnvelopeAM::updateEnvelope
 
 void LaserEnvelopeAM::updateEnvelopeReducedDispersion( ElectroMagn *EMfields )
@@ -259,72 +318,101 @@ void LaserEnvelopeAM::updateEnvelopeReducedDispersion( ElectroMagn *EMfields )
     // (d^2A/dl^2)_opt = (1+delta)*(d^2A/dl^2) - delta*(A_{i+2,j,k}-2*A_{i,j,k}+A_{i-2,j,k})/(4dl^2)
   
    
-    cField2D *A2Dcyl       = static_cast<cField2D *>( A_ );                  // the envelope at timestep n
-    cField2D *A02Dcyl      = static_cast<cField2D *>( A0_ );                 // the envelope at timestep n-1
-    Field2D *Env_Chi2Dcyl  = static_cast<Field2D *>( EMfields->Env_Chi_ );   // source term of envelope equation
+    cField2D *A2Dcyl       = static_cast<cField2D *>( A_ );               // the envelope at timestep n
+    cField2D *A02Dcyl      = static_cast<cField2D *>( A0_ );              // the envelope at timestep n-1
+    Field2D *Env_Chi2Dcyl  = static_cast<Field2D *>( EMfields->Env_Chi_ ); // source term of envelope equation
   
     int  j_glob = ( static_cast<ElectroMagnAM *>( EMfields ) )->j_glob_;
     bool isYmin = ( static_cast<ElectroMagnAM *>( EMfields ) )->isYmin;
-
-
-    // temporary variable for updated envelope
-    cField2D *A2Dcylnew;
-    A2Dcylnew  = new cField2D( A_->dims_ );
- 
+    
+    // Split real and imaginary parts, new envelope written in A0 (see updateEnvelope)
+    double *a            = reinterpret_cast<double *>( A2Dcyl->cdata_ );
+    double *a0           = reinterpret_cast<double *>( A02Dcyl->cdata_ );
+    const double *chi    = Env_Chi2Dcyl->data();
+    unsigned int nl = A_->dims_[0], nr = A_->dims_[1];
+    int sl = 2*nr; // stride of the split arrays (signed: offsets are negative)
+    const complex<double> c1 = i1_2k0_over_2dl*( 1.+delta ), c2 = i1_2k0_over_2dl*delta*0.5;
+    const double c1r = real( c1 ), c1i = imag( c1 ), c2r = real( c2 ), c2i = imag( c2 );
+    const double qr = real( one_plus_ik0dt ), qi = imag( one_plus_ik0dt );
+    const double Cr = real( one_plus_ik0dt_ov_one_plus_k0sq_dtsq ), Ci = imag( one_plus_ik0dt_ov_one_plus_k0sq_dtsq );
+    unsigned int jmin = std::max( 3*isYmin, 1 );
+    
     //// explicit solver
-    for( unsigned int i=2 ; i <A_->dims_[0]-2; i++ ) { // l loop
-        for( unsigned int j=std::max(3*isYmin,1) ; j < A_->dims_[1]-1 ; j++ ) { // r loop
-            ( *A2Dcylnew )( i, j ) -= ( *Env_Chi2Dcyl )( i, j )*( *A2Dcyl )( i, j ); // subtract here source term Chi*A from plasma
-            // A2Dcylnew = laplacian - source term
-            ( *A2Dcylnew )( i, j ) += (1.+delta)*( ( *A2Dcyl )( i-1, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+1, j ) )*one_ov_dl_sq; // l part with optimized derivative
-            ( *A2Dcylnew )( i, j ) -= delta*     ( ( *A2Dcyl )( i-2, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+2, j ) )*one_ov_dl_sq*0.25;
-            ( *A2Dcylnew )( i, j ) +=            ( ( *A2Dcyl )( i, j-1 )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i, j+1 ) )*one_ov_dr_sq; // r part
-            ( *A2Dcylnew )( i, j ) +=            ( ( *A2Dcyl )( i, j+1 )-   ( *A2Dcyl )( i, j-1 ) ) * one_ov_2dr / ( ( double )( j_glob+j )*dr ); // r part         
-
-            // A2Dcylnew = A2Dcylnew+2ik0*dA/dl, where dA/dl uses the optimized form
-            ( *A2Dcylnew )( i, j ) += i1_2k0_over_2dl*(1.+delta)*( ( *A2Dcyl )( i+1, j )-( *A2Dcyl )( i-1, j ) );
-            ( *A2Dcylnew )( i, j ) -= i1_2k0_over_2dl*delta*0.5 *( ( *A2Dcyl )( i+2, j )-( *A2Dcyl )( i-2, j ) );
-            // A2Dcylnew = A2Dcylnew*dt^2
-            ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*dt_sq;
-            // A2Dcylnew = A2Dcylnew + 2/c^2 A2Dcyl - (1+ik0cdt)A02Dcyl/c^2
-            ( *A2Dcylnew )( i, j ) += 2.*( *A2Dcyl )( i, j )-one_plus_ik0dt*( *A02Dcyl )( i, j );
-            // A2Dcylnew = A2Dcylnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-            ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-        } // end r loop
-    } // end l loop
-
-    if (isYmin){ // axis BC
-        for( unsigned int i=2 ; i <A_->dims_[0]-2; i++ ) { // l loop
-           unsigned int j = 2; // j_p = 2 corresponds to r=0
-
-           ( *A2Dcylnew )( i, j ) -= ( *Env_Chi2Dcyl )( i, j )*( *A2Dcyl )( i, j ); // subtract here source term Chi*A from plasma
-           ( *A2Dcylnew )( i, j ) += (1.+delta)*( ( *A2Dcyl )( i-1, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+1, j ) )*one_ov_dl_sq; // l part with optimized derivative
-           ( *A2Dcylnew )( i, j ) -= delta*     ( ( *A2Dcyl )( i-2, j )-2.*( *A2Dcyl )( i, j )+( *A2Dcyl )( i+2, j ) )*one_ov_dl_sq*0.25;
-           ( *A2Dcylnew )( i, j ) += 4. *       ( ( *A2Dcyl )( i, j+1 )   -( *A2Dcyl )( i, j ) ) * one_ov_dr_sq; // r part
-
-           // A2Dcylnew = A2Dcylnew+2ik0*dA/dl, where dA/dl uses the optimized form
-           ( *A2Dcylnew )( i, j ) += i1_2k0_over_2dl*(1.+delta)*( ( *A2Dcyl )( i+1, j )-( *A2Dcyl )( i-1, j ) );
-           ( *A2Dcylnew )( i, j ) -= i1_2k0_over_2dl*delta*0.5 *( ( *A2Dcyl )( i+2, j )-( *A2Dcyl )( i-2, j ) );
-           // A2Dcylnew = A2Dcylnew*dt^2
-           ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*dt_sq;
-           // A2Dcylnew = A2Dcylnew + 2/c^2 A2Dcyl - (1+ik0cdt)A02Dcyl/c^2
-           ( *A2Dcylnew )( i, j ) += 2.*( *A2Dcyl )( i, j )-one_plus_ik0dt*( *A02Dcyl )( i, j );
-           // A2Dcylnew = A2Dcylnew * (1+ik0dct)/(1+k0^2c^2dt^2)
-           ( *A2Dcylnew )( i, j )  = ( *A2Dcylnew )( i, j )*one_plus_ik0dt_ov_one_plus_k0sq_dtsq;
-           
-        } 
-    }    
-
-    for( unsigned int i=2 ; i <A_->dims_[0]-2; i++ ) { // x loop
-        for( unsigned int j=isYmin*2 ; j < A_->dims_[1]-1 ; j++ ) { // r loop
-            // final back-substitution
-            ( *A02Dcyl )( i, j )       = ( *A2Dcyl )( i, j );
-            ( *A2Dcyl )( i, j )        = ( *A2Dcylnew )( i, j );            
+    for( unsigned int i=2 ; i <nl-2; i++ ) { // l loop
+        const double *A  = &a[i*sl];
+        double *A0       = &a0[i*sl];
+        const double *Ch = &chi[i*nr];
+        #pragma omp simd
+        for( unsigned int j=jmin ; j < nr-1 ; j++ ) { // r loop
+            int p = 2*j;
+            double ar = A[p], ai = A[p+1];
+            // laplacian - source term Chi*A from plasma
+            double rr = -Ch[j]*ar, ri = -Ch[j]*ai;
+            rr += ( 1.+delta )*( A[p-sl]-2.*ar+A[p+sl] )*one_ov_dl_sq; // l part with optimized derivative
+            ri += ( 1.+delta )*( A[p-sl+1]-2.*ai+A[p+sl+1] )*one_ov_dl_sq;
+            rr -= delta*( A[p-2*sl]-2.*ar+A[p+2*sl] )*one_ov_dl_sq*0.25;
+            ri -= delta*( A[p-2*sl+1]-2.*ai+A[p+2*sl+1] )*one_ov_dl_sq*0.25;
+            rr += ( A[p-2]-2.*ar+A[p+2] )*one_ov_dr_sq; // r part
+            ri += ( A[p-1]-2.*ai+A[p+3] )*one_ov_dr_sq;
+            rr += ( A[p+2]-A[p-2] ) * one_ov_2dr / ( ( double )( j_glob+j )*dr );
+            ri += ( A[p+3]-A[p-1] ) * one_ov_2dr / ( ( double )( j_glob+j )*dr );
+            // +2ik0*dA/dl, where dA/dl uses the optimized form
+            double dar = A[p+sl]-A[p-sl], dai = A[p+sl+1]-A[p-sl+1];
+            rr += c1r*dar - c1i*dai;
+            ri += c1r*dai + c1i*dar;
+            dar = A[p+2*sl]-A[p-2*sl];
+            dai = A[p+2*sl+1]-A[p-2*sl+1];
+            rr -= c2r*dar - c2i*dai;
+            ri -= c2r*dai + c2i*dar;
+            // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+            double a0r = A0[p], a0i = A0[p+1];
+            rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+            ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+            // * (1+ik0dct)/(1+k0^2c^2dt^2)
+            A0[p]   = rr*Cr - ri*Ci;
+            A0[p+1] = rr*Ci + ri*Cr;
         } // end r loop
+        
+        if( isYmin ) { // axis BC
+            int p = 2*2; // j_p = 2 corresponds to r=0
+            double ar = A[p], ai = A[p+1];
+            double rr = -Ch[2]*ar, ri = -Ch[2]*ai;
+            rr += ( 1.+delta )*( A[p-sl]-2.*ar+A[p+sl] )*one_ov_dl_sq; // l part with optimized derivative
+            ri += ( 1.+delta )*( A[p-sl+1]-2.*ai+A[p+sl+1] )*one_ov_dl_sq;
+            rr -= delta*( A[p-2*sl]-2.*ar+A[p+2*sl] )*one_ov_dl_sq*0.25;
+            ri -= delta*( A[p-2*sl+1]-2.*ai+A[p+2*sl+1] )*one_ov_dl_sq*0.25;
+            rr += 4. * ( A[p+2]-ar ) * one_ov_dr_sq; // r part
+            ri += 4. * ( A[p+3]-ai ) * one_ov_dr_sq;
+            // +2ik0*dA/dl, where dA/dl uses the optimized form
+            double dar = A[p+sl]-A[p-sl], dai = A[p+sl+1]-A[p-sl+1];
+            rr += c1r*dar - c1i*dai;
+            ri += c1r*dai + c1i*dar;
+            dar = A[p+2*sl]-A[p-2*sl];
+            dai = A[p+2*sl+1]-A[p-2*sl+1];
+            rr -= c2r*dar - c2i*dai;
+            ri -= c2r*dai + c2i*dar;
+            // *dt^2 + 2/c^2 A - (1+ik0cdt)A0/c^2
+            double a0r = A0[p], a0i = A0[p+1];
+            rr = rr*dt_sq + ( 2.*ar - ( qr*a0r - qi*a0i ) );
+            ri = ri*dt_sq + ( 2.*ai - ( qr*a0i + qi*a0r ) );
+            // * (1+ik0dct)/(1+k0^2c^2dt^2)
+            A0[p]   = rr*Cr - ri*Ci;
+            A0[p+1] = rr*Ci + ri*Cr;
+        } else {
+            // the ghost cell j=0 is not computed: it is set to zero
+            A0[0] = 0.;
+            A0[1] = 0.;
+        }
+        
+        // final back-substitution of the row which is not needed anymore
+        if( i > 3 ) {
+            swapRow( A2Dcyl, A02Dcyl, i-2, isYmin );
+        }
     } // end l loop
-
-
-    delete A2Dcylnew;
+    for( unsigned int i=std::max( nl-4, 2u ) ; i <nl-2; i++ ) {
+        swapRow( A2Dcyl, A02Dcyl, i, isYmin );
+    }
+    
 } // end LaserEnvelopeAM::updateEnvelopeReducedDispersion
 
 
@@ -419,6 +507,90 @@ void LaserEnvelopeAM::computeGradientPhi( ElectroMagn *EMfields )
 } // end LaserEnvelopeAM::computeGradientPhi
 
 
+void LaserEnvelopeAM::updatePhiAndGradPhi( ElectroMagn *EMfields )
+{
+    // Same as computePhiEnvAEnvE, computeGradientPhi and centerPhiAndGradPhi, fused in a single pass along l:
+    // the row i+1 of Phi is computed, then the gradient in the row i, which is then centered in time
+    
+    const double *a   = reinterpret_cast<const double *>( static_cast<cField2D *>( A_ )->cdata_ );
+    const double *a0  = reinterpret_cast<const double *>( static_cast<cField2D *>( A0_ )->cdata_ );
+    double *phi       = Phi_->data();
+    double *phi_m     = Phi_m->data();
+    double *env_aabs  = EMfields->Env_A_abs_->data();
+    double *env_eabs  = EMfields->Env_E_abs_->data();
+    double *gl        = GradPhil_->data();
+    double *gr        = GradPhir_->data();
+    double *gl_m      = GradPhil_m->data();
+    double *gr_m      = GradPhir_m->data();
+    unsigned int nl = A_->dims_[0], nr = A_->dims_[1];
+    bool isYmin = ( static_cast<ElectroMagnAM *>( EMfields ) )->isYmin;
+    unsigned int jmin = std::max( 3*isYmin, 1 );
+    
+    for( unsigned int i=0 ; i < nl; i++ ) { // l loop
+    
+        // Ponderomotive potential Phi=|A|^2/2, |A| and |E|, at timestep n+1, including ghost cells
+        if( i < nl-1 ) {
+            unsigned int p0 = i*nr;
+            #pragma omp simd
+            for( unsigned int j=0 ; j < nr-1; j++ ) { // r loop
+                unsigned int p = p0+j;
+                double ar = a[2*p], ai = a[2*p+1];
+                double abs_a = sqrt( ar*ar + ai*ai );
+                phi[p]      = abs_a * abs_a * 0.5;
+                env_aabs[p] = abs_a;
+                // |E envelope| = |-(dA/dt-ik0cA)|, forward finite difference for the time derivative
+                double er = ( ar-a0[2*p] )/timestep + ai;
+                double ei = ( ai-a0[2*p+1] )/timestep - ar;
+                env_eabs[p] = sqrt( er*er + ei*ei );
+            } // end r loop
+            if( isYmin && i >= 1 ) { // axis BC on |A| and |E|
+                env_aabs[p0+1] = env_aabs[p0+3];
+                env_aabs[p0]   = env_aabs[p0+4];
+                env_eabs[p0+1] = env_eabs[p0+3];
+                env_eabs[p0]   = env_eabs[p0+4];
+            }
+        }
+        
+        if( i == 0 ) {
+            continue;
+        }
+        unsigned int ic = i-1; // row where Phi is known on both sides
+        unsigned int p0 = ic*nr;
+        
+        // Gradients of Phi
+        if( ic >= 1 ) {
+            #pragma omp simd
+            for( unsigned int j=jmin ; j < nr-1; j++ ) { // r loop
+                unsigned int p = p0+j;
+                gl[p] = ( phi[p+nr]-phi[p-nr] ) * one_ov_2dl;
+                gr[p] = ( phi[p+1]-phi[p-1] ) * one_ov_2dr;
+            } // end r loop
+            if( isYmin ) { // axis BC
+                unsigned int p = p0+2; // j_p=2 corresponds to r=0
+                gl[p] = ( phi[p+nr]-phi[p-nr] ) * one_ov_2dl;
+                // gradient in r direction, identically zero on r = 0
+                gr[p] = 0.;
+                gl[p-1] = gl[p+1];
+                gl[p-2] = gl[p+2];
+                gr[p-1] = gr[p+1];
+                gr[p-2] = gr[p+2];
+            }
+        }
+        
+        // Phi and GradPhi at time n+1/2, from their values at timestep n+1 and n (the latter in Phi_m and GradPhi_m)
+        #pragma omp simd
+        for( unsigned int j=0 ; j < nr-1; j++ ) { // r loop
+            unsigned int p = p0+j;
+            phi_m[p] = 0.5*( phi_m[p]+phi[p] );
+            gl_m[p]  = 0.5*( gl_m[p]+gl[p] );
+            gr_m[p]  = 0.5*( gr_m[p]+gr[p] );
+        } // end r loop
+        
+    } // end l loop
+    
+} // end LaserEnvelopeAM::updatePhiAndGradPhi
+
+
 void LaserEnvelopeAM::savePhiAndGradPhi()
 {
     // Static cast of the fields
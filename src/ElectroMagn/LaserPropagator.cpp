@@ -4,6 +4,8 @@
 #include "Field2D.h"
 #include "Field3D.h"
 #include "H5.h"
+#include "FFT.h"
+#include "Profile.h"
 
 #include <cmath>
 #include <string>
@@ -63,22 +65,8 @@ vector<unsigned int> partial_reverse_argsort( vector<double> x, unsigned int nma
 }
 
 
-// Call a python function
-PyObject *PyCall( PyObject *callable, PyObject *args, PyObject *kwargs )
-{
-    PyObject *a = PyObject_Call( callable, args, kwargs );
-    Py_DECREF( args );
-    if( kwargs ) {
-        Py_DECREF( kwargs );
-    }
-    return a;
-}
-
-
 void LaserPropagator::init( Params *params, SmileiMPI *smpi, unsigned int side )
 {
-
-#ifdef SMILEI_USE_NUMPY
     ndim = params->nDim_field;
     _2D = ndim==2;
     MPI_size = smpi->getSize();
@@ -131,121 +119,119 @@ void LaserPropagator::init( Params *params, SmileiMPI *smpi, unsigned int side )
         fftfreq( local_k[2], N[2], L[2]/N[2], 0, N[2] );
     }
 
-#else
-    ERROR( "Cannot use LaserOffset without numpy" );
-#endif
-
 }
 
 void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profiles_n, double offset, string file, int keep_n_strongest_modes, double angle_z )
 {
-#ifdef SMILEI_USE_NUMPY
     //const complex<double> i_ (0., 1.); // the imaginary number
-
+    
     unsigned int nprofiles = profiles.size();
-
-    // Import several functions from numpy
-    PyObject *numpy = PyImport_AddModule( "numpy" );
-    PyObject *numpyfft = PyObject_GetAttrString( numpy, "fft" );
-    PyObject *fft      = PyObject_GetAttrString( numpyfft, "fft" );
-    PyObject *ifft     = PyObject_GetAttrString( numpyfft, "ifft" );
-    PyObject *fft2     = PyObject_GetAttrString( numpyfft, "fft2" );
-    Py_DECREF( numpyfft );
-    int complex_type_num=0;
-
+    
+    // Local arrays are (y, t) in 2D and (y, z, t) in 3D, distributed along y
+    unsigned int N2 = _2D ? 1 : N[2];
+    unsigned int local_size = Nlocal[0] * N[1] * N2;
+    unsigned int block_size = Nlocal[0] * Nlocal[1] * N2;
+    
+    // Prepare the FFTs along each axis
+    FFT fft0( N[0] ), fft1( N[1] ), fft2( N2 );
+    
     // 1- Calculate the value of the profiles at all points (y,z,t)
     // --------------------------------
-
-    // Make coordinates array
-    vector<PyObject *> coords( ndim );
+    
+    // Make coordinates arrays
+    vector<unsigned int> shape( ndim );
+    shape[0] = Nlocal[0];
+    shape[1] = N[1];
+    if( ! _2D ) {
+        shape[2] = N[2];
+    }
+    vector<Field *> coords( ndim );
+    Field *values;
     for( unsigned int i=0; i<ndim; i++ ) {
-        npy_intp dims = local_x[i].size();
-        coords[i] = PyArray_SimpleNewFromData( 1, &dims, NPY_DOUBLE, ( double * )( local_x[i].data() ) );
+        if( _2D ) {
+            coords[i] = new Field2D( shape );
+        } else {
+            coords[i] = new Field3D( shape );
+        }
     }
-
-    // Make a "meshgrid" using the coordinates
-    PyObject *meshgrid = PyObject_GetAttrString( numpy, "meshgrid" );
-    PyObject *m;
     if( _2D ) {
-        m = PyCall( meshgrid, Py_BuildValue( "(O,O)", coords[0], coords[1] ), Py_BuildValue( "{s:s}", "indexing", "ij" ) );
+        values = new Field2D( shape );
     } else {
-        m = PyCall( meshgrid, Py_BuildValue( "(O,O,O)", coords[0], coords[1], coords[2] ), Py_BuildValue( "{s:s}", "indexing", "ij" ) );
+        values = new Field3D( shape );
     }
-    PyObject *mesh = PySequence_Tuple( m );
-    for( unsigned int i=0; i<ndim; i++ ) {
-        Py_DECREF( coords[i] );
+    #pragma omp parallel for
+    for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+        for( unsigned int k=0; k<N[1]; k++ ) {
+            for( unsigned int l=0; l<N2; l++ ) {
+                unsigned int n = ( j*N[1] + k )*N2 + l;
+                coords[0]->data()[n] = local_x[0][j];
+                coords[1]->data()[n] = local_x[1][k];
+                if( ! _2D ) {
+                    coords[2]->data()[n] = local_x[2][l];
+                }
+            }
+        }
     }
-    Py_DECREF( meshgrid );
-    Py_DECREF( m );
-
+    
     // Apply each profile
-    vector<PyObject *> arrays( nprofiles );
+    vector<vector<complex<double> > > arrays( nprofiles );
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        // Vectorize the profile
-        PyObject *profile = PyObject_CallMethod( numpy, "vectorize", "O", profiles[i] );
-        // Apply to the mesh
-        arrays[i] = PyObject_CallObject( profile, mesh );
-        Py_DECREF( profile );
+        ostringstream name( "" );
+        name << "LaserOffset space_time_profile[" << profiles_n[i]-1 << "]";
+        Profile profile( profiles[i], ndim, name.str(), true );
+        profile.valuesAt( coords, *values );
+        arrays[i].assign( values->data(), values->data() + local_size );
     }
-    Py_DECREF( mesh );
-
+    for( unsigned int i=0; i<ndim; i++ ) {
+        delete coords[i];
+    }
+    delete values;
+    
     // 2- Fourier transform of the fields at destination
     // --------------------------------
-
+    
+    vector<complex<double> > buffer( local_size );
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        PyObject *a;
-
-        // Call FFT along the last direction(s)
-        if( _2D ) {
-            a = PyCall( fft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 1 ) );
-        } else {
-            a = PyCall( fft2, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:(i,i)}", "axes", 1, 2 ) );
-        }
-        Py_DECREF( arrays[i] );
-
-        // Change the array shape to prepare the MPI comms (reshape, transpose, C ordering)
-        npy_intp D[4] = {Nlocal[0], MPI_size, Nlocal[1], N[2]};
-        PyArray_Dims shape;
-        shape.len=ndim+1;
-        shape.ptr=D;
-        arrays[i] = PyArray_Newshape( ( PyArrayObject * )a, &shape, NPY_CORDER );
-        Py_DECREF( a );
-        npy_intp P[4] = {1, 0, 2, 3};
-        PyArray_Dims permute;
-        permute.len=ndim+1;
-        permute.ptr=P;
-        a = PyArray_Transpose( ( PyArrayObject * )arrays[i], &permute );
-        Py_DECREF( arrays[i] );
-        arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-        Py_DECREF( a );
-
-
-        // Obtain the number associated to the complex type in numpy
-        complex_type_num = PyArray_TYPE( ( PyArrayObject * ) arrays[i] );
-
-        // Make a new empty array for MPI comms
-        npy_intp dims[ndim];
-        dims[0] = N[0];
-        dims[1] = Nlocal[1];
+        complex<double> *z = arrays[i].data();
+        
+        // FFT along the last direction(s)
         if( ! _2D ) {
-            dims[2] = N[2];
+            fft2.transform( z, Nlocal[0]*N[1], 1, -1 );
         }
-        a = PyArray_EMPTY( ndim, dims, complex_type_num, 0 );
-
+        fft1.transform( z, Nlocal[0], N2, -1 );
+        
+        // Reorder the blocks to prepare the MPI comms: (y, proc, z, t) -> (proc, y, z, t)
+        unsigned int B = Nlocal[1]*N2;
+        #pragma omp parallel for
+        for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+            for( unsigned int r=0; r<MPI_size; r++ ) {
+                copy( &z[( j*MPI_size + r )*B], &z[( j*MPI_size + r + 1 )*B], &buffer[( r*Nlocal[0] + j )*B] );
+            }
+        }
+        
         // Communicate blocks to transpose the MPI decomposition
-        int block_size = Nlocal[0]*Nlocal[1]* ( _2D?1:N[2] );
         MPI_Alltoall(
-            PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 ), 2*block_size, MPI_DOUBLE,
-            PyArray_GETPTR1( ( PyArrayObject * ) a, 0 ), 2*block_size, MPI_DOUBLE,
+            buffer.data(), 2*block_size, MPI_DOUBLE,
+            z, 2*block_size, MPI_DOUBLE,
             MPI_COMM_WORLD
         );
-        Py_DECREF( arrays[i] );
-
-        // Call FFT along the first direction
-        arrays[i] = PyCall( fft, Py_BuildValue( "(O)", a ), Py_BuildValue( "{s:i}", "axis", 0 ) );
-        Py_DECREF( a );
+        
+        // Transpose (y, z, t) so that y is contiguous
+        #pragma omp parallel for
+        for( unsigned int l=0; l<N2; l++ ) {
+            for( unsigned int k=0; k<Nlocal[1]; k++ ) {
+                for( unsigned int j=0; j<N[0]; j++ ) {
+                    buffer[j + N[0]*( k + Nlocal[1]*l )] = z[( j*Nlocal[1] + k )*N2 + l];
+                }
+            }
+        }
+        arrays[i].swap( buffer );
+        
+        // FFT along the first direction
+        fft0.transform( arrays[i].data(), B, 1, -1 );
     }
-
+    buffer.clear();
+    
     // 3- Select only interesting omegas
     // --------------------------------
 
@@ -255,7 +241,7 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
         // Compute the spectrum locally
         vector<double> local_spectrum( Nlocal[1], 0. );
         for( unsigned int i=0; i<nprofiles; i++ ) {
-            complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
+            complex<double> *z = arrays[i].data();
             for( unsigned int k=0; k<Nlocal[1]; k++ )
                 for( unsigned int j=0; j<N[0]; j++ ) {
                     local_spectrum[k] += abs( z[j + N[0]*k] );
@@ -277,7 +263,7 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
         unsigned int lmax = N[2]/2;
         vector<double> local_spectrum( lmax, 0. );
         for( unsigned int i=0; i<nprofiles; i++ ) {
-            complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
+            complex<double> *z = arrays[i].data();
             for( unsigned int l=0; l<lmax; l++ )
                 for( unsigned int k=0; k<Nlocal[1]; k++ )
                     for( unsigned int j=0; j<N[0]; j++ ) {
@@ -364,11 +350,11 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
     // Interpolate arrays on new k space
     double omega2;
     for( unsigned int i=0; i<nprofiles; i++ ) {
+        complex<double> *z0 = arrays[i].data();
         if( _2D ) {
-            npy_intp dims[2] = {N[0], n_omega_local};
-            PyObject *a = PyArray_New( &PyArray_Type, 2, dims, complex_type_num, NULL, NULL, 128, NPY_ARRAY_F_CONTIGUOUS, NULL );
-            complex<double> *z0 = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
-            complex<double> *z  = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) a, 0 );
+            vector<complex<double> > a( N[0]*n_omega_local );
+            complex<double> *z = a.data();
+            #pragma omp parallel for private( omega2, i1, i0, kx, j_ )
             for( unsigned int k=0; k<n_omega_local; k++ ) {
                 omega2 = omega[k] * omega[k];
                 i1 = N[0]*k;
@@ -393,16 +379,14 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
                     }
                 }
             }
-            Py_DECREF( arrays[i] );
-            arrays[i] = a;
+            arrays[i].swap( a );
         } else {
-            npy_intp dims[3] = {N[0], Nlocal[1], n_omega_local};
-            PyObject *a = PyArray_New( &PyArray_Type, 3, dims, complex_type_num, NULL, NULL, 128, NPY_ARRAY_F_CONTIGUOUS, NULL );
-            complex<double> *z0 = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
-            complex<double> *z  = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) a, 0 );
+            vector<complex<double> > a( N[0]*Nlocal[1]*n_omega_local );
+            complex<double> *z = a.data();
+            #pragma omp parallel for collapse( 2 ) private( omega2, i1, i0, kx, j_ )
             for( unsigned int l=0; l<n_omega_local; l++ ) {
-                omega2 = omega[l] * omega[l];
                 for( unsigned int k=0; k<Nlocal[1]; k++ ) {
+                    omega2 = omega[l] * omega[l];
                     i1 = N[0]*( k + Nlocal[1]*l );
                     i0 = N[0]*( k + Nlocal[1]*indices[l] );
                     for( unsigned int j=0; j<N[0]; j++ ) {
@@ -426,90 +410,79 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
                     }
                 }
             }
-            Py_DECREF( arrays[i] );
-            arrays[i] = a;
+            arrays[i].swap( a );
         }
     }
-
+    
     // 5- Fourier transform back to real space, excluding the omega axis
     // --------------------------------
-
+    
+    unsigned int Nk = _2D ? 1 : Nlocal[1];
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        PyObject *a;
-
-        // Call FFT along the first direction
-        a = PyCall( ifft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 0 ) );
-        Py_DECREF( arrays[i] );
-
-        // Convert the array to C order
-        arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-        Py_DECREF( a );
-
-        if( ! _2D ) {
-
-            // Make a new empty array for MPI comms
-            npy_intp dims[4];
-            dims[0] = MPI_size;
-            dims[1] = Nlocal[0];
-            dims[2] = Nlocal[1];
-            dims[3] = n_omega_local;
-            a = PyArray_EMPTY( 4, dims, complex_type_num, 0 );
-
+        
+        // FFT along the first direction
+        fft0.transform( arrays[i].data(), Nk*n_omega_local, 1, 1 );
+        
+        // Convert the array to C order (y, z, omega)
+        vector<complex<double> > a( arrays[i].size() );
+        complex<double> *z = arrays[i].data();
+        #pragma omp parallel for
+        for( unsigned int j=0; j<N[0]; j++ ) {
+            for( unsigned int k=0; k<Nk; k++ ) {
+                for( unsigned int l=0; l<n_omega_local; l++ ) {
+                    a[( j*Nk + k )*n_omega_local + l] = z[j + N[0]*( k + Nk*l )];
+                }
+            }
+        }
+        
+        if( _2D ) {
+            arrays[i].swap( a );
+        } else {
+        
             // Communicate blocks to transpose the MPI decomposition
             int block_size = Nlocal[0]*Nlocal[1]*n_omega_local;
             MPI_Alltoall(
-                PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 ), 2*block_size, MPI_DOUBLE,
-                PyArray_GETPTR1( ( PyArrayObject * ) a, 0 ), 2*block_size, MPI_DOUBLE,
+                a.data(), 2*block_size, MPI_DOUBLE,
+                z, 2*block_size, MPI_DOUBLE,
                 MPI_COMM_WORLD
             );
-            Py_DECREF( arrays[i] );
-
-            // Change the array shape to accomodate the MPI comms
-            npy_intp P[4] = {1, 0, 2, 3};
-            PyArray_Dims permute;
-            permute.len=4;
-            permute.ptr=P;
-            arrays[i] = PyArray_Transpose( ( PyArrayObject * )a, &permute );
-            Py_DECREF( a );
-            npy_intp D[3] = {Nlocal[0], N[1], n_omega_local};
-            PyArray_Dims shape;
-            shape.len=3;
-            shape.ptr=D;
-            a = PyArray_Newshape( ( PyArrayObject * )arrays[i], &shape, NPY_CORDER );
-            Py_DECREF( arrays[i] );
-            arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-            Py_DECREF( a );
-
-            // Call FFT along the second direction
-            a = PyCall( ifft, Py_BuildValue( "(O)", arrays[i] ), Py_BuildValue( "{s:i}", "axis", 1 ) );
-            Py_DECREF( arrays[i] );
-
-            // Convert the array to C order
-            arrays[i] = PyArray_FROM_OF( a, NPY_ARRAY_C_CONTIGUOUS );
-            Py_DECREF( a );
+            
+            // Reorder the blocks after the MPI comms: (proc, y, z, omega) -> (y, proc, z, omega)
+            unsigned int B = Nlocal[1]*n_omega_local;
+            #pragma omp parallel for
+            for( unsigned int j=0; j<Nlocal[0]; j++ ) {
+                for( unsigned int r=0; r<MPI_size; r++ ) {
+                    copy( &z[( r*Nlocal[0] + j )*B], &z[( r*Nlocal[0] + j + 1 )*B], &a[( j*MPI_size + r )*B] );
+                }
+            }
+            arrays[i].swap( a );
+            
+            // FFT along the second direction
+            fft1.transform( arrays[i].data(), Nlocal[0], n_omega_local, 1 );
         }
     }
-
+    
     // 6- Obtain the magnitude and the phase of the complex values
     // --------------------------------
-    unsigned int local_size = ( _2D ? N[0] : Nlocal[0]*N[1] ) * n_omega_local;
+    local_size = ( _2D ? N[0] : Nlocal[0]*N[1] ) * n_omega_local;
     vector<vector<double> > magnitude( nprofiles ), phase( nprofiles );
-
+    
     for( unsigned int i=0; i<nprofiles; i++ ) {
-        complex<double> *z = ( complex<double> * ) PyArray_GETPTR1( ( PyArrayObject * ) arrays[i], 0 );
+        complex<double> *z = arrays[i].data();
         magnitude[i].resize( local_size );
         phase    [i].resize( local_size );
         double coeff_magnitude = 2./N[ndim-1]; // multiply by omega increment
         if( profiles_n[i]==1 ) {
             coeff_magnitude *= cz;    // multiply by cosine for By only
         }
+        #pragma omp parallel for
         for( unsigned int j=0; j<local_size; j++ ) {
             magnitude[i][j] = abs( z[j] ) * coeff_magnitude;
             phase    [i][j] = arg( z[j] );
         }
-        Py_DECREF( arrays[i] );
+        arrays[i].clear();
     }
-
+    
     // 7- Store all info in HDF5 file
     // --------------------------------
 
@@ -587,10 +560,5 @@ void LaserPropagator::operator()( vector<PyObject *> profiles, vector<int> profi
     H5Pclose( dcid );
     H5Pclose( transfer );
     H5Fclose( fid );
-
-    Py_DECREF( fft );
-    Py_DECREF( ifft );
-    Py_DECREF( fft2 );
-
-#endif
+    
 }
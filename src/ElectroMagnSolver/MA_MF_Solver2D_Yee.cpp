@@ -0,0 +1,53 @@
+
+#include "MA_MF_Solver2D_Yee.h"
+
+#include "ElectroMagn.h"
+#include "Field2D.h"
+
+#include <algorithm>
+#include <cstring>
+
+MA_MF_Solver2D_Yee::MA_MF_Solver2D_Yee( Params &params )
+    : Solver2D( params ), MA_solver_( params ), MF_solver_( params )
+{
+    // A tile holds the 12 fields E, B, B_m and J, and should fit in a 512 kB cache
+    tile_size_ = std::max( 1u, ( unsigned int )( 524288 / ( 12*ny_d*sizeof( double ) ) ) );
+}
+
+MA_MF_Solver2D_Yee::~MA_MF_Solver2D_Yee()
+{
+}
+
+void MA_MF_Solver2D_Yee::operator()( ElectroMagn *fields )
+{
+    // Static-cast of the fields
+    Field2D *Bx   = static_cast<Field2D *>( fields->Bx_ );
+    Field2D *By   = static_cast<Field2D *>( fields->By_ );
+    Field2D *Bz   = static_cast<Field2D *>( fields->Bz_ );
+    Field2D *Bx_m = static_cast<Field2D *>( fields->Bx_m );
+    Field2D *By_m = static_cast<Field2D *>( fields->By_m );
+    Field2D *Bz_m = static_cast<Field2D *>( fields->Bz_m );
+    
+    // Tiles are treated in increasing x:
+    // E at plane i needs B at planes i and i+1 (not yet updated),
+    // B at plane i needs E at planes i-1 and i (already updated)
+    for( unsigned int istart=0 ; istart<nx_d ; istart+=tile_size_ ) {
+        unsigned int iend = std::min( istart+tile_size_, nx_d );
+        
+        // Magnetic fields saved on the planes of the tile (stores B at time n in B_m)
+        for( unsigned int i=istart ; i<std::min( iend, nx_p ) ; i++ ) {
+            memcpy( &( ( *Bx_m )( i, 0 ) ), &( ( *Bx )( i, 0 ) ), ny_d*sizeof( double ) );
+        }
+        for( unsigned int i=istart ; i<std::min( iend, nx_d ) ; i++ ) {
+            memcpy( &( ( *By_m )( i, 0 ) ), &( ( *By )( i, 0 ) ), ny_p*sizeof( double ) );
+            memcpy( &( ( *Bz_m )( i, 0 ) ), &( ( *Bz )( i, 0 ) ), ny_d*sizeof( double ) );
+        }
+        
+        // Computes Ex_, Ey_, Ez_ on the planes of the tile
+        MA_solver_.solvePlanes( fields, istart, iend );
+        
+        // Computes Bx_, By_, Bz_ at time n+1 on the planes of the tile
+        MF_solver_.solvePlanes( fields, istart, iend );
+    }
+}
+
@@ -0,0 +1,53 @@
+
+#include "MA_MF_Solver3D_Yee.h"
+
+#include "ElectroMagn.h"
+#include "Field3D.h"
+
+#include <algorithm>
+#include <cstring>
+
+MA_MF_Solver3D_Yee::MA_MF_Solver3D_Yee( Params &params )
+    : Solver3D( params ), MA_solver_( params ), MF_solver_( params )
+{
+    // A tile holds the 12 fields E, B, B_m and J, and should fit in a 512 kB cache
+    tile_size_ = std::max( 1u, ( unsigned int )( 524288 / ( 12*ny_d*nz_d*sizeof( double ) ) ) );
+}
+
+MA_MF_Solver3D_Yee::~MA_MF_Solver3D_Yee()
+{
+}
+
+void MA_MF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    // Static-cast of the fields
+    Field3D *Bx   = static_cast<Field3D *>( fields->Bx_ );
+    Field3D *By   = static_cast<Field3D *>( fields->By_ );
+    Field3D *Bz   = static_cast<Field3D *>( fields->Bz_ );
+    Field3D *Bx_m = static_cast<Field3D *>( fields->Bx_m );
+    Field3D *By_m = static_cast<Field3D *>( fields->By_m );
+    Field3D *Bz_m = static_cast<Field3D *>( fields->Bz_m );
+    
+    // Tiles are treated in increasing x:
+    // E at plane i needs B at planes i and i+1 (not yet updated),
+    // B at plane i needs E at planes i-1 and i (already updated)
+    for( unsigned int istart=0 ; istart<nx_d ; istart+=tile_size_ ) {
+        unsigned int iend = std::min( istart+tile_size_, nx_d );
+        
+        // Magnetic fields saved on the planes of the tile (stores B at time n in B_m)
+        for( unsigned int i=istart ; i<std::min( iend, nx_p ) ; i++ ) {
+            memcpy( &( ( *Bx_m )( i, 0, 0 ) ), &( ( *Bx )( i, 0, 0 ) ), ny_d*nz_d*sizeof( double ) );
+        }
+        for( unsigned int i=istart ; i<std::min( iend, nx_d ) ; i++ ) {
+            memcpy( &( ( *By_m )( i, 0, 0 ) ), &( ( *By )( i, 0, 0 ) ), ny_p*nz_d*sizeof( double ) );
+            memcpy( &( ( *Bz_m )( i, 0, 0 ) ), &( ( *Bz )( i, 0, 0 ) ), ny_d*nz_p*sizeof( double ) );
+        }
+        
+        // Computes Ex_, Ey_, Ez_ on the planes of the tile
+        MA_solver_.solvePlanes( fields, istart, iend );
+        
+        // Computes Bx_, By_, Bz_ at time n+1 on the planes of the tile
+        MF_solver_.solvePlanes( fields, istart, iend );
+    }
+}
+
@@ -0,0 +1,37 @@
+#ifndef MA_MF_SOLVER3D_YEE_H
+#define MA_MF_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+#include "MA_Solver3D_norm.h"
+#include "MF_Solver3D_Yee.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MA_MF_Solver3D_Yee
+//! Fused Maxwell solver: saves B, solves Maxwell-Ampere and Maxwell-Faraday (Yee)
+//! tile by tile, each tile being a slab of consecutive planes along x,
+//! so that the fields of a tile are still in cache for the three updates
+//  --------------------------------------------------------------------------------------------------------------------
+class MA_MF_Solver3D_Yee : public Solver3D
+{
+
+public:
+    //! Creator for MA_MF_Solver3D_Yee
+    MA_MF_Solver3D_Yee( Params &params );
+    virtual ~MA_MF_Solver3D_Yee();
+    
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn *fields );
+
+protected:
+    //! Maxwell-Ampere solver applied on each tile
+    MA_Solver3D_norm MA_solver_;
+    //! Maxwell-Faraday solver applied on each tile
+    MF_Solver3D_Yee MF_solver_;
+    //! Number of planes along x in a tile
+    unsigned int tile_size_;
+
+};//END class
+
+#endif
+
@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
+#include <algorithm>
+
 MA_Solver3D_norm::MA_Solver3D_norm( Params &params )
     : Solver3D( params )
 {
@@ -14,6 +16,11 @@ MA_Solver3D_norm::~MA_Solver3D_norm()
 }
 
 void MA_Solver3D_norm::operator()( ElectroMagn *fields )
+{
+    solvePlanes( fields, 0, nx_d );
+}
+
+void MA_Solver3D_norm::solvePlanes( ElectroMagn *fields, unsigned int istart, unsigned int iend )
 {
 
     // Static-cast of the fields
@@ -28,8 +35,9 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     Field3D *Jz3D = static_cast<Field3D *>( fields->Jz_ );
     
     // Electric field Ex^(d,p,p)
-    for( unsigned int i=0 ; i<nx_d ; i++ ) {
+    for( unsigned int i=istart ; i<std::min( iend, nx_d ) ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
                 ( *Ex3D )( i, j, k ) += -dt*( *Jx3D )( i, j, k )
                                         +                 dt_ov_dy * ( ( *Bz3D )( i, j+1, k ) - ( *Bz3D )( i, j, k ) )
@@ -39,8 +47,9 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     }
     
     // Electric field Ey^(p,d,p)
-    for( unsigned int i=0 ; i<nx_p ; i++ ) {
+    for( unsigned int i=istart ; i<std::min( iend, nx_p ) ; i++ ) {
         for( unsigned int j=0 ; j<ny_d ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
                 ( *Ey3D )( i, j, k ) += -dt*( *Jy3D )( i, j, k )
                                         -                  dt_ov_dx * ( ( *Bz3D )( i+1, j, k ) - ( *Bz3D )( i, j, k ) )
@@ -50,8 +59,9 @@ void MA_Solver3D_norm::operator()( ElectroMagn *fields )
     }
     
     // Electric field Ez^(p,p,d)
-    for( unsigned int i=0 ;  i<nx_p ; i++ ) {
+    for( unsigned int i=istart ;  i<std::min( iend, nx_p ) ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_d ; k++ ) {
                 ( *Ez3D )( i, j, k ) += -dt*( *Jz3D )( i, j, k )
                                         +                  dt_ov_dx * ( ( *By3D )( i+1, j, k ) - ( *By3D )( i, j, k ) )
@@ -17,6 +17,9 @@ public:
     //! Overloading of () operator
     virtual void operator()( ElectroMagn *fields );
     
+    //! Update the electric fields only on the planes istart <= i < iend
+    void solvePlanes( ElectroMagn *fields, unsigned int istart, unsigned int iend );
+    
 protected:
 
 };//END class
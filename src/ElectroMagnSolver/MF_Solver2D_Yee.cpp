@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field2D.h"
 
+#include <algorithm>
+
 MF_Solver2D_Yee::MF_Solver2D_Yee( Params &params )
     : Solver2D( params )
 {
@@ -18,6 +20,11 @@ MF_Solver2D_Yee::~MF_Solver2D_Yee()
 }
 
 void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
+{
+    solvePlanes( fields, 0, nx_d );
+}
+
+void MF_Solver2D_Yee::solvePlanes( ElectroMagn *fields, unsigned int istart, unsigned int iend )
 {
     // Static-cast of the fields
     Field2D *Ex2D;
@@ -35,38 +42,30 @@ void MF_Solver2D_Yee::operator()( ElectroMagn *fields )
     Field2D *Bz2D = static_cast<Field2D *>( fields->Bz_ );
     
     // Magnetic field Bx^(p,d)
-    //cout << "nx_p,nx_d-1" << nx_p << " " << nx_d-1 ;
-    //{
-    {
+    if( istart == 0 ) {
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
             ( *Bx2D )( 0, j ) -= dt_ov_dy * ( ( *Ez2D )( 0, j ) - ( *Ez2D )( 0, j-1 ) );
         }
     }
-    //    for (unsigned int i=0 ; i<nx_p;  i++) {
-    for( unsigned int i=1 ; i<nx_d-1;  i++ ) {
+    for( unsigned int i=std::max( istart, 1u ) ; i<std::min( iend, nx_d-1 );  i++ ) {
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
             ( *Bx2D )( i, j ) -= dt_ov_dy * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i, j-1 ) );
         }
-        //    }
         
         // Magnetic field By^(d,p)
-        //    for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
             ( *By2D )( i, j ) += dt_ov_dx * ( ( *Ez2D )( i, j ) - ( *Ez2D )( i-1, j ) );
         }
-        //}
         
         // Magnetic field Bz^(d,d)
-        //for (unsigned int i=1 ; i<nx_d-1 ; i++) {
         #pragma omp simd
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
             ( *Bz2D )( i, j ) += dt_ov_dy * ( ( *Ex2D )( i, j ) - ( *Ex2D )( i, j-1 ) )
                                  -               dt_ov_dx * ( ( *Ey2D )( i, j ) - ( *Ey2D )( i-1, j ) );
         }
     }
-    //}// end parallel
 }
 
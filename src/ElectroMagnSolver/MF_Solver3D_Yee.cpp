@@ -4,6 +4,8 @@
 #include "ElectroMagn.h"
 #include "Field3D.h"
 
+#include <algorithm>
+
 MF_Solver3D_Yee::MF_Solver3D_Yee( Params &params )
     : Solver3D( params )
 {
@@ -14,6 +16,11 @@ MF_Solver3D_Yee::~MF_Solver3D_Yee()
 }
 
 void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
+{
+    solvePlanes( fields, 0, nx_d );
+}
+
+void MF_Solver3D_Yee::solvePlanes( ElectroMagn *fields, unsigned int istart, unsigned int iend )
 {
     // Static-cast of the fields
     Field3D *Ex3D = static_cast<Field3D *>( fields->Ex_ );
@@ -24,8 +31,9 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     Field3D *Bz3D = static_cast<Field3D *>( fields->Bz_ );
     
     // Magnetic field Bx^(p,d,d)
-    for( unsigned int i=0 ; i<nx_p;  i++ ) {
+    for( unsigned int i=istart ; i<std::min( iend, nx_p );  i++ ) {
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
                 ( *Bx3D )( i, j, k ) += -dt_ov_dy * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i, j-1, k ) ) + dt_ov_dz * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i, j, k-1 ) );
             }
@@ -33,8 +41,9 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     }
     
     // Magnetic field By^(d,p,d)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
+    for( unsigned int i=std::max( istart, 1u ) ; i<std::min( iend, nx_d-1 ) ; i++ ) {
         for( unsigned int j=0 ; j<ny_p ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=1 ; k<nz_d-1 ; k++ ) {
                 ( *By3D )( i, j, k ) += -dt_ov_dz * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j, k-1 ) ) + dt_ov_dx * ( ( *Ez3D )( i, j, k ) - ( *Ez3D )( i-1, j, k ) );
             }
@@ -42,8 +51,9 @@ void MF_Solver3D_Yee::operator()( ElectroMagn *fields )
     }
     
     // Magnetic field Bz^(d,d,p)
-    for( unsigned int i=1 ; i<nx_d-1 ; i++ ) {
+    for( unsigned int i=std::max( istart, 1u ) ; i<std::min( iend, nx_d-1 ) ; i++ ) {
         for( unsigned int j=1 ; j<ny_d-1 ; j++ ) {
+            #pragma omp simd
             for( unsigned int k=0 ; k<nz_p ; k++ ) {
                 ( *Bz3D )( i, j, k ) += -dt_ov_dx * ( ( *Ey3D )( i, j, k ) - ( *Ey3D )( i-1, j, k ) ) + dt_ov_dy * ( ( *Ex3D )( i, j, k ) - ( *Ex3D )( i, j-1, k ) );
             }
@@ -15,6 +15,8 @@
 #include "MF_Solver2D_Cowan.h"
 #include "MF_Solver2D_Lehe.h"
 #include "MF_Solver3D_Lehe.h"
+#include "MA_MF_Solver2D_Yee.h"
+#include "MA_MF_Solver3D_Yee.h"
 
 #include "PXR_Solver2D_GPSTD.h"
 #include "PXR_Solver3D_FDTD.h"
@@ -133,6 +135,24 @@ public:
         return solver;
     };
     
+    // Create the fused Maxwell solver (saving B, Maxwell-Ampere and Maxwell-Faraday)
+    // NULL if not requested: the solvers are then called separately
+    // -----------------------------
+    static Solver *createFused( Params &params )
+    {
+        Solver *solver = NULL;
+        
+        if( params.fused_maxwell_solver ) {
+            if( params.geometry == "2Dcartesian" ) {
+                solver = new MA_MF_Solver2D_Yee( params );
+            } else if( params.geometry == "3Dcartesian" ) {
+                solver = new MA_MF_Solver3D_Yee( params );
+            }
+        }
+        
+        return solver;
+    };
+    
 };
 
 #endif
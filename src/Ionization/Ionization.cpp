@@ -1,6 +1,9 @@
 #include "Ionization.h"
 #include "Species.h"
 
+using namespace std;
+
+
 Ionization::Ionization( Params &params, Species *species )
 {
 
@@ -25,3 +28,36 @@ Ionization::Ionization( Params &params, Species *species )
 Ionization::~Ionization()
 {
 }
+
+
+// Create the electrons of all ionized ions, reserving them in bulk
+// (variable weights are used)
+void Ionization::createElectrons( Particles *particles )
+{
+    unsigned int nionized = ionized_index_.size();
+    
+    // One electron per ionized ion, with a weight multiplied by the number of ionizations
+    vector<unsigned int> first_new( nionized, 1 );
+    if( new_electrons.prepareEmission( first_new ) == 0 ) {
+        return;
+    }
+    
+    for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
+        for( unsigned int iion=0 ; iion<nionized; iion++ ) {
+            new_electrons.position( i, first_new[iion] ) = particles->position( i, ionized_index_[iion] );
+        }
+    }
+    for( unsigned int i=0; i<3; i++ ) {
+        for( unsigned int iion=0 ; iion<nionized; iion++ ) {
+            new_electrons.momentum( i, first_new[iion] ) = particles->momentum( i, ionized_index_[iion] )*ionized_species_invmass;
+        }
+    }
+    for( unsigned int iion=0 ; iion<nionized; iion++ ) {
+        unsigned int ipart = ionized_index_[iion];
+        new_electrons.weight( first_new[iion] ) = double( ionized_k_times_[iion] )*particles->weight( ipart );
+        new_electrons.charge( first_new[iion] ) = -1;
+        
+        // Increase the charge of the particle
+        particles->charge( ipart ) += ionized_k_times_[iion];
+    }
+}
@@ -39,6 +39,13 @@ protected:
     unsigned int nDim_particle;
     double ionized_species_invmass;
     
+    //! Ions ionized during the current call, and their number of ionization events
+    std::vector<unsigned int> ionized_index_, ionized_k_times_;
+    
+    //! Create the electrons of all ionized ions at once (two-phase emission)
+    //! and increase the charge of these ions
+    void createElectrons( Particles *particles );
+    
 private:
 
 
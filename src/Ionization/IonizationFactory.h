@@ -3,6 +3,7 @@
 
 #include "Ionization.h"
 #include "IonizationTunnel.h"
+#include "IonizationTunnelV.h"
 #include "IonizationFromRate.h"
 
 #include "Params.h"
@@ -26,7 +27,11 @@ public:
                 ERROR( "Charge > atomic_number for species " << species->name_ );
             }
             
-            Ionize = new IonizationTunnel( params, species );
+            if( params.vectorization_mode == "off" ) {
+                Ionize = new IonizationTunnel( params, species );
+            } else {
+                Ionize = new IonizationTunnelV( params, species );
+            }
             
         } else if( model == "from_rate" ) {
             
@@ -62,6 +62,9 @@ void IonizationFromRate::operator()( Particles *particles, unsigned int ipart_mi
 #endif
     
     
+    ionized_index_.resize( 0 );
+    ionized_k_times_.resize( 0 );
+    
     for( unsigned int ipart=ipart_min ; ipart<ipart_max; ipart++ ) {
     
         // Current charge state of the ion
@@ -80,26 +83,15 @@ void IonizationFromRate::operator()( Particles *particles, unsigned int ipart_mi
             k_times        = 1;
         }
         
-        // Creation of the new electrons
-        // (variable weights are used)
-        // -----------------------------
+        // The new electrons are created after the loop, all at once
         if( k_times!=0 ) {
-            new_electrons.createParticle();
-            //new_electrons.initialize( new_electrons.size()+1, new_electrons.dimension() );
-            int idNew = new_electrons.size() - 1;
-            for( unsigned int i=0; i<new_electrons.dimension(); i++ ) {
-                new_electrons.position( i, idNew )=particles->position( i, ipart );
-            }
-            for( unsigned int i=0; i<3; i++ ) {
-                new_electrons.momentum( i, idNew ) = particles->momentum( i, ipart )*ionized_species_invmass;
-            }
-            new_electrons.weight( idNew )=double( k_times )*particles->weight( ipart );
-            new_electrons.charge( idNew )=-1;
-            
-            // Increase the charge of the particle
-            particles->charge( ipart ) += k_times;
+            ionized_index_.push_back( ipart );
+            ionized_k_times_.push_back( k_times );
         }
         
         
     } // Loop on particles
+    
+    // Creation of the new electrons
+    createElectrons( particles );
 }
@@ -0,0 +1,210 @@
+#include "IonizationTunnelV.h"
+#include "IonizationTables.h"
+
+#include <cmath>
+
+#include "Particles.h"
+#include "Species.h"
+
+using namespace std;
+
+
+
+IonizationTunnelV::IonizationTunnelV( Params &params, Species *species ) : Ionization( params, species )
+{
+    DEBUG( "Creating the vectorized Tunnel Ionizaton class" );
+    
+    atomic_number_          = species->atomic_number_;
+    
+    // Ionization potential & quantum numbers (all in atomic units 1 au = 27.2116 eV)
+    Potential.resize( atomic_number_ );
+    Azimuthal_quantum_number.resize( atomic_number_ );
+    for( int Zstar=0; Zstar<( int )atomic_number_; Zstar++ ) {
+        Potential               [Zstar] = IonizationTables::ionization_energy( atomic_number_, Zstar ) * eV_to_au;
+        Azimuthal_quantum_number[Zstar] = IonizationTables::azimuthal_atomic_number( atomic_number_, Zstar );
+    }
+    
+    one_third = 1.0/3.0;
+    
+    alpha_tunnel.resize( atomic_number_ );
+    beta_tunnel.resize( atomic_number_ );
+    gamma_tunnel.resize( atomic_number_ );
+    
+    for( unsigned int Z=0 ; Z<atomic_number_ ; Z++ ) {
+        double cst      = ( ( double )Z+1.0 ) * sqrt( 2.0/Potential[Z] );
+        alpha_tunnel[Z] = cst-1.0;
+        beta_tunnel[Z]  = pow( 2, alpha_tunnel[Z] ) * ( 8.*Azimuthal_quantum_number[Z]+4.0 ) / ( cst*tgamma( cst ) ) * Potential[Z] * au_to_w0;
+        gamma_tunnel[Z] = 2.0 * pow( 2.0*Potential[Z], 1.5 );
+    }
+    
+    // Tabulate the rates on a log(E) grid.
+    // Below 1e-3 a.u. (5e8 V/m), all rates are negligible (< 1e-40 in code units).
+    // Above 1e4 a.u., the exact formula is used.
+    log_E_min_ = log( 1.e-3 );
+    log_E_max_ = log( 1.e4 );
+    double delta_log_E = ( log_E_max_ - log_E_min_ ) / ( double )( table_size_-1 );
+    inv_delta_log_E_ = 1. / delta_log_E;
+    rate_table_.resize( ( atomic_number_+1 ) * table_size_, 0. );
+    for( unsigned int Z=0 ; Z<atomic_number_ ; Z++ ) {
+        for( int i=0; i<table_size_; i++ ) {
+            rate_table_[Z*table_size_+i] = rate( Z, exp( -log_E_min_ - i*delta_log_E ) );
+        }
+    }
+    
+    DEBUG( "Finished Creating the vectorized Tunnel Ionizaton class" );
+
+}
+
+
+
+void IonizationTunnelV::operator()( Particles *particles, unsigned int ipart_min, unsigned int ipart_max, vector<double> *Epart, Patch *patch, Projector *Proj, int ipart_ref )
+{
+    
+    unsigned int npart = ipart_max - ipart_min;
+    if( npart == 0 ) {
+        return;
+    }
+    
+    int nparts = Epart->size()/3;
+    double *Ex = &( ( *Epart )[0*nparts] );
+    double *Ey = &( ( *Epart )[1*nparts] );
+    double *Ez = &( ( *Epart )[2*nparts] );
+    
+    E_buffer_            .resize( npart );
+    rate_buffer_         .resize( npart );
+    no_ionization_buffer_.resize( npart );
+    double *E_buf             = &E_buffer_[0];
+    double *rate_buf          = &rate_buffer_[0];
+    double *no_ionization_buf = &no_ionization_buffer_[0];
+    short  *charge            = &( particles->Charge[ipart_min] );
+    const double *table       = &rate_table_[0];
+    int Zmax = atomic_number_;
+    
+    // First pass (SIMD): field amplitude, tabulated rate of the first ionization
+    // and probability of no ionization during the timestep
+    #pragma omp simd
+    for( unsigned int i=0 ; i<npart; i++ ) {
+        int ifield = ipart_min + i - ipart_ref;
+        int Z = charge[i];
+        double E = EC_to_au * sqrt( Ex[ifield]*Ex[ifield] + Ey[ifield]*Ey[ifield] + Ez[ifield]*Ez[ifield] );
+        // Particles already fully ionized, or without field, are skipped
+        E = ( Z < Zmax && E >= 1e-10 ) ? E : 0.;
+        E_buf[i] = E;
+        double x = ( log( E + 1e-300 ) - log_E_min_ ) * inv_delta_log_E_;
+        double xc = std::min( std::max( x, 0. ), ( double )( table_size_-2 ) );
+        int ix = ( int )xc;
+        double w = xc - ix;
+        double r = table[Z*table_size_+ix]*( 1.-w ) + table[Z*table_size_+ix+1]*w;
+        // Negative rate means out of the table: computed exactly in the next pass
+        r = x < 0. ? 0. : r;
+        r = x > ( double )( table_size_-1 ) ? -1. : r;
+        rate_buf[i] = r;
+        no_ionization_buf[i] = exp( -std::max( r, 0. )*dt );
+    }
+    
+    // Second pass (scalar): Monte-Carlo test of the first ionization
+    // The random numbers are drawn in the same order as in the scalar version
+    multiple_index_.resize( 0 );
+    multiple_random_.resize( 0 );
+    ionized_index_.resize( 0 );
+    ionized_k_times_.resize( 0 );
+    ionized_potential_.resize( 0 );
+    for( unsigned int i=0 ; i<npart; i++ ) {
+        if( E_buf[i] == 0. ) {
+            continue;
+        }
+        double ran_p = patch->rand_->uniform();
+        unsigned int Z = charge[i];
+        if( rate_buf[i] < 0. ) {
+            rate_buf[i] = rate( Z, 1./E_buf[i] );
+            no_ionization_buf[i] = exp( -rate_buf[i]*dt );
+        }
+        if( Z+1 == atomic_number_ ) {
+            // ionization of the last electron: single ionization
+            if( ran_p < 1.0 - no_ionization_buf[i] ) {
+                ionized_index_    .push_back( ipart_min+i );
+                ionized_k_times_  .push_back( 1 );
+                ionized_potential_.push_back( Potential[Z] );
+            }
+        } else if( no_ionization_buf[i] < ran_p ) {
+            // at least one ionization: multiple ionization handled in the next pass
+            multiple_index_ .push_back( i );
+            multiple_random_.push_back( ran_p );
+        }
+    }
+    
+    // Third pass (compacted): multiple ionization can occur in one time-step
+    // partial & final ionization are decoupled (see Nuter Phys. Plasmas)
+    vector<double> IonizRate_tunnel( atomic_number_ ), Dnom_tunnel( atomic_number_ );
+    for( unsigned int icand=0 ; icand<multiple_index_.size(); icand++ ) {
+        unsigned int i = multiple_index_[icand];
+        double ran_p = multiple_random_[icand];
+        unsigned int Z = charge[i];
+        unsigned int Zp1 = Z+1;
+        double invE = 1./E_buf[i];
+        double TotalIonizPot = 0.0;
+        unsigned int k_times = 0;
+        
+        IonizRate_tunnel[Z] = rate_buf[i];
+        double Mult = 1.0;
+        Dnom_tunnel[0] = 1.0;
+        double Pint_tunnel = no_ionization_buf[i]; // cummulative prob.
+        
+        //multiple ionization loop while Pint_tunnel < ran_p and still partial ionization
+        while( ( Pint_tunnel < ran_p ) and ( k_times < atomic_number_-Zp1 ) ) {
+            unsigned int newZ = Zp1+k_times;
+            IonizRate_tunnel[newZ] = rate( newZ, invE );
+            double D_sum = 0.0;
+            double P_sum = 0.0;
+            Mult  *= IonizRate_tunnel[Z+k_times];
+            for( unsigned int j=0; j<k_times+1; j++ ) {
+                Dnom_tunnel[j]=Dnom_tunnel[j]/( IonizRate_tunnel[newZ]-IonizRate_tunnel[Z+j] );
+                D_sum += Dnom_tunnel[j];
+                P_sum += exp( -IonizRate_tunnel[Z+j]*dt )*Dnom_tunnel[j];
+            }
+            Dnom_tunnel[k_times+1] -= D_sum;
+            P_sum                   = P_sum + Dnom_tunnel[k_times+1]*exp( -IonizRate_tunnel[newZ]*dt );
+            Pint_tunnel             = Pint_tunnel + P_sum*Mult;
+            
+            TotalIonizPot += Potential[Z+k_times];
+            k_times++;
+        }//END while
+        
+        // final ionization (of last electron)
+        if( ( ( 1.0-Pint_tunnel )>ran_p ) && ( k_times==atomic_number_-Zp1 ) ) {
+            TotalIonizPot += Potential[atomic_number_-1];
+            k_times++;
+        }
+        
+        if( k_times != 0 ) {
+            ionized_index_    .push_back( ipart_min+i );
+            ionized_k_times_  .push_back( k_times );
+            ionized_potential_.push_back( TotalIonizPot );
+        }
+    }
+    
+    unsigned int nionized = ionized_index_.size();
+    if( nionized == 0 ) {
+        return;
+    }
+    
+    // Compute ionization current
+    if( patch->EMfields->Jx_ != NULL ) { // For the moment ionization current is not accounted for in AM geometry
+        double factorJion_0 = au_to_mec2 * EC_to_au*EC_to_au * invdt;
+        LocalFields Jion;
+        for( unsigned int iion=0 ; iion<nionized; iion++ ) {
+            unsigned int ipart = ionized_index_[iion];
+            int ifield = ipart - ipart_ref;
+            double invE = 1./E_buf[ipart-ipart_min];
+            double factorJion = factorJion_0 * invE*invE * ionized_potential_[iion];
+            Jion.x = factorJion * Ex[ifield];
+            Jion.y = factorJion * Ey[ifield];
+            Jion.z = factorJion * Ez[ifield];
+            Proj->ionizationCurrents( patch->EMfields->Jx_, patch->EMfields->Jy_, patch->EMfields->Jz_, *particles, ipart, Jion );
+        }
+    }
+    
+    // Creation of the new electrons, reserved in bulk
+    createElectrons( particles );
+    
+}
@@ -0,0 +1,59 @@
+#ifndef IONIZATIONTUNNELV_H
+#define IONIZATIONTUNNELV_H
+
+#include <cmath>
+
+#include <vector>
+
+#include "Ionization.h"
+#include "Tools.h"
+
+class Particles;
+
+//! Calculate the particle tunnel ionization: vectorized version
+//! The ionization rates are tabulated for each charge state on a log(E) grid,
+//! the first ionization is evaluated in SIMD loops over the bin and the rare
+//! multiple ionization events are computed in a compacted second pass.
+class IonizationTunnelV : public Ionization
+{
+
+public:
+    //! Constructor for IonizationTunnelV
+    IonizationTunnelV( Params &params, Species *species );
+    
+    //! apply the Tunnel Ionization model to the species (with ionization current)
+    void operator()( Particles *, unsigned int, unsigned int, std::vector<double> *, Patch *, Projector *, int ipart_ref = 0 ) override;
+
+private:
+    unsigned int atomic_number_;
+    std::vector<double> Potential;
+    std::vector<double> Azimuthal_quantum_number;
+    
+    double one_third;
+    std::vector<double> alpha_tunnel, beta_tunnel, gamma_tunnel;
+    
+    //! Exact ionization rate of the charge state Z for a field 1/invE (atomic units)
+    inline double rate( unsigned int Z, double invE )
+    {
+        double delta = gamma_tunnel[Z]*invE;
+        return beta_tunnel[Z] * exp( -delta*one_third + alpha_tunnel[Z]*log( delta ) );
+    }
+    
+    //! Number of points of the rate table for each charge state
+    static const int table_size_ = 4096;
+    //! Boundaries of the log(E) axis of the table (E in atomic units)
+    double log_E_min_, log_E_max_, inv_delta_log_E_;
+    //! Tabulated rates: one row per charge state, plus one row of zeros for fully-ionized atoms
+    std::vector<double> rate_table_;
+    
+    //! Buffers reused between calls: field amplitude, rate and probability of no ionization
+    std::vector<double> E_buffer_, rate_buffer_, no_ionization_buffer_;
+    //! Buffers of particles which may be ionized several times: index and random number
+    std::vector<unsigned int> multiple_index_;
+    std::vector<double> multiple_random_;
+    //! Total ionization potential of each ionized particle
+    std::vector<double> ionized_potential_;
+};
+
+
+#endif
@@ -204,6 +204,15 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
 
     // 2. Monte-Carlo process
     //    No vectorized
+    decay_index_.resize( 0 );
+    decay_weight_.resize( 0 );
+    decay_ux_.resize( 0 );
+    decay_uy_.resize( 0 );
+    decay_uz_.resize( 0 );
+    for( int k=0 ; k<2 ; k++ ) {
+        decay_p_[k].resize( 0 );
+        decay_chi_[k].resize( 0 );
+    }
     for( int ipart=istart ; ipart<iend; ipart++ ) {
 
         // If the photon has enough energy
@@ -269,12 +278,16 @@ void MultiphotonBreitWheeler::operator()( Particles &particles,
             }
         }
     }
+    
+    // 3. Creation of the recorded pairs
+    createPairs( particles );
 }
 
 
 // -----------------------------------------------------------------------------
 //! Second version of pair_emission:
-//! Perform the creation of pairs from a photon with particles as an argument
+//! Record the creation of pairs from a photon with particles as an argument
+//! The pairs are created after the Monte-Carlo loop by createPairs
 //! \param ipart              photon index
 //! \param particles          object particles containing the photons and their properties
 //! \param gammaph            photon normalized energy
@@ -293,12 +306,8 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     // _______________________________________________
     // Parameters
 
-    int      nparticles;           // Total number of particles in the temporary arrays
-    int      k, i;
-    double   u[3];                 // propagation direction
-    double *chi = new double[2];   // temporary quantum parameters
+    double *chi;                   // temporary quantum parameters
     double   inv_chiph_gammaph;    // (gamma_ph - 2) / chi
-    double   p;
     // Commented particles displasment while particles injection not managed  in a better way
     //    for now particles could be created outside of the local domain
     //    without been subject do boundary conditions (including domain exchange)
@@ -310,66 +319,100 @@ void MultiphotonBreitWheeler::pair_emission( int ipart,
     chi = MultiphotonBreitWheelerTables.computePairQuantumParameter( particles.chi( ipart ), rand_ );
     
     // pair propagation direction // direction of the photon
-    for( k = 0 ; k<3 ; k++ ) {
-        u[k] = particles.momentum( k, ipart )/gammaph;
+    decay_index_.push_back( ipart );
+    decay_weight_.push_back( particles.weight( ipart ) );
+    decay_ux_.push_back( particles.momentum( 0, ipart )/gammaph );
+    decay_uy_.push_back( particles.momentum( 1, ipart )/gammaph );
+    decay_uz_.push_back( particles.momentum( 2, ipart )/gammaph );
+
+    // Electron (k=0) and positron (k=1) momentum norm
+    for( int k=0 ; k < 2 ; k++ ) {
+        decay_p_[k].push_back( sqrt( pow( 1.+chi[k]*inv_chiph_gammaph, 2 )-1 ) );
+        decay_chi_[k].push_back( chi[k] );
     }
 
-    // _______________________________________________
-    // Electron (k=0) and positron (k=1) generation
+    delete [] chi;
 
-    for( k=0 ; k < 2 ; k++ ) {
-
-        // Creation of new electrons in the temporary array new_pair[0]
-        new_pair[k].createParticles( mBW_pair_creation_sampling_[k] );
-        
-        // Final size
-        nparticles = new_pair[k].size();
+    // Total energy converted into pairs during the current timestep
+    pair_converted_energy_ += particles.weight( ipart )*gammaph;
 
-        // For all new electrons...
-        for( int idNew=nparticles-mBW_pair_creation_sampling_[k]; idNew<nparticles; idNew++ ) {
+    // The photon with negtive weight will be deleted latter
+    particles.weight( ipart ) = -1;
 
-            // Momentum
-            p = sqrt( pow( 1.+chi[k]*inv_chiph_gammaph, 2 )-1 );
-            for( i=0; i<3; i++ ) {
-                new_pair[k].momentum( i, idNew ) =
-                    p*u[i];
-            }
+}
 
-            // gamma
-            //inv_gamma = 1./sqrt(1.+p*p);
+// -----------------------------------------------------------------------------
+//! Create all the pairs recorded by pair_emission
+//! Each decay produces mBW_pair_creation_sampling_[k] particles of each kind:
+//! they are reserved at once in new_pair[k] and filled at their offsets
+//! \param particles          object particles containing the photons
+// -----------------------------------------------------------------------------
+void MultiphotonBreitWheeler::createPairs( Particles &particles )
+{
+    unsigned int ndecays = decay_index_.size();
+    if( ndecays == 0 ) {
+        return;
+    }
+    
+    double *decay_u[3] = { &decay_ux_[0], &decay_uy_[0], &decay_uz_[0] };
+    
+    // _______________________________________________
+    // Electron (k=0) and positron (k=1) generation
 
-            // Positions
-            for( i=0; i<n_dimensions_; i++ ) {
-                new_pair[k].position( i, idNew )=particles.position( i, ipart );
-//               + new_pair[k].momentum(i,idNew)*remaining_dt*inv_gamma;
+    for( int k=0 ; k < 2 ; k++ ) {
+    
+        // Reservation of all new particles in the temporary array new_pair[k]
+        std::vector<unsigned int> first_new( ndecays, mBW_pair_creation_sampling_[k] );
+        new_pair[k].prepareEmission( first_new );
+        
+        // Momentum
+        for( int i=0; i<3; i++ ) {
+            double *new_momentum = &( new_pair[k].momentum( i, 0 ) );
+            for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                for( int isample=0; isample<mBW_pair_creation_sampling_[k]; isample++ ) {
+                    new_momentum[first_new[idecay]+isample] = decay_p_[k][idecay]*decay_u[i][idecay];
+                }
             }
-
-            // Old positions
+        }
+        
+        // Positions
+        for( int i=0; i<n_dimensions_; i++ ) {
+            double *new_position = &( new_pair[k].position( i, 0 ) );
+            for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                for( int isample=0; isample<mBW_pair_creation_sampling_[k]; isample++ ) {
+                    new_position[first_new[idecay]+isample] = particles.position( i, decay_index_[idecay] );
+                }
+            }
+        }
+        
+        // Old positions
 #ifdef  __DEBUG
-            for( i=0; i<n_dimensions_; i++ ) {
-                new_pair[k].position_old( i, idNew )=particles.position( i, ipart ) ;
+        for( int i=0; i<n_dimensions_; i++ ) {
+            for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+                for( int isample=0; isample<mBW_pair_creation_sampling_[k]; isample++ ) {
+                    new_pair[k].position_old( i, first_new[idecay]+isample ) = particles.position( i, decay_index_[idecay] );
+                }
             }
+        }
 #endif
-
-            new_pair[k].weight( idNew )=particles.weight( ipart )*mBW_pair_creation_inv_sampling_[k];
-            new_pair[k].charge( idNew )= k*2-1;
-
-            if( new_pair[k].isQuantumParameter ) {
-                new_pair[k].chi( idNew ) = chi[k];
-            }
-
-            if( new_pair[k].isMonteCarlo ) {
-                new_pair[k].tau( idNew ) = -1.;
+        
+        for( unsigned int idecay=0; idecay<ndecays; idecay++ ) {
+            for( int isample=0; isample<mBW_pair_creation_sampling_[k]; isample++ ) {
+                int idNew = first_new[idecay]+isample;
+                
+                new_pair[k].weight( idNew )=decay_weight_[idecay]*mBW_pair_creation_inv_sampling_[k];
+                new_pair[k].charge( idNew )= k*2-1;
+                
+                if( new_pair[k].isQuantumParameter ) {
+                    new_pair[k].chi( idNew ) = decay_chi_[k][idecay];
+                }
+                
+                if( new_pair[k].isMonteCarlo ) {
+                    new_pair[k].tau( idNew ) = -1.;
+                }
             }
         }
     }
-
-    // Total energy converted into pairs during the current timestep
-    pair_converted_energy_ += particles.weight( ipart )*gammaph;
-
-    // The photon with negtive weight will be deleted latter
-    particles.weight( ipart ) = -1;
-
 }
 
 // -----------------------------------------------------------------------------
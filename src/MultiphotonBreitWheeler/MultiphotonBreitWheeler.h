@@ -86,7 +86,7 @@ public:
                                int ithread, int ipart_ref = 0 );
                                
     //! Second version of pair_emission:
-    //! Perform the creation of pairs from a photon with particles as an argument
+    //! Record the creation of pairs from a photon with particles as an argument
     //! \param ipart              photon index
     //! \param particles          object particles containing the photons and their properties
     //! \param gammaph            photon normalized energy
@@ -100,6 +100,11 @@ public:
                         double remaining_dt,
                         MultiphotonBreitWheelerTables &MultiphotonBreitWheelerTables );
                         
+    //! Create all the pairs recorded by pair_emission,
+    //! reserving them at once in new_pair
+    //! \param particles   particle object containing the photons
+    void createPairs( Particles &particles );
+    
     //! Clean photons that decayed into pairs (weight <= 0)
     //! \param particles   particle object containing the particle
     //!                    properties of the current species
@@ -159,6 +164,14 @@ private:
     //! Espilon to check when tau is near 0
     static constexpr double epsilon_tau_ = 1e-100;
     
+    //! Decay events recorded during the Monte-Carlo loop:
+    //! photon index, photon weight and propagation direction
+    std::vector<int> decay_index_;
+    std::vector<double> decay_weight_;
+    std::vector<double> decay_ux_, decay_uy_, decay_uz_;
+    //! Momentum norm and quantum parameter of the electron (0) and positron (1)
+    std::vector<double> decay_p_[2], decay_chi_[2];
+    
 };
 
 #endif
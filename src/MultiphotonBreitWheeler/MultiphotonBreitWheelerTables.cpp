@@ -23,6 +23,8 @@
 MultiphotonBreitWheelerTables::MultiphotonBreitWheelerTables()
 {
     
+    xi_.inverse_size_ = 0;
+    
     setDefault();
     
 }
@@ -60,6 +62,12 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
 
         // Path to the databases
         PyTools::extract( "table_path", table_path_, "MultiphotonBreitWheeler"  );
+
+        // Size of the inverse cumulative distribution table
+        PyTools::extract( "inverse_cdf_size", xi_.inverse_size_, "MultiphotonBreitWheeler"  );
+        if( xi_.inverse_size_ == 1 || xi_.inverse_size_ < 0 ) {
+            ERROR( "The parameter `inverse_cdf_size` must be 0 or greater than 1" );
+        }
     }
 
     // Computation of some parameters
@@ -103,6 +111,13 @@ void MultiphotonBreitWheelerTables::initialization( Params &params, SmileiMPI *s
         MESSAGE( 2,"Minimum photon chi: " << xi_.min_photon_chi_ );
         MESSAGE( 2,"Maximum photon chi: " << xi_.max_photon_chi_ );
         
+        if( xi_.inverse_size_ > 0 ) {
+            computeInverseXiTable();
+            MESSAGE( "" )
+            MESSAGE( 1,"--- Inverse table of `xi` for the pair sampling:" );
+            MESSAGE( 2,"Dimension: " << xi_.inverse_size_ );
+        }
+        
     }
 
 }
@@ -174,7 +189,7 @@ double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photo
     // Parameters
     double *chi = new double[2];
     double logchiph;
-    double log10_chipam, log10_chipap;
+    double log10_chipam, log10_chipap, log10_chipa;
     double d;
     double delta_chipa;
     double xip, xipp;
@@ -220,36 +235,50 @@ double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photo
         xipp = xip;
     }
 
-    // check boundaries
-    // Lower bound
-    if( xipp < xi_.table_[ichiph*xi_.size_particle_chi_] ) {
-        ichipa = 0;
-    }
-    // Upper bound
-    else if( xipp >= xi_.table_[( ichiph+1 )*xi_.size_particle_chi_-1] ) {
-        ichipa = xi_.size_particle_chi_-2;
-    } else {
-        // Search for the corresponding index ichipa for xip
-        ichipa = userFunctions::searchValuesInMonotonicArray(
-                     &xi_.table_[ichiph*xi_.size_particle_chi_], xipp, xi_.size_particle_chi_ );
-    }
-
     // Delta for the particle_chi dimension
     delta_chipa = ( log10( 0.5*photon_chi )-xi_.min_particle_chi_[ichiph] )
                   * xi_.inv_size_particle_chi_minus_one_;
 
-    ixip = ichiph*xi_.size_particle_chi_ + ichipa;
+    // Constant-time lookup in the inverse cumulative distribution
+    if( xi_.inverse_size_ > 0 ) {
+        d = xipp*xi_.inverse_factor_;
+        ixip = std::min( int( d ), xi_.inverse_size_-2 );
+        d -= ixip;
+        ixip += ichiph*xi_.inverse_size_;
+
+        log10_chipa = ( xi_.inverse_table_[ixip]*( 1.0-d ) + xi_.inverse_table_[ixip+1]*d )*delta_chipa
+                      + xi_.min_particle_chi_[ichiph];
+    } else {
+
+        // check boundaries
+        // Lower bound
+        if( xipp < xi_.table_[ichiph*xi_.size_particle_chi_] ) {
+            ichipa = 0;
+        }
+        // Upper bound
+        else if( xipp >= xi_.table_[( ichiph+1 )*xi_.size_particle_chi_-1] ) {
+            ichipa = xi_.size_particle_chi_-2;
+        } else {
+            // Search for the corresponding index ichipa for xip
+            ichipa = userFunctions::searchValuesInMonotonicArray(
+                         &xi_.table_[ichiph*xi_.size_particle_chi_], xipp, xi_.size_particle_chi_ );
+        }
+
+        ixip = ichiph*xi_.size_particle_chi_ + ichipa;
 
-    log10_chipam = ichipa*delta_chipa + xi_.min_particle_chi_[ichiph];
-    log10_chipap = log10_chipam + delta_chipa;
+        log10_chipam = ichipa*delta_chipa + xi_.min_particle_chi_[ichiph];
+        log10_chipap = log10_chipam + delta_chipa;
 
-    d = ( xipp - xi_.table_[ixip] ) / ( xi_.table_[ixip+1] - xi_.table_[ixip] );
+        d = ( xipp - xi_.table_[ixip] ) / ( xi_.table_[ixip+1] - xi_.table_[ixip] );
+
+        log10_chipa = log10_chipam*( 1.0-d ) + log10_chipap*( d );
+    }
 
     // If xip > 0.5, the electron will bring more energy than the positron
     if( xip > 0.5 ) {
 
         // Positron quantum parameter
-        chi[1] = pow( 10, log10_chipam*( 1.0-d ) + log10_chipap*( d ) );
+        chi[1] = pow( 10, log10_chipa );
 
         // Electron quantum parameter
         chi[0] = photon_chi - chi[1];
@@ -257,7 +286,7 @@ double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photo
     // If xip <= 0.5, the positron will bring more energy than the electron
     else {
         // Electron quantum parameter
-        chi[0] = pow( 10, log10_chipam*( 1.0-d ) + log10_chipap*( d ) );
+        chi[0] = pow( 10, log10_chipa );
 
         // Positron quantum parameter
         chi[1] = photon_chi - chi[0];
@@ -266,6 +295,43 @@ double *MultiphotonBreitWheelerTables::computePairQuantumParameter( double photo
     return chi;
 }
 
+// -----------------------------------------------------------------------------
+// INVERSE CUMULATIVE DISTRIBUTION
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//! Compute the inverse of the cumulative distribution xi for each photon_chi
+//! row on a uniform grid of xi in [0, 0.5]. The table contains the
+//! fractional index in the particle_chi dimension, evaluated exactly as in
+//! computePairQuantumParameter (search and linear interpolation).
+// -----------------------------------------------------------------------------
+void MultiphotonBreitWheelerTables::computeInverseXiTable()
+{
+    int size = xi_.inverse_size_;
+    
+    xi_.inverse_factor_ = 2.*( size-1 );
+    xi_.inverse_table_.resize( xi_.size_photon_chi_*size );
+    
+    for( int ichiph=0 ; ichiph<xi_.size_photon_chi_ ; ichiph++ ) {
+    
+        double *table = &xi_.table_[ichiph*xi_.size_particle_chi_];
+        
+        for( int i=0 ; i<size ; i++ ) {
+            double xipp = 0.5*i/( size-1. );
+            int ichipa;
+            if( xipp < table[0] ) {
+                ichipa = 0;
+            } else if( xipp >= table[xi_.size_particle_chi_-1] ) {
+                ichipa = xi_.size_particle_chi_-2;
+            } else {
+                ichipa = userFunctions::searchValuesInMonotonicArray( table, xipp, xi_.size_particle_chi_ );
+            }
+            xi_.inverse_table_[ichiph*size+i] = ichipa
+                                                + ( xipp - table[ichipa] ) / ( table[ichipa+1] - table[ichipa] );
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 // TABLE READING
 // -----------------------------------------------------------------------------
@@ -18,6 +18,7 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <algorithm>
 
 #include "Params.h"
 #include "H5.h"
@@ -88,6 +89,14 @@ public:
     //! \param smpi Object of class SmileiMPI containing MPI properties
     void bcastTableXi( SmileiMPI *smpi );
 
+    // ---------------------------------------------------------------------
+    // INVERSE CUMULATIVE DISTRIBUTION
+    // ---------------------------------------------------------------------
+
+    //! Compute the inverse of the cumulative distribution xi for each
+    //! photon_chi row on a uniform grid
+    void computeInverseXiTable();
+
 private:
 
     // ---------------------------------------------
@@ -178,6 +187,16 @@ private:
         //! xip threshold
         // double threshold_;
         
+        //! Number of points of the inverse table (0: not used)
+        int inverse_size_;
+        
+        //! Inverse cumulative distribution: fractional index in the particle_chi
+        //! dimension for each photon_chi row, on a uniform grid of xi in [0, 0.5]
+        std::vector<double> inverse_table_;
+        
+        //! Factor to compute the index in the inverse table
+        double inverse_factor_;
+        
     };
     
     struct Xi xi_;
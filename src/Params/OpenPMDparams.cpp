@@ -188,6 +188,23 @@ void OpenPMDparams::writeFieldAttributes( hid_t location, vector<unsigned int> s
     H5::attr( location, "gridUnitSI", unitSI[SMILEI_UNIT_POSITION] );
 }
 
+void OpenPMDparams::writeDownsampledFieldAttributes( hid_t location, unsigned int factor )
+{
+    H5::attr( location, "geometry", "cartesian" );
+    H5::attr( location, "dataOrder", "C" );
+    H5::attr( location, "axisLabels", axisLabels );
+    unsigned int ndim = gridSpacing.size();
+    vector<double> blockSpacing( ndim );
+    vector<double> blockOffset( ndim );
+    for( unsigned int i=0; i<ndim; i++ ) {
+        blockSpacing[i] = gridSpacing[i] * factor;
+        blockOffset [i] = gridGlobalOffset[i] + 0.5 * blockSpacing[i];
+    }
+    H5::attr( location, "gridSpacing", blockSpacing );
+    H5::attr( location, "gridGlobalOffset", blockOffset );
+    H5::attr( location, "gridUnitSI", unitSI[SMILEI_UNIT_POSITION] );
+}
+
 void OpenPMDparams::writeSpeciesAttributes( hid_t location )
 {
 }
@@ -69,6 +69,9 @@ public:
     //! Write the attributes for a field in the meshesPath
     void writeFieldAttributes( hid_t, std::vector<unsigned int> subgrid_start= {}, std::vector<unsigned int> subgrid_step= {} );
     
+    //! Write the attributes for a field block-averaged by some factor (values at the centers of the blocks)
+    void writeDownsampledFieldAttributes( hid_t, unsigned int factor );
+    
     //! Write the attributes for the particlesPath
     void writeSpeciesAttributes( hid_t );
     
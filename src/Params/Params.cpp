@@ -430,10 +430,18 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     PyTools::extract( "solve_poisson", solve_poisson, "Main"   );
     PyTools::extract( "poisson_max_iteration", poisson_max_iteration, "Main"   );
     PyTools::extract( "poisson_max_error", poisson_max_error, "Main"   );
+    PyTools::extract( "poisson_preconditioner_sweeps", poisson_preconditioner_sweeps, "Main"   );
+    if( poisson_preconditioner_sweeps > 0 && geometry == "AMcylindrical" ) {
+        WARNING( "`poisson_preconditioner_sweeps` is not available in AMcylindrical geometry: ignored" );
+        poisson_preconditioner_sweeps = 0;
+    }
     // Relativistic Poisson Solver
     PyTools::extract( "solve_relativistic_poisson", solve_relativistic_poisson, "Main"   );
     PyTools::extract( "relativistic_poisson_max_iteration", relativistic_poisson_max_iteration, "Main"   );
     PyTools::extract( "relativistic_poisson_max_error", relativistic_poisson_max_error, "Main"   );
+    if( poisson_preconditioner_sweeps > 0 && solve_relativistic_poisson ) {
+        WARNING( "`poisson_preconditioner_sweeps` does not apply to the relativistic Poisson solver, which keeps the plain conjugate gradient" );
+    }
 
     // PXR parameters
     PyTools::extract( "is_spectral", is_spectral, "Main"   );
@@ -454,6 +462,7 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     }
 
     // Current filter properties
+    currentFilter_single_exchange = false;
     int nCurrentFilter = PyTools::nComponents( "CurrentFilter" );
     for( int ifilt = 0; ifilt < nCurrentFilter; ifilt++ ) {
         string model;
@@ -473,6 +482,8 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
         } else if( currentFilter_passes.size() != nDim_field ) {
             ERROR( "passes must be the same size as the number of field dimensions" );
         }
+        
+        PyTools::extract( "single_exchange", currentFilter_single_exchange, "CurrentFilter", ifilt );
     }
 
     // Field filter properties
@@ -497,6 +508,16 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
             ERROR( "Friedman filter theta = " << Friedman_theta << " must be between 0 and 1" );
         }
     }
+    
+    // Fused Maxwell solver
+    PyTools::extract( "fused_maxwell_solver", fused_maxwell_solver, "Main"   );
+    if( fused_maxwell_solver ) {
+        if( ( geometry != "2Dcartesian" && geometry != "3Dcartesian" )
+                || maxwell_sol != "Yee" || is_spectral || is_pxr || Friedman_filter ) {
+            WARNING( "`fused_maxwell_solver` is only available with the Yee solver in 2Dcartesian and 3Dcartesian geometries, without FieldFilter: ignored" );
+            fused_maxwell_solver = false;
+        }
+    }
 
 
     // testing the CFL condition
@@ -555,6 +576,21 @@ Params::Params( SmileiMPI *smpi, std::vector<std::string> namelistsFiles ) :
     
     PyTools::extract( "uncoupled_grids", uncoupled_grids, "Main" );
     
+    // Deep ghost cells: fields exchanged every few iterations only
+    PyTools::extract( "exchange_fields_each", exchange_fields_each, "Main" );
+    if( exchange_fields_each == 0 ) {
+        ERROR( "`exchange_fields_each` must be at least 1" );
+    }
+    if( exchange_fields_each > 1 ) {
+        if( geometry == "AMcylindrical" || maxwell_sol != "Yee" || is_spectral || is_pxr || Friedman_filter || uncoupled_grids ) {
+            WARNING( "`exchange_fields_each` is only available with the Yee solver in cartesian geometries, without FieldFilter: ignored" );
+            exchange_fields_each = 1;
+        } else {
+            // Corners of the ghost regions must be synchronized too
+            full_B_exchange = true;
+        }
+    }
+    
     global_factor.resize( nDim_field, 1 );
     PyTools::extractV( "global_factor", global_factor, "Main" );
     norder.resize( nDim_field, 1 );
@@ -923,7 +959,11 @@ void Params::compute()
    
     //Define number of cells per patch and number of ghost cells 
     for( unsigned int i=0; i<nDim_field; i++ ) {
-        oversize[i]  = interpolation_order + ( exchange_particles_each-1 );
+        oversize[i]  = interpolation_order + ( exchange_particles_each-1 ) + ( exchange_fields_each-1 );
+        // All filter passes done between two exchanges need one ghost cell each
+        if( currentFilter_single_exchange && currentFilter_passes[i] > oversize[i] ) {
+            oversize[i] = currentFilter_passes[i];
+        }
         n_space_global[i] = n_space[i];
         n_space[i] /= number_of_patches[i];
         if( n_space_global[i]%number_of_patches[i] !=0 ) {
@@ -1091,6 +1131,9 @@ void Params::print_init()
     if( full_B_exchange ) {
         MESSAGE( 1, "All components of B are exchanged at synchronization" );
     }
+    if( exchange_fields_each > 1 ) {
+        MESSAGE( 1, "E and B are exchanged every " << exchange_fields_each << " iterations (deep ghost cells)" );
+    }
 
     if( has_load_balancing ) {
         TITLE( "Load Balancing: " );
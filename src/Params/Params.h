@@ -147,6 +147,8 @@ public:
     unsigned int poisson_max_iteration;
     //! Maxium poisson error tolerated
     double poisson_max_error;
+    //! Number of symmetric Gauss-Seidel sweeps of the Poisson preconditioner (0 = no preconditioner)
+    unsigned int poisson_preconditioner_sweeps;
 
     //"Relativistic" Poisson solver
     //! Do we solve "relativistic poisson problem" for relativistic species
@@ -163,9 +165,15 @@ public:
     
     //! Maxwell Solver (default='Yee')
     std::string maxwell_sol;
+    
+    //! Save B, solve Maxwell-Ampere and Maxwell-Faraday in a single pass per patch (Yee only)
+    bool fused_maxwell_solver;
 
     //! Current spatial filter: number of binomial passes
     std::vector<unsigned int> currentFilter_passes;
+    
+    //! Current spatial filter: apply all passes before a single exchange (requires passes <= oversize)
+    bool currentFilter_single_exchange;
 
     //! is Friedman filter applied [Greenwood et al., J. Comp. Phys. 201, 665 (2004)]
     bool Friedman_filter;
@@ -238,6 +246,9 @@ public:
     //! frequency of exchange particles (default = 1, disabled for now, incompatible with sort)
     int exchange_particles_each;
     
+    //! frequency of exchange of E and B between patches (deep ghost cells if > 1)
+    unsigned int exchange_fields_each;
+    
     //! frequency to apply shrinkToFit on particles structure
     int every_clean_particles_overhead;
 
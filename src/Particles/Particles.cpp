@@ -1,5 +1,6 @@
 #include "Particles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -877,6 +878,93 @@ void Particles::moveParticles( int iPart, int new_pos )
     eraseParticle( iPart+1 );
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Two-phase creation of new particles: make room for all the new particles counted
+//! for each source, and replace the counts by the index of the first new particle of each source
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int Particles::prepareEmission( vector<unsigned int> &counts )
+{
+    unsigned int offset = size();
+    unsigned int nnew = 0;
+    for( unsigned int isource=0 ; isource<counts.size() ; isource++ ) {
+        unsigned int n = counts[isource];
+        counts[isource] = offset + nnew;
+        nnew += n;
+    }
+    if( nnew > 0 ) {
+        createParticles( nnew );
+    }
+    return nnew;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Insert sorted new particles in the bins of one property array, with a single resize
+//! and a single backward pass. The region of bin ibin (including a possible gap up to the next bin)
+//! is shifted by all the particles inserted in bins <= ibin.
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void importPropertyInBins( vector<T> &dest, vector<T> &src, vector<unsigned int> &sorted_src,
+                                  vector<int> &first_index, vector<int> &offset, vector<int> &bin_count )
+{
+    int end = dest.size();
+    dest.resize( dest.size() + sorted_src.size() );
+    for( int ibin = ( int )first_index.size()-1 ; ibin >= 0 ; ibin-- ) {
+        int shift = offset[ibin] + bin_count[ibin];
+        if( shift == 0 ) {
+            break;
+        }
+        copy_backward( dest.begin() + first_index[ibin], dest.begin() + end, dest.begin() + end + shift );
+        for( int i=0 ; i<bin_count[ibin] ; i++ ) {
+            dest[first_index[ibin]+offset[ibin]+i] = src[sorted_src[offset[ibin]+i]];
+        }
+        end = first_index[ibin];
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Import the particles of source_particles in the bins of this array
+//! Phase 1 counts the new particles per bin and sorts them (counting sort),
+//! phase 2 resizes each property once and fills it at the precomputed offsets
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::importParticlesInBins( Particles &source_particles, vector<int> &bin_keys,
+                                       vector<int> &first_index, vector<int> &last_index,
+                                       vector<int> &bin_count )
+{
+    unsigned int npart = source_particles.size(), nbin = first_index.size();
+
+    // Count new particles per bin, and compute the offset of each bin in the sorted new particles
+    bin_count.assign( nbin, 0 );
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
+        bin_count[bin_keys[ip]] ++;
+    }
+    vector<int> offset( nbin, 0 );
+    for( unsigned int ibin=1; ibin < nbin ; ibin++ ) {
+        offset[ibin] = offset[ibin-1] + bin_count[ibin-1];
+    }
+    vector<unsigned int> sorted_src( npart );
+    vector<int> position( offset );
+    for( unsigned int ip=0; ip < npart ; ip++ ) {
+        sorted_src[position[bin_keys[ip]]++] = ip;
+    }
+
+    // Insert all properties
+    for( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        importPropertyInBins( *double_prop[iprop], *source_particles.double_prop[iprop], sorted_src, first_index, offset, bin_count );
+    }
+    for( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        importPropertyInBins( *short_prop[iprop], *source_particles.short_prop[iprop], sorted_src, first_index, offset, bin_count );
+    }
+    for( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        importPropertyInBins( *uint64_prop[iprop], *source_particles.uint64_prop[iprop], sorted_src, first_index, offset, bin_count );
+    }
+
+    // Update the bin boundaries
+    for( unsigned int ibin=0; ibin < nbin ; ibin++ ) {
+        first_index[ibin] += offset[ibin];
+        last_index [ibin] += offset[ibin] + bin_count[ibin];
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Create nParticles new particles at the end of vectors
 // ---------------------------------------------------------------------------------------------------------------------
@@ -135,6 +135,22 @@ public:
     //! Move ipart at new_pos in the particles data structure
     void moveParticles( int iPart, int new_pos );
 
+    //! Two-phase creation of new particles (ionization, radiation, pair creation):
+    //! 1. the process counts the new particles of each source (emission event, cluster...) in counts,
+    //! 2. this method makes room for all of them with a single resize per property,
+    //!    replaces counts by the index of the first new particle of each source,
+    //!    and returns the total number of new particles,
+    //! 3. each source fills its new particles independently (SIMD or threads).
+    unsigned int prepareEmission( std::vector<unsigned int> &counts );
+
+    //! Insert the particles of source_particles in the bins of this array described
+    //! by first_index and last_index (updated), given the bin of each source particle.
+    //! New particles are placed at the beginning of their bin, and the number imported
+    //! in each bin is returned in bin_count. Each property is resized once and shifted in one pass.
+    void importParticlesInBins( Particles &source_particles, std::vector<int> &bin_keys,
+                                std::vector<int> &first_index, std::vector<int> &last_index,
+                                std::vector<int> &bin_count );
+
     //! Compress the particles vectors according to the provided mask
     //! between istart and iend
     void eraseParticlesWithMask( int istart, int iend, std::vector <int> & mask );
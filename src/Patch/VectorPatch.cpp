@@ -31,12 +31,14 @@ using namespace std;
 VectorPatch::VectorPatch()
 {
     domain_decomposition_ = NULL ;
+    nmoved_at_fields_exchange_ = 0;
 }
 
 
 VectorPatch::VectorPatch( Params &params )
 {
     domain_decomposition_ = DomainDecompositionFactory::create( params );
+    nmoved_at_fields_exchange_ = 0;
 }
 
 
@@ -320,6 +322,7 @@ void VectorPatch::dynamics( Params &params,
                 continue;
             }
             if( spec->isProj( time_dual, simWindow ) || diag_flag ) {
+                double timeline_start = timers.timeline.now();
                 // Dynamics with vectorized operators
                 if( spec->vectorized_operators || params.cell_sorting ) {
                     spec->dynamics( time_dual, ispec,
@@ -350,6 +353,7 @@ void VectorPatch::dynamics( Params &params,
                                                  localDiags );
                     }
                 } // end if condition on envelope dynamics
+                timers.timeline.record( Timeline::Dynamics, timeline_start, ( *this )( ipatch )->hindex, ispec );
             } // end if condition on species
         } // end loop on species
         //MESSAGE("species dynamics");
@@ -371,7 +375,9 @@ void VectorPatch::dynamics( Params &params,
     for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
         Species *spec = species( 0, ispec );
         if( !spec->ponderomotive_dynamics && spec->isProj( time_dual, simWindow ) ) {
+            double timeline_start = timers.timeline.now();
             SyncVectorPatch::exchangeParticles( ( *this ), ispec, params, smpi, timers, itime ); // Included sortParticles
+            timers.timeline.record( Timeline::ExchangeParticles, timeline_start, -1, ispec );
         } // end condition on species
     } // end loop on species
     //MESSAGE("exchange particles");
@@ -443,7 +449,9 @@ void VectorPatch::finalizeAndSortParticles( Params &params, SmileiMPI *smpi, Sim
 
     for( unsigned int ispec=0 ; ispec<( *this )( 0 )->vecSpecies.size(); ispec++ ) {
         if( ( *this )( 0 )->vecSpecies[ispec]->isProj( time_dual, simWindow ) ) {
+            double timeline_start = timers.timeline.now();
             SyncVectorPatch::finalizeAndSortParticles( ( *this ), ispec, params, smpi, timers, itime ); // Included sortParticles
+            timers.timeline.record( Timeline::FinalizeExchangeParticles, timeline_start, -1, ispec );
         }
 
     }
@@ -456,10 +464,12 @@ void VectorPatch::finalizeAndSortParticles( Params &params, SmileiMPI *smpi, Sim
         // Particle importation for all species
         for( unsigned int ispec=0 ; ispec<( *this )( ipatch )->vecSpecies.size() ; ispec++ ) {
             if( ( *this )( ipatch )->vecSpecies[ispec]->isProj( time_dual, simWindow ) || diag_flag ) {
+                double timeline_start = timers.timeline.now();
                 species( ipatch, ispec )->dynamicsImportParticles( time_dual, ispec,
                         params,
                         ( *this )( ipatch ), smpi,
                         localDiags );
+                timers.timeline.record( Timeline::ImportParticles, timeline_start, ( *this )( ipatch )->hindex, ispec );
             }
         }
     }
@@ -483,10 +493,12 @@ void VectorPatch::mergeParticles(Params &params, SmileiMPI *smpi, double time_du
 
                 // Check the time selection
                 if( species( ipatch, ispec )->merging_time_selection_->theTimeIsNow( itime ) ) {
+                    double timeline_start = timers.timeline.now();
                     species( ipatch, ispec )->mergeParticles( time_dual, ispec,
                             params,
                             ( *this )( ipatch ), smpi,
                             localDiags );
+                    timers.timeline.record( Timeline::MergeParticles, timeline_start, ( *this )( ipatch )->hindex, ispec );
                 }
             }
         }
@@ -992,11 +1004,16 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
 
     // Current filter in intermediate space
     if (params.currentFilter_passes.size() > 0){
-        for( unsigned int ipassfilter=0 ; ipassfilter<*std::max_element(std::begin(params.currentFilter_passes), std::end(params.currentFilter_passes)) ; ipassfilter++ ) {
+        unsigned int npasses = *std::max_element(std::begin(params.currentFilter_passes), std::end(params.currentFilter_passes));
+        // With enough ghost cells, all passes are applied before a single exchange
+        unsigned int passes_per_exchange = params.currentFilter_single_exchange ? max( npasses, 1u ) : 1;
+        for( unsigned int ipassfilter=0 ; ipassfilter<npasses ; ipassfilter+=passes_per_exchange ) {
             #pragma omp for schedule(static)
             for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
                 // Current spatial filtering
-                ( *this )( ipatch )->EMfields->binomialCurrentFilter(ipassfilter, params.currentFilter_passes);
+                for( unsigned int ipass=ipassfilter ; ipass<min( ipassfilter+passes_per_exchange, npasses ) ; ipass++ ) {
+                    ( *this )( ipatch )->EMfields->binomialCurrentFilter(ipass, params.currentFilter_passes);
+                }
             }
             if (params.geometry != "AMcylindrical"){
                 SyncVectorPatch::exchangeAlongAllDirections<double,Field>( listJx_, *this, smpi );
@@ -1023,29 +1040,54 @@ void VectorPatch::solveMaxwell( Params &params, SimWindow *simWindow, int itime,
         (*this)( 0 )->EMfields->MaxwellAmpereSolver_->densities_correction( (*this)( 0 )->EMfields );
     }
 
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        if( !params.is_spectral ) {
-            // Saving magnetic fields (to compute centered fields used in the particle pusher)
-            // Stores B at time n in B_m.
-            ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+    if( ( *this )( 0 )->EMfields->MaxwellFusedSolver_ ) {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            double timeline_start = timers.timeline.now();
+            // Saves B in B_m, computes E on all points and B at time n+1 on interior points,
+            // tile by tile in a single pass
+            ( *( *this )( ipatch )->EMfields->MaxwellFusedSolver_ )( ( *this )( ipatch )->EMfields );
+            timers.timeline.record( Timeline::MaxwellFused, timeline_start, ( *this )( ipatch )->hindex );
+        }
+    } else {
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            double timeline_start = timers.timeline.now();
+            if( !params.is_spectral ) {
+                // Saving magnetic fields (to compute centered fields used in the particle pusher)
+                // Stores B at time n in B_m.
+                ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
+            }
+            // Computes Ex_, Ey_, Ez_ on all points.
+            // E is already synchronized because J has been synchronized before.
+            ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
+            timers.timeline.record( Timeline::MaxwellAmpere, timeline_start, ( *this )( ipatch )->hindex );
+        }
+        
+        #pragma omp for schedule(static)
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            double timeline_start = timers.timeline.now();
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
+            timers.timeline.record( Timeline::MaxwellFaraday, timeline_start, ( *this )( ipatch )->hindex );
         }
-        // Computes Ex_, Ey_, Ez_ on all points.
-        // E is already synchronized because J has been synchronized before.
-        ( *( *this )( ipatch )->EMfields->MaxwellAmpereSolver_ )( ( *this )( ipatch )->EMfields );
-    }
-
-    #pragma omp for schedule(static)
-    for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-        // Computes Bx_, By_, Bz_ at time n+1 on interior points.
-        ( *( *this )( ipatch )->EMfields->MaxwellFaradaySolver_ )( ( *this )( ipatch )->EMfields );
     }
     //Synchronize B fields between patches.
     timers.maxwell.update( params.printNow( itime ) );
 
 
     timers.syncField.restart();
-    if( params.geometry != "AMcylindrical" ) {
+    if( params.exchange_fields_each > 1 ) {
+        // Deep ghost cells: the solvers also advance the ghost cells, which are corrupted
+        // by one more cell from the outer edge at each iteration. E and B are exchanged
+        // together every exchange_fields_each iterations, or when the window has moved
+        if( ( itime % params.exchange_fields_each == 0 ) || ( simWindow->getNmoved() != nmoved_at_fields_exchange_ ) ) {
+            SyncVectorPatch::exchangeE( params, ( *this ), smpi );
+            SyncVectorPatch::exchangeB( params, ( *this ), smpi );
+            #pragma omp single
+            nmoved_at_fields_exchange_ = simWindow->getNmoved();
+        }
+    } else if( params.geometry != "AMcylindrical" ) {
         if( params.is_spectral ) {
             SyncVectorPatch::exchangeE( params, ( *this ), smpi );
         }
@@ -1122,12 +1164,9 @@ void VectorPatch::solveEnvelope( Params &params, SimWindow *simWindow, int itime
 
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            // Compute ponderomotive potential Phi=|A|^2/2, |A| and |E| from the envelope 
-            ( *this )( ipatch )->EMfields->envelope->computePhiEnvAEnvE( ( *this )( ipatch )->EMfields );
-            // Compute gradients of Phi
-            ( *this )( ipatch )->EMfields->envelope->computeGradientPhi( ( *this )( ipatch )->EMfields );
-            // Computes Phi and GradPhi at time n+1/2 using their values at timestep n+1 and n (the latter already in Phi_m and GradPhi_m)
-            ( *this )( ipatch )->EMfields->envelope->centerPhiAndGradPhi();
+            // Compute ponderomotive potential Phi=|A|^2/2, |A| and |E| from the envelope, and the gradients of Phi
+            // Then computes Phi and GradPhi at time n+1/2 using their values at timestep n+1 and n (the latter already in Phi_m and GradPhi_m)
+            ( *this )( ipatch )->EMfields->envelope->updatePhiAndGradPhi( ( *this )( ipatch )->EMfields );
         }
 
         // Exchange GradPhi
@@ -1150,6 +1189,7 @@ void VectorPatch::finalizeSyncAndBCFields( Params &params, SmileiMPI *smpi, SimW
 
         #pragma omp for schedule(static)
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            double timeline_start = timers.timeline.now();
             // Applies boundary conditions on B
             if ( (!params.is_spectral) || (params.geometry!= "AMcylindrical") )
                 ( *this )( ipatch )->EMfields->boundaryConditions( itime, time_dual, ( *this )( ipatch ), params, simWindow );
@@ -1157,6 +1197,7 @@ void VectorPatch::finalizeSyncAndBCFields( Params &params, SmileiMPI *smpi, SimW
             if( !params.is_spectral ) {
                 ( *this )( ipatch )->EMfields->centerMagneticFields();
             }
+            timers.timeline.record( Timeline::BoundaryConditions, timeline_start, ( *this )( ipatch )->hindex );
             //Done at domain initializtion
             //else {
             //    ( *this )( ipatch )->EMfields->saveMagneticFields( params.is_spectral );
@@ -1253,15 +1294,38 @@ void VectorPatch::runAllDiags( Params &params, SmileiMPI *smpi, unsigned int iti
     timers.diags.restart();
     for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
         diag_timers[idiag]->restart();
-
         #pragma omp single
         globalDiags[idiag]->theTimeIsNow = globalDiags[idiag]->prepare( itime );
-        #pragma omp barrier
+        diag_timers[idiag]->update();
+    }
+    
+    // All patches run the particle binning diags in a single sweep over the particles
+    // (its time is accounted in the timer of the first of these diags)
+    #pragma omp single
+    particle_binning_engine_.select( globalDiags, ( *this )( 0 )->vecSpecies.size() );
+    if( particle_binning_engine_.size() > 0 ) {
+        unsigned int ifirst = 0;
+        while( ! particle_binning_engine_.isSelected( ifirst ) ) {
+            ifirst++;
+        }
+        diag_timers[ifirst]->restart();
+        #pragma omp for schedule(runtime)
+        for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+            particle_binning_engine_.run( ( *this )( ipatch ), simWindow );
+        }
+        diag_timers[ifirst]->update();
+    }
+    
+    for( unsigned int idiag = 0 ; idiag < globalDiags.size() ; idiag++ ) {
+        diag_timers[idiag]->restart();
+
         if( globalDiags[idiag]->theTimeIsNow ) {
-            // All patches run
-            #pragma omp for schedule(runtime)
-            for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
-                globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+            // All patches run (unless already done by the particle binning engine)
+            if( ! particle_binning_engine_.isSelected( idiag ) ) {
+                #pragma omp for schedule(runtime)
+                for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+                    globalDiags[idiag]->run( ( *this )( ipatch ), itime, simWindow );
+                }
             }
             // MPI procs gather the data and compute
             #pragma omp single
@@ -1330,7 +1394,7 @@ bool VectorPatch::isRhoNull( SmileiMPI *smpi )
 // Solve Poisson to initialize E
 //   - all steps are done locally, sync per patch, sync per MPI process
 // ---------------------------------------------------------------------------------------------------------------------
-void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
+void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi, Timers &timers )
 {
     Timer ptimer( "global" );
     ptimer.init( smpi );
@@ -1340,6 +1404,7 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
     unsigned int iteration_max = params.poisson_max_iteration;
     double           error_max = params.poisson_max_error;
     unsigned int iteration=0;
+    unsigned int sweeps = params.poisson_preconditioner_sweeps;
 
     // Init & Store internal data (phi, r, p, Ap) per patch
     double rnew_dot_rnew_local( 0. );
@@ -1358,6 +1423,24 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
         Ap_.push_back( ( *this )( ipatch )->EMfields->Ap_ );
     }
 
+    // Preconditioned conjugate gradient: the preconditioned residual z is stored in Ap_,
+    // which is not used between the update of r and the next computation of Ap
+    double rnew_dot_znew( 0. );
+    if( sweeps > 0 ) {
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            ( *this )( ipatch )->EMfields->compute_z( sweeps );
+        }
+        // z is computed on the nodes of each patch only: sum the overlapping zones
+        SyncVectorPatch::sum<double,Field>( Ap_, *this, smpi, timers, 0 );
+        double rnew_dot_znew_local( 0. );
+        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+            rnew_dot_znew_local += ( *this )( ipatch )->EMfields->compute_rz();
+            // p = z
+            ( *this )( ipatch )->EMfields->update_p_from_z( 0., 1. );
+        }
+        MPI_Allreduce( &rnew_dot_znew_local, &rnew_dot_znew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+    }
+
     unsigned int nx_p2_global = ( params.n_space_global[0]+1 );
     if( Ex_[0]->dims_.size()>1 ) {
         nx_p2_global *= ( params.n_space_global[1]+1 );
@@ -1383,6 +1466,7 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
 
         // scalar product of the residual
         double r_dot_r = rnew_dot_rnew;
+        double r_dot_z = rnew_dot_znew;
 
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
             ( *this )( ipatch )->EMfields->compute_Ap( ( *this )( ipatch ) );
@@ -1403,23 +1487,50 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI *smpi )
 
         // compute new potential and residual
         for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_pand_r( r_dot_r, p_dot_Ap );
+            ( *this )( ipatch )->EMfields->update_pand_r( sweeps > 0 ? r_dot_z : r_dot_r, p_dot_Ap );
         }
 
-        // compute new residual norm
-        rnew_dot_rnew       = 0.0;
-        rnew_dot_rnew_local = 0.0;
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
-        }
-        MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
-        if( smpi->isMaster() ) {
-            DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
-        }
+        if( sweeps > 0 ) {
+            // preconditioned residual
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->compute_z( sweeps );
+            }
+            SyncVectorPatch::sum<double,Field>( Ap_, *this, smpi, timers, 0 );
 
-        // compute new directio
-        for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
-            ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            // compute new residual norm and r.z in a single reduction
+            double products_local[2] = { 0., 0. };
+            double products[2];
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                products_local[0] += ( *this )( ipatch )->EMfields->compute_r();
+                products_local[1] += ( *this )( ipatch )->EMfields->compute_rz();
+            }
+            MPI_Allreduce( products_local, products, 2, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            rnew_dot_rnew = products[0];
+            rnew_dot_znew = products[1];
+            if( smpi->isMaster() ) {
+                DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
+            }
+
+            // compute new direction
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p_from_z( rnew_dot_znew, r_dot_z );
+            }
+        } else {
+            // compute new residual norm
+            rnew_dot_rnew       = 0.0;
+            rnew_dot_rnew_local = 0.0;
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                rnew_dot_rnew_local += ( *this )( ipatch )->EMfields->compute_r();
+            }
+            MPI_Allreduce( &rnew_dot_rnew_local, &rnew_dot_rnew, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD );
+            if( smpi->isMaster() ) {
+                DEBUG( "new residual norm: rnew_dot_rnew = " << rnew_dot_rnew );
+            }
+
+            // compute new directio
+            for( unsigned int ipatch=0 ; ipatch<this->size() ; ipatch++ ) {
+                ( *this )( ipatch )->EMfields->update_p( rnew_dot_rnew, r_dot_r );
+            }
         }
 
         // compute control parameter
@@ -1813,7 +1924,7 @@ void VectorPatch::runNonRelativisticPoissonModule( Params &params, SmileiMPI* sm
         if( !isRhoNull( smpi ) ) {
             TITLE( "Initializing E field through Poisson solver" );
             if (params.geometry != "AMcylindrical"){
-                solvePoisson( params, smpi );
+                solvePoisson( params, smpi, timers );
             } else {
                 solvePoissonAM( params, smpi );
             }
@@ -3476,7 +3587,19 @@ void VectorPatch::applyAntennas( double time )
 void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
 {
     timers.collisions.restart();
-
+    
+    unsigned int ncoll = patches_[0]->vecCollisions.size();
+    
+    // Nothing to do if no collisions are due at this timestep
+    bool any_due = false;
+    for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
+        any_due = any_due || patches_[0]->vecCollisions[icoll]->isDue( itime );
+    }
+    if( ! any_due ) {
+        timers.collisions.update();
+        return;
+    }
+    
     if( Collisions::debye_length_required ) {
         #pragma omp for schedule(runtime)
         for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
@@ -3484,13 +3607,15 @@ void VectorPatch::applyCollisions( Params &params, int itime, Timers &timers )
         }
     }
     
-    unsigned int ncoll = patches_[0]->vecCollisions.size();
-    
     #pragma omp for schedule(runtime)
     for( unsigned int ipatch=0 ; ipatch<size() ; ipatch++ ) {
+        double timeline_start = timers.timeline.now();
         for( unsigned int icoll=0 ; icoll<ncoll; icoll++ ) {
-            patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
+            if( patches_[ipatch]->vecCollisions[icoll]->isDue( itime ) ) {
+                patches_[ipatch]->vecCollisions[icoll]->collide( params, patches_[ipatch], itime, localDiags );
+            }
         }
+        timers.timeline.record( Timeline::Collisions, timeline_start, patches_[ipatch]->hindex );
     }
     
     #pragma omp single
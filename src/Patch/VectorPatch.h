@@ -11,6 +11,7 @@
 #include "ProjectorFactory.h"
 
 #include "DiagnosticScalar.h"
+#include "ParticleBinningEngine.h"
 
 #include "Checkpoint.h"
 #include "OpenPMDparams.h"
@@ -190,7 +191,7 @@ public :
     bool isRhoNull( SmileiMPI *smpi );
     
     //! Solve Poisson to initialize E
-    void solvePoisson( Params &params, SmileiMPI *smpi );
+    void solvePoisson( Params &params, SmileiMPI *smpi, Timers &timers );
     void runNonRelativisticPoissonModule( Params &params, SmileiMPI* smpi,  Timers &timers );
     void solvePoissonAM( Params &params, SmileiMPI *smpi);
     
@@ -397,7 +398,13 @@ private :
     //! Current intensity of antennas
     double antenna_intensity;
     
+    //! Number of window moves at the last exchange of E and B (when exchange_fields_each > 1)
+    unsigned int nmoved_at_fields_exchange_;
+    
     std::vector<Timer *> diag_timers;
+    
+    //! Runs together the particle binning diagnostics due at the same timestep
+    ParticleBinningEngine particle_binning_engine_;
 };
 
 
@@ -1,6 +1,8 @@
 #include "Function.h"
 #include <complex>
 #include <cmath>
+#include <map>
+#include <algorithm>
 
 using namespace std;
 
@@ -146,6 +148,47 @@ double Function_Constant3D::valueAt( vector<double> x_cell, double time )
     return ( ( x_cell[0]>=xvacuum ) && ( x_cell[1]>=yvacuum ) && ( x_cell[2]>=zvacuum ) ) ? value : 0.;
 }
 
+// Constant profiles at several points (the time, if any, is not used)
+bool Function_Constant1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( x[i]>=xvacuum ) ? value : 0.;
+    }
+    return true;
+}
+bool Function_Constant2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( ( x[i]>=xvacuum ) && ( y[i]>=yvacuum ) ) ? value : 0.;
+    }
+    return true;
+}
+bool Function_Constant3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1], *z = coordinates[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = ( ( x[i]>=xvacuum ) && ( y[i]>=yvacuum ) && ( z[i]>=zvacuum ) ) ? value : 0.;
+    }
+    return true;
+}
+bool Function_Constant1D::valuesAt( const double *const *coordinates, double time, unsigned int n, double *values )
+{
+    return valuesAt( coordinates, n, values );
+}
+bool Function_Constant2D::valuesAt( const double *const *coordinates, double time, unsigned int n, double *values )
+{
+    return valuesAt( coordinates, n, values );
+}
+bool Function_Constant3D::valuesAt( const double *const *coordinates, double time, unsigned int n, double *values )
+{
+    return valuesAt( coordinates, n, values );
+}
+
 // Trapezoidal profiles
 inline double trapeze( double x, double plateau, double slope1, double slope2, double invslope1, double invslope2 )
 {
@@ -184,43 +227,93 @@ double Function_Trapezoidal3D::valueAt( vector<double> x_cell )
            * trapeze( x_cell[1]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 )
            * trapeze( x_cell[2]-zvacuum, zplateau, zslope1, zslope2, invzslope1, invzslope2 );
 }
+bool Function_Trapezoidal1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 );
+    }
+    return true;
+}
+bool Function_Trapezoidal2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
+                    * trapeze( y[i]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 );
+    }
+    return true;
+}
+bool Function_Trapezoidal3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1], *z = coordinates[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * trapeze( x[i]-xvacuum, xplateau, xslope1, xslope2, invxslope1, invxslope2 )
+                    * trapeze( y[i]-yvacuum, yplateau, yslope1, yslope2, invyslope1, invyslope2 )
+                    * trapeze( z[i]-zvacuum, zplateau, zslope1, zslope2, invzslope1, invzslope2 );
+    }
+    return true;
+}
 
 // Gaussian profiles
+inline double gaussian( double x, double vacuum, double length, double center, double invsigma, int order )
+{
+    double factor = order ? exp( -pow( x-center, order ) * invsigma ) : 1.;
+    return ( x > vacuum && x < vacuum+length ) ? factor : 0.;
+}
 double Function_Gaussian1D::valueAt( vector<double> x_cell )
 {
-    double x = x_cell[0], xfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
-    }
-    return value * xfactor;
+    return value * gaussian( x_cell[0], xvacuum, xlength, xcenter, invxsigma, xorder );
 }
 double Function_Gaussian2D::valueAt( vector<double> x_cell )
 {
-    double x = x_cell[0], xfactor=0.;
-    double y = x_cell[1], yfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
-    }
-    if( y > yvacuum  && y < yvacuum+ylength ) {
-        yfactor = yorder ? exp( -pow( y-ycenter, yorder ) * invysigma ) : 1.;
-    }
-    return value * xfactor * yfactor;
+    return value
+           * gaussian( x_cell[0], xvacuum, xlength, xcenter, invxsigma, xorder )
+           * gaussian( x_cell[1], yvacuum, ylength, ycenter, invysigma, yorder );
 }
 double Function_Gaussian3D::valueAt( vector<double> x_cell )
 {
-    double x = x_cell[0], xfactor=0.;
-    double y = x_cell[1], yfactor=0.;
-    double z = x_cell[2], zfactor=0.;
-    if( x > xvacuum  && x < xvacuum+xlength ) {
-        xfactor = xorder ? exp( -pow( x-xcenter, xorder ) * invxsigma ) : 1.;
+    return value
+           * gaussian( x_cell[0], xvacuum, xlength, xcenter, invxsigma, xorder )
+           * gaussian( x_cell[1], yvacuum, ylength, ycenter, invysigma, yorder )
+           * gaussian( x_cell[2], zvacuum, zlength, zcenter, invzsigma, zorder );
+}
+bool Function_Gaussian1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value * gaussian( x[i], xvacuum, xlength, xcenter, invxsigma, xorder );
     }
-    if( y > yvacuum  && y < yvacuum+ylength ) {
-        yfactor = yorder ? exp( -pow( y-ycenter, yorder ) * invysigma ) : 1.;
+    return true;
+}
+bool Function_Gaussian2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * gaussian( x[i], xvacuum, xlength, xcenter, invxsigma, xorder )
+                    * gaussian( y[i], yvacuum, ylength, ycenter, invysigma, yorder );
     }
-    if( z > zvacuum  && z < zvacuum+zlength ) {
-        zfactor = zorder ? exp( -pow( z-zcenter, zorder ) * invzsigma ) : 1.;
+    return true;
+}
+bool Function_Gaussian3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1], *z = coordinates[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = value
+                    * gaussian( x[i], xvacuum, xlength, xcenter, invxsigma, xorder )
+                    * gaussian( y[i], yvacuum, ylength, ycenter, invysigma, yorder )
+                    * gaussian( z[i], zvacuum, zlength, zcenter, invzsigma, zorder );
     }
-    return value * xfactor * yfactor * zfactor;
+    return true;
 }
 
 // Polygonal profiles
@@ -261,42 +354,95 @@ double Function_Polygonal3D::valueAt( vector<double> x_cell )
     return 0.;
 }
 
+// Polygonal profiles at several points: the segments are scanned backwards
+// so that the first segment containing each point is kept, as above
+inline void polygonal( const double *x, unsigned int n, double *values, const vector<double> &xpoints, const vector<double> &xvalues, const vector<double> &xslopes )
+{
+    int npoints = xpoints.size();
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = 0.;
+    }
+    for( int k=npoints-1; k>0; k-- ) {
+        double point = xpoints[k], previous_point = xpoints[k-1], previous_value = xvalues[k-1], slope = xslopes[k-1];
+        #pragma omp simd
+        for( unsigned int i=0; i<n; i++ ) {
+            values[i] = ( x[i] < point ) ? previous_value + slope * ( x[i] - previous_point ) : values[i];
+        }
+    }
+    if( npoints > 0 ) {
+        double point = xpoints[0];
+        #pragma omp simd
+        for( unsigned int i=0; i<n; i++ ) {
+            values[i] = ( x[i] < point ) ? 0. : values[i];
+        }
+    }
+}
+bool Function_Polygonal1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    polygonal( coordinates[0], n, values, xpoints, xvalues, xslopes );
+    return true;
+}
+bool Function_Polygonal2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    polygonal( coordinates[0], n, values, xpoints, xvalues, xslopes );
+    return true;
+}
+bool Function_Polygonal3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    polygonal( coordinates[0], n, values, xpoints, xvalues, xslopes );
+    return true;
+}
+
 // Cosine profiles
+inline double cosine( double x, double base, double amplitude, double phi, double number2pi )
+{
+    return ( x > 0. && x < 1. ) ? base + amplitude * cos( phi + number2pi * x ) : 0.;
+}
 double Function_Cosine1D::valueAt( vector<double> x_cell )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
-    }
-    return xfactor;
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi );
 }
 double Function_Cosine2D::valueAt( vector<double> x_cell )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    double y = ( x_cell[1] - yvacuum ) * invylength, yfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
-    }
-    if( y > 0. && y < 1. ) {
-        yfactor = base + yamplitude * cos( yphi + ynumber2pi * y );
-    }
-    return xfactor * yfactor;
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+           * cosine( ( x_cell[1] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi );
 }
 double Function_Cosine3D::valueAt( vector<double> x_cell )
 {
-    double x = ( x_cell[0] - xvacuum ) * invxlength, xfactor = 0.;
-    double y = ( x_cell[1] - yvacuum ) * invylength, yfactor = 0.;
-    double z = ( x_cell[2] - zvacuum ) * invzlength, zfactor = 0.;
-    if( x > 0. && x < 1. ) {
-        xfactor = base + xamplitude * cos( xphi + xnumber2pi * x );
+    return cosine( ( x_cell[0] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+           * cosine( ( x_cell[1] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi )
+           * cosine( ( x_cell[2] - zvacuum ) * invzlength, base, zamplitude, zphi, znumber2pi );
+}
+bool Function_Cosine1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi );
     }
-    if( y > 0. && y < 1. ) {
-        yfactor = base + yamplitude * cos( yphi + ynumber2pi * y );
+    return true;
+}
+bool Function_Cosine2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+                    * cosine( ( y[i] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi );
     }
-    if( z > 0. && z < 1. ) {
-        zfactor = base + zamplitude * cos( zphi + znumber2pi * z );
+    return true;
+}
+bool Function_Cosine3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0], *y = coordinates[1], *z = coordinates[2];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = cosine( ( x[i] - xvacuum ) * invxlength, base, xamplitude, xphi, xnumber2pi )
+                    * cosine( ( y[i] - yvacuum ) * invylength, base, yamplitude, yphi, ynumber2pi )
+                    * cosine( ( z[i] - zvacuum ) * invzlength, base, zamplitude, zphi, znumber2pi );
     }
-    return xfactor * yfactor * zfactor;
+    return true;
 }
 
 // Polynomial profiles
@@ -367,6 +513,146 @@ double Function_Polynomial3D::valueAt( vector<double> x_cell )
     return r;
 }
 
+// Polynomial profiles at several points: same algorithm as above, where each monomial
+// is an array over a chunk of points
+static const unsigned int polynomial_chunk_size = 128;
+bool Function_Polynomial1D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *x = coordinates[0];
+    double xx0[polynomial_chunk_size], xx[polynomial_chunk_size];
+    for( unsigned int i0=0; i0<n; i0+=polynomial_chunk_size ) {
+        unsigned int m = min( polynomial_chunk_size, n-i0 );
+        double *r = &values[i0];
+        #pragma omp simd
+        for( unsigned int i=0; i<m; i++ ) {
+            r[i] = 0.;
+            xx0[i] = x[i0+i]-x0;
+            xx[i] = 1.;
+        }
+        unsigned int currentOrder = 0;
+        for( unsigned int k=0; k<n_orders; k++ ) {
+            while( currentOrder<orders[k] ) {
+                currentOrder += 1;
+                #pragma omp simd
+                for( unsigned int i=0; i<m; i++ ) {
+                    xx[i] *= xx0[i];
+                }
+            }
+            double c = coeffs[k][0];
+            #pragma omp simd
+            for( unsigned int i=0; i<m; i++ ) {
+                r[i] += c * xx[i];
+            }
+        }
+    }
+    return true;
+}
+bool Function_Polynomial2D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const unsigned int N = polynomial_chunk_size;
+    const double *x = coordinates[0], *y = coordinates[1];
+    double xx0[N], yy0[N];
+    vector<double> xx( n_coeffs*N );
+    for( unsigned int i0=0; i0<n; i0+=N ) {
+        unsigned int m = min( N, n-i0 );
+        double *r = &values[i0];
+        #pragma omp simd
+        for( unsigned int i=0; i<m; i++ ) {
+            r[i] = 0.;
+            xx0[i] = x[i0+i]-x0;
+            yy0[i] = y[i0+i]-y0;
+            xx[i] = 1.;
+        }
+        unsigned int currentOrder = 0, j;
+        for( unsigned int k=0; k<n_orders; k++ ) {
+            while( currentOrder<orders[k] ) {
+                currentOrder += 1;
+                j = currentOrder;
+                double *xj = &xx[j*N], *xjm1 = &xx[( j-1 )*N];
+                #pragma omp simd
+                for( unsigned int i=0; i<m; i++ ) {
+                    xj[i] = xjm1[i] * yy0[i];
+                }
+                do {
+                    j--;
+                    xj = &xx[j*N];
+                    #pragma omp simd
+                    for( unsigned int i=0; i<m; i++ ) {
+                        xj[i] *= xx0[i];
+                    }
+                } while( j>0 );
+            }
+            for( j=0; j<=orders[k]; j++ ) {
+                double c = coeffs[k][j], *xj = &xx[j*N];
+                #pragma omp simd
+                for( unsigned int i=0; i<m; i++ ) {
+                    r[i] += c * xj[i];
+                }
+            }
+        }
+    }
+    return true;
+}
+bool Function_Polynomial3D::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const unsigned int N = polynomial_chunk_size;
+    const double *x = coordinates[0], *y = coordinates[1], *z = coordinates[2];
+    double xx0[N], yy0[N], zz0[N];
+    vector<double> xx( n_coeffs*N );
+    for( unsigned int i0=0; i0<n; i0+=N ) {
+        unsigned int m = min( N, n-i0 );
+        double *r = &values[i0];
+        #pragma omp simd
+        for( unsigned int i=0; i<m; i++ ) {
+            r[i] = 0.;
+            xx0[i] = x[i0+i]-x0;
+            yy0[i] = y[i0+i]-y0;
+            zz0[i] = z[i0+i]-z0;
+            xx[i] = 1.;
+        }
+        unsigned int currentOrder = 0, current_n_coeffs = 1, j, k;
+        for( unsigned int iorder=0; iorder<n_orders; iorder++ ) {
+            while( currentOrder<orders[iorder] ) {
+                currentOrder += 1;
+                k = current_n_coeffs-1;
+                j = current_n_coeffs+currentOrder;
+                double *xj = &xx[j*N], *xk = &xx[k*N];
+                #pragma omp simd
+                for( unsigned int i=0; i<m; i++ ) {
+                    xj[i] = xk[i] * zz0[i];
+                }
+                do {
+                    j--;
+                    xj = &xx[j*N];
+                    xk = &xx[k*N];
+                    #pragma omp simd
+                    for( unsigned int i=0; i<m; i++ ) {
+                        xj[i] = xk[i] * yy0[i];
+                    }
+                    k--;
+                } while( j>current_n_coeffs );
+                do {
+                    j--;
+                    xj = &xx[j*N];
+                    #pragma omp simd
+                    for( unsigned int i=0; i<m; i++ ) {
+                        xj[i] *= xx0[i];
+                    }
+                } while( j>0 );
+                current_n_coeffs += currentOrder+1;
+            }
+            for( j=0; j<current_n_coeffs; j++ ) {
+                double c = coeffs[iorder][j], *xj = &xx[j*N];
+                #pragma omp simd
+                for( unsigned int i=0; i<m; i++ ) {
+                    r[i] += c * xj[i];
+                }
+            }
+        }
+    }
+    return true;
+}
+
 // Time constant profile
 double Function_TimeConstant::valueAt( double time )
 {
@@ -445,3 +731,294 @@ double Function_TimeSin2Plateau::valueAt( double time )
         return 0.;
     }
 }
+
+
+// Time profiles at several times (coordinates[0] contains the times)
+bool Function_TimeConstant::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimeConstant::valueAt( t[i] );
+    }
+    return true;
+}
+bool Function_TimeTrapezoidal::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimeTrapezoidal::valueAt( t[i] );
+    }
+    return true;
+}
+bool Function_TimeGaussian::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimeGaussian::valueAt( t[i] );
+    }
+    return true;
+}
+bool Function_TimePolygonal::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    polygonal( coordinates[0], n, values, points, this->values, slopes );
+    return true;
+}
+bool Function_TimeCosine::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimeCosine::valueAt( t[i] );
+    }
+    return true;
+}
+bool Function_TimePolynomial::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimePolynomial::valueAt( t[i] );
+    }
+    return true;
+}
+bool Function_TimeSin2Plateau::valuesAt( const double *const *coordinates, unsigned int n, double *values )
+{
+    const double *t = coordinates[0];
+    #pragma omp simd
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = Function_TimeSin2Plateau::valueAt( t[i] );
+    }
+    return true;
+}
+
+
+// Python functions translated into a program
+Function_Compiled::Function_Compiled( vector<string> &operations, vector<double> &values, unsigned int nvariables ) :
+    values_( values ),
+    nvariables_( nvariables ),
+    stack_depth_( 0 ),
+    valid_( true )
+{
+    static const map<string, int> names = {
+        {"var", VAR}, {"const", CONST}, {"add", ADD}, {"sub", SUB}, {"mul", MUL}, {"div", DIV}, {"pow", POW},
+        {"neg", NEG}, {"abs", ABS}, {"exp", EXP}, {"log", LOG}, {"log10", LOG10}, {"sqrt", SQRT},
+        {"sin", SIN}, {"cos", COS}, {"tan", TAN}, {"sinh", SINH}, {"cosh", COSH}, {"tanh", TANH},
+        {"arcsin", ARCSIN}, {"arccos", ARCCOS}, {"arctan", ARCTAN}, {"arctan2", ARCTAN2},
+        {"floor", FLOOR}, {"ceil", CEIL}, {"lt", LT}, {"le", LE}, {"gt", GT}, {"ge", GE}, {"eq", EQ}, {"ne", NE},
+        {"and", AND}, {"or", OR}, {"not", NOT}, {"select", SELECT}
+    };
+    
+    if( nvariables_ == 0 || nvariables_ > max_variables_ ) {
+        valid_ = false;
+        return;
+    }
+    
+    // Translate the operations and verify the stack
+    int depth = 0;
+    for( unsigned int k=0; k<operations.size(); k++ ) {
+        map<string, int>::const_iterator it = names.find( operations[k] );
+        if( it == names.end() || k >= values_.size() ) {
+            valid_ = false;
+            return;
+        }
+        int op = it->second;
+        operations_.push_back( op );
+        int nargs;
+        if( op == VAR || op == CONST ) {
+            nargs = 0;
+            if( op == VAR && ( values_[k] < 0. || values_[k] >= nvariables_ ) ) {
+                valid_ = false;
+            }
+        } else if( op == SELECT ) {
+            nargs = 3;
+        } else if( op == ADD || op == SUB || op == MUL || op == DIV || op == POW || op == ARCTAN2
+                   || ( op >= LT && op <= OR ) ) {
+            nargs = 2;
+        } else {
+            nargs = 1;
+        }
+        if( depth < nargs ) {
+            valid_ = false;
+        }
+        depth += 1 - nargs;
+        stack_depth_ = max( stack_depth_, ( unsigned int ) depth );
+    }
+    if( depth != 1 || stack_depth_ > max_stack_depth_ ) {
+        valid_ = false;
+    }
+}
+
+Function_Compiled::Function_Compiled( Function_Compiled *f ) :
+    operations_( f->operations_ ),
+    values_( f->values_ ),
+    nvariables_( f->nvariables_ ),
+    stack_depth_( f->stack_depth_ ),
+    valid_( f->valid_ )
+{
+}
+
+double Function_Compiled::valueAt( double x )
+{
+    double value, stack[max_stack_depth_];
+    const double *variables[1] = { &x };
+    evaluate( variables, 0., 1, &value, stack, 1 );
+    return value;
+}
+
+double Function_Compiled::valueAt( vector<double> x_cell, double time )
+{
+    double value, stack[max_stack_depth_];
+    const double *variables[max_variables_];
+    for( unsigned int ivar=0; ivar<nvariables_-1; ivar++ ) {
+        variables[ivar] = &x_cell[ivar];
+    }
+    variables[nvariables_-1] = NULL;
+    evaluate( variables, time, 1, &value, stack, 1 );
+    return value;
+}
+
+double Function_Compiled::valueAt( vector<double> x_cell )
+{
+    double value, stack[max_stack_depth_];
+    const double *variables[max_variables_];
+    for( unsigned int ivar=0; ivar<nvariables_; ivar++ ) {
+        variables[ivar] = &x_cell[ivar];
+    }
+    evaluate( variables, 0., 1, &value, stack, 1 );
+    return value;
+}
+
+bool Function_Compiled::usesVariable( unsigned int ivar )
+{
+    for( unsigned int k=0; k<operations_.size(); k++ ) {
+        if( operations_[k] == VAR && ( unsigned int ) values_[k] == ivar ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Function_Compiled::valuesAt( const double *const *variables, unsigned int n, double *values )
+{
+    vector<double> stack( stack_depth_ * chunk_size_ );
+    const double *chunk_variables[max_variables_];
+    for( unsigned int i0=0; i0<n; i0+=chunk_size_ ) {
+        for( unsigned int ivar=0; ivar<nvariables_; ivar++ ) {
+            chunk_variables[ivar] = variables[ivar] + i0;
+        }
+        evaluate( chunk_variables, 0., min( chunk_size_, n-i0 ), &values[i0], &stack[0], chunk_size_ );
+    }
+    return true;
+}
+
+bool Function_Compiled::valuesAt( const double *const *variables, double time, unsigned int n, double *values )
+{
+    vector<double> stack( stack_depth_ * chunk_size_ );
+    const double *chunk_variables[max_variables_];
+    chunk_variables[nvariables_-1] = NULL;
+    for( unsigned int i0=0; i0<n; i0+=chunk_size_ ) {
+        for( unsigned int ivar=0; ivar<nvariables_-1; ivar++ ) {
+            chunk_variables[ivar] = variables[ivar] + i0;
+        }
+        evaluate( chunk_variables, time, min( chunk_size_, n-i0 ), &values[i0], &stack[0], chunk_size_ );
+    }
+    return true;
+}
+
+void Function_Compiled::evaluate( const double *const *variables, double time, unsigned int n, double *values, double *stack, unsigned int stride )
+{
+    // Each operation is applied to all points before the next one, so that the loops vectorize
+    unsigned int top = 0; // number of arrays in the stack
+    for( unsigned int k=0; k<operations_.size(); k++ ) {
+        double *s = &stack[top*stride];                        // next free array
+        double *a = top > 0 ? &stack[( top-1 )*stride] : NULL; // last array
+        double *b = top > 1 ? &stack[( top-2 )*stride] : NULL; // second to last array
+        double *c = top > 2 ? &stack[( top-3 )*stride] : NULL; // third to last array
+        switch( operations_[k] ) {
+            case VAR: {
+                const double *v = variables[( unsigned int ) values_[k]];
+                if( v ) {
+                    for( unsigned int i=0; i<n; i++ ) {
+                        s[i] = v[i];
+                    }
+                } else {
+                    for( unsigned int i=0; i<n; i++ ) {
+                        s[i] = time;
+                    }
+                }
+                top++;
+                break;
+            }
+            case CONST: {
+                double v = values_[k];
+                for( unsigned int i=0; i<n; i++ ) {
+                    s[i] = v;
+                }
+                top++;
+                break;
+            }
+#define SMILEI_COMPILED_UNARY( OP, EXPR ) \
+            case OP: \
+                _Pragma( "omp simd" ) \
+                for( unsigned int i=0; i<n; i++ ) { \
+                    a[i] = EXPR; \
+                } \
+                break;
+#define SMILEI_COMPILED_BINARY( OP, EXPR ) \
+            case OP: \
+                _Pragma( "omp simd" ) \
+                for( unsigned int i=0; i<n; i++ ) { \
+                    b[i] = EXPR; \
+                } \
+                top--; \
+                break;
+            SMILEI_COMPILED_BINARY( ADD, b[i] + a[i] )
+            SMILEI_COMPILED_BINARY( SUB, b[i] - a[i] )
+            SMILEI_COMPILED_BINARY( MUL, b[i] * a[i] )
+            SMILEI_COMPILED_BINARY( DIV, b[i] / a[i] )
+            SMILEI_COMPILED_BINARY( POW, pow( b[i], a[i] ) )
+            SMILEI_COMPILED_BINARY( ARCTAN2, atan2( b[i], a[i] ) )
+            SMILEI_COMPILED_BINARY( LT, b[i] <  a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( LE, b[i] <= a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( GT, b[i] >  a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( GE, b[i] >= a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( EQ, b[i] == a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( NE, b[i] != a[i] ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( AND, ( b[i] != 0. && a[i] != 0. ) ? 1. : 0. )
+            SMILEI_COMPILED_BINARY( OR, ( b[i] != 0. || a[i] != 0. ) ? 1. : 0. )
+            SMILEI_COMPILED_UNARY( NEG, -a[i] )
+            SMILEI_COMPILED_UNARY( ABS, abs( a[i] ) )
+            SMILEI_COMPILED_UNARY( EXP, exp( a[i] ) )
+            SMILEI_COMPILED_UNARY( LOG, log( a[i] ) )
+            SMILEI_COMPILED_UNARY( LOG10, log10( a[i] ) )
+            SMILEI_COMPILED_UNARY( SQRT, sqrt( a[i] ) )
+            SMILEI_COMPILED_UNARY( SIN, sin( a[i] ) )
+            SMILEI_COMPILED_UNARY( COS, cos( a[i] ) )
+            SMILEI_COMPILED_UNARY( TAN, tan( a[i] ) )
+            SMILEI_COMPILED_UNARY( SINH, sinh( a[i] ) )
+            SMILEI_COMPILED_UNARY( COSH, cosh( a[i] ) )
+            SMILEI_COMPILED_UNARY( TANH, tanh( a[i] ) )
+            SMILEI_COMPILED_UNARY( ARCSIN, asin( a[i] ) )
+            SMILEI_COMPILED_UNARY( ARCCOS, acos( a[i] ) )
+            SMILEI_COMPILED_UNARY( ARCTAN, atan( a[i] ) )
+            SMILEI_COMPILED_UNARY( FLOOR, floor( a[i] ) )
+            SMILEI_COMPILED_UNARY( CEIL, ceil( a[i] ) )
+            SMILEI_COMPILED_UNARY( NOT, a[i] == 0. ? 1. : 0. )
+#undef SMILEI_COMPILED_UNARY
+#undef SMILEI_COMPILED_BINARY
+            case SELECT:
+                #pragma omp simd
+                for( unsigned int i=0; i<n; i++ ) {
+                    c[i] = c[i] != 0. ? b[i] : a[i];
+                }
+                top -= 2;
+                break;
+        }
+    }
+    for( unsigned int i=0; i<n; i++ ) {
+        values[i] = stack[i];
+    }
+}
@@ -50,6 +50,19 @@ public:
         return 0.; // virtual => will be redefined
     };
     
+    //! Gets the values of a N-D function at n points: the coordinate ivar of the point i is coordinates[ivar][i].
+    //! Returns false if the function does not provide this batched evaluation (nothing is computed)
+    virtual bool valuesAt( const double *const *, unsigned int, double * )
+    {
+        return false; // virtual => may be redefined
+    };
+    
+    //! Same as above, for a N-D function of space and time: coordinates only contains the spatial coordinates
+    virtual bool valuesAt( const double *const *, double, unsigned int, double * )
+    {
+        return false; // virtual => may be redefined
+    };
+    
     //! Provide information about the function
     virtual std::string getInfo()
     {
@@ -178,6 +191,63 @@ public:
 private:
     PyObject *py_profile;
 };
+
+// Child class for python functions translated into a program (see _compile_profile in pyprofiles.py)
+
+class Function_Compiled : public Function
+{
+public:
+    //! Builds the program from the names of the operations (postfix order) and their values
+    Function_Compiled( std::vector<std::string> &operations, std::vector<double> &values, unsigned int nvariables );
+    Function_Compiled( Function_Compiled *f );
+    double valueAt( double ); // time
+    double valueAt( std::vector<double>, double ); // space + time
+    double valueAt( std::vector<double> ); // space
+    std::complex<double> complexValueAt( std::vector<double> x, double t ) // space + time
+    {
+        return valueAt( x, t );
+    };
+    std::complex<double> complexValueAt( std::vector<double> x ) // space
+    {
+        return valueAt( x );
+    };
+    bool valuesAt( const double *const *variables, unsigned int n, double *values );
+    bool valuesAt( const double *const *variables, double time, unsigned int n, double *values );
+    //! True if all the operations were recognized
+    bool isValid()
+    {
+        return valid_;
+    };
+    //! True if the variable ivar appears in the program
+    bool usesVariable( unsigned int ivar );
+    std::string getInfo()
+    {
+        return " (compiled: " + std::to_string( operations_.size() ) + " operations)";
+    };
+    
+    //! Elementary operations of the program
+    enum Operation { VAR, CONST, ADD, SUB, MUL, DIV, POW, NEG, ABS, EXP, LOG, LOG10, SQRT, SIN, COS, TAN,
+                     SINH, COSH, TANH, ARCSIN, ARCCOS, ARCTAN, ARCTAN2, FLOOR, CEIL, LT, LE, GT, GE, EQ, NE,
+                     AND, OR, NOT, SELECT
+                   };
+private:
+    //! Evaluates the program for n points, with a stack of stack_depth_ arrays separated by stride
+    //! (a NULL variable is replaced by time)
+    void evaluate( const double *const *variables, double time, unsigned int n, double *values, double *stack, unsigned int stride );
+    
+    std::vector<int> operations_;
+    std::vector<double> values_;
+    unsigned int nvariables_;
+    //! Maximum depth of the stack of the program
+    unsigned int stack_depth_;
+    bool valid_;
+    //! Number of points evaluated together in valuesAt
+    static const unsigned int chunk_size_ = 128;
+    //! Largest stack depth and number of variables accepted (larger programs are not compiled)
+    static const unsigned int max_stack_depth_ = 64;
+    static const unsigned int max_variables_ = 16;
+};
+
 /*
 class Function_Python4D_Complex : public Function
 {
@@ -211,6 +281,8 @@ public:
     };
     double valueAt( std::vector<double> );
     double valueAt( std::vector<double>, double );
+    bool valuesAt( const double *const *, unsigned int, double * );
+    bool valuesAt( const double *const *, double, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -238,6 +310,8 @@ public:
     };
     double valueAt( std::vector<double> );
     double valueAt( std::vector<double>, double );
+    bool valuesAt( const double *const *, unsigned int, double * );
+    bool valuesAt( const double *const *, double, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -267,6 +341,8 @@ public:
     };
     double valueAt( std::vector<double> );
     double valueAt( std::vector<double>, double );
+    bool valuesAt( const double *const *, unsigned int, double * );
+    bool valuesAt( const double *const *, double, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value) + ")";
@@ -301,6 +377,7 @@ public:
         invxslope2 = 1./xslope2;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -352,6 +429,7 @@ public:
         invyslope2 = 1./yslope2;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -421,6 +499,7 @@ public:
         invzslope2 = 1./zslope2;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -471,6 +550,7 @@ public:
         xorder    = f->xorder ;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -523,6 +603,7 @@ public:
         yorder    = f->yorder ;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -588,6 +669,7 @@ public:
         zorder    = f->zorder ;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (value: " + std::to_string(value)
@@ -626,6 +708,7 @@ public:
         npoints = xpoints.size();
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -670,6 +753,7 @@ public:
         npoints = xpoints.size();
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -714,6 +798,7 @@ public:
         npoints = xpoints.size();
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (xpoints: [";
@@ -765,6 +850,7 @@ public:
         xnumber2pi = f->xnumber2pi     ;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -819,6 +905,7 @@ public:
         ynumber2pi = f->ynumber2pi;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -886,6 +973,7 @@ public:
         znumber2pi = f->znumber2pi;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = "";
@@ -924,6 +1012,7 @@ public:
         n_orders = f->n_orders;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0) + ", orders: [";
@@ -975,6 +1064,7 @@ public:
         n_coeffs = f->n_coeffs;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0) + ", y0: " + std::to_string(y0) + ", orders: [";
@@ -1028,6 +1118,7 @@ public:
         n_coeffs = f->n_coeffs;
     };
     double valueAt( std::vector<double> );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (x0: " + std::to_string(x0)
@@ -1068,6 +1159,7 @@ public:
         start = f->start;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (" + std::to_string(start) + ")";
@@ -1100,6 +1192,7 @@ public:
         invslope2 = 1./slope2;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (start: " + std::to_string(start)
@@ -1137,6 +1230,7 @@ public:
         order    = f->order   ;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
     std::string getInfo ()
     {
         std::string info = " (start: " + std::to_string(start)
@@ -1170,6 +1264,7 @@ public:
         npoints = points.size();
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
 private:
     std::vector<double> points, values, slopes;
     int npoints;
@@ -1200,6 +1295,7 @@ public:
         freq      = f->freq     ;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
 private:
     double base, amplitude, start, end, phi, freq;
 };
@@ -1221,6 +1317,7 @@ public:
         t0     = f->t0    ;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
 private:
     double t0;
     std::vector<int> orders;
@@ -1248,6 +1345,7 @@ public:
         end     = f->end;
     };
     double valueAt( double );
+    bool valuesAt( const double *const *, unsigned int, double * );
 private:
     double start, slope1, plateau, slope2, end;
 };
@@ -11,7 +11,8 @@ using namespace std;
 Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bool try_numpy ) :
     profileName( "" ),
     nvariables_( nvariables ),
-    uses_numpy( false )
+    uses_numpy( false ),
+    compiled_( false )
 {
     ostringstream info_( "" );
     info_ << nvariables_ << "D";
@@ -280,8 +281,34 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
             }
         }
         
-        // Assign the evaluating function, which depends on the number of arguments
-        if( nvariables_ == 1 ) {
+        // Try to translate the function into a program evaluated natively (see pyprofiles.py)
+        PyObject *compile = PyObject_GetAttrString( PyImport_AddModule( "__main__" ), "_compile_profile" );
+        if( compile ) {
+            PyObject *program = PyObject_CallFunction( compile, const_cast<char *>( "Oi" ), py_profile, nvariables_ );
+            PyTools::checkPyError( false, false );
+            vector<string> operations;
+            vector<double> values;
+            if( program && PyTuple_Check( program ) && PyTuple_Size( program ) == 2
+                    && PyTools::py2vector( PyTuple_GetItem( program, 0 ), operations )
+                    && PyTools::py2vector( PyTuple_GetItem( program, 1 ), values ) ) {
+                Function_Compiled *f = new Function_Compiled( operations, values, nvariables_ );
+                if( f->isValid() ) {
+                    function = f;
+                    compiled_ = true;
+                    uses_numpy = false;
+                } else {
+                    delete f;
+                }
+            }
+            Py_XDECREF( program );
+            Py_DECREF( compile );
+        }
+        PyTools::checkPyError( false, false );
+        
+        // Otherwise, assign the evaluating function, which depends on the number of arguments
+        if( compiled_ ) {
+            DEBUG( "Profile `"<<name<<"`: compiled" );
+        } else if( nvariables_ == 1 ) {
             function = new Function_Python1D( py_profile );
         } else if( nvariables_ == 2 ) {
             function = new Function_Python2D( py_profile );
@@ -292,7 +319,7 @@ Profile::Profile( PyObject *py_profile, unsigned int nvariables, string name, bo
         }
         
         info_ << " user-defined function";
-        if( try_numpy ) {
+        if( try_numpy && !compiled_ ) {
             if( uses_numpy ) {
                 info_ << " (uses numpy)";
             } else {
@@ -314,6 +341,7 @@ Profile::Profile( Profile *p )
     nvariables_ = p->nvariables_;
     info        = p->info       ;
     uses_numpy  = p->uses_numpy ;
+    compiled_   = p->compiled_  ;
     if( profileName != "" ) {
         if( profileName == "constant" ) {
             if( nvariables_ == 1 ) {
@@ -378,6 +406,8 @@ Profile::Profile( Profile *p )
         } else if( profileName == "tsin2plateau" ) {
             function = new Function_TimeSin2Plateau( static_cast<Function_TimeSin2Plateau *>( p->function ) );
         }
+    } else if( compiled_ ) {
+        function = new Function_Compiled( static_cast<Function_Compiled *>( p->function ) );
     } else {
         if( nvariables_ == 1 ) {
             function = new Function_Python1D( static_cast<Function_Python1D *>( p->function ) );
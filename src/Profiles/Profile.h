@@ -49,6 +49,14 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // Evaluate all points at once if the function allows it (built-in and compiled profiles)
+        std::vector<const double *> arrays( nvar );
+        for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+            arrays[ivar] = coordinates[ivar]->data();
+        }
+        if( function->valuesAt( &arrays[0], size, ret.data() ) ) {
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -91,6 +99,14 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // Evaluate all points at once if the function allows it (built-in and compiled profiles)
+        std::vector<const double *> arrays( nvar );
+        for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+            arrays[ivar] = coordinates[ivar]->data();
+        }
+        if( function->valuesAt( &arrays[0], time, size, ret.data() ) ) {
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -133,6 +149,18 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // Evaluate all points at once if the function allows it (real profiles only)
+        std::vector<const double *> arrays( nvar );
+        for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+            arrays[ivar] = coordinates[ivar]->data();
+        }
+        std::vector<double> real_values( size );
+        if( function->valuesAt( &arrays[0], size, real_values.data() ) ) {
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = real_values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -175,6 +203,18 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // Evaluate all points at once if the function allows it (real profiles only)
+        std::vector<const double *> arrays( nvar );
+        for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+            arrays[ivar] = coordinates[ivar]->data();
+        }
+        std::vector<double> real_values( size );
+        if( function->valuesAt( &arrays[0], time, size, real_values.data() ) ) {
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = real_values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -218,6 +258,20 @@ public:
     {
         unsigned int nvar = coordinates.size();
         unsigned int size = coordinates[0]->globalDims_;
+        // Evaluate all points at once if the function allows it (real profiles only)
+        // The time is passed as the last coordinate
+        std::vector<const double *> arrays( nvar+1 );
+        for( unsigned int ivar=0; ivar<nvar; ivar++ ) {
+            arrays[ivar] = coordinates[ivar]->data();
+        }
+        arrays[nvar] = time->data();
+        std::vector<double> real_values( size );
+        if( function->valuesAt( &arrays[0], size, real_values.data() ) ) {
+            for( unsigned int i=0; i<size; i++ ) {
+                ret( i ) = real_values[i];
+            }
+            return;
+        }
 #ifdef SMILEI_USE_NUMPY
         // If numpy profile, then expose coordinates as numpy before evaluating profile
         if( uses_numpy ) {
@@ -285,6 +339,9 @@ private:
     //! Whether the profile is using numpy
     bool uses_numpy;
     
+    //! Whether the python profile was translated into a Function_Compiled
+    bool compiled_;
+    
 };//END class Profile
 
 
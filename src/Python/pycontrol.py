@@ -35,7 +35,7 @@ def _smilei_check():
     # Verify classes were not overriden
     for CheckClassName in ["SmileiComponent","Species", "Laser","Collisions",
             "DiagProbe","DiagParticleBinning", "DiagScalar","DiagFields",
-            "DiagTrackParticles","DiagPerformances","ExternalField","PrescribedField",
+            "DiagTrackParticles","DiagPerformances","DiagStream","ExternalField","PrescribedField",
             "SmileiSingleton","Main","Checkpoints","LoadBalancing","MovingWindow",
             "RadiationReaction", "ParticleData", "MultiphotonBreitWheeler",
             "Vectorization"]:
@@ -95,6 +95,8 @@ def _smilei_check():
         e.profile         = toSpaceProfile(e.profile)
     for e in PrescribedField:
         e.profile         = toSpaceProfile(e.profile)
+        e.space_profile   = toSpaceProfile(e.space_profile)
+        e.time_profile    = toTimeProfile (e.time_profile )
     for a in Antenna:
         a.space_profile   = toSpaceProfile(a.space_profile   )
         a.time_profile    = toTimeProfile (a.time_profile    )
@@ -135,7 +137,7 @@ def _keep_python_running():
         if (Main.uncoupled_grids):
             return True
     for e in PrescribedField:
-        profiles += [e.profile]
+        profiles += [e.profile, e.space_profile, e.time_profile]
     for s in ParticleInjector:
         profiles += [s.time_envelope, s.number_density, s.charge_density, s.particles_per_cell] + s.mean_velocity + s.temperature
     for prof in profiles:
@@ -143,7 +145,7 @@ def _keep_python_running():
             return True
     # Verify the tracked species that require a particle selection
     for d in DiagTrackParticles:
-        if d.filter is not None:
+        if d.filter is not None and type(d.filter) is not str:
             return True
     # Verify the particle binning having a function for deposited_quantity or axis type
     for d in DiagParticleBinning._list + DiagScreen._list:
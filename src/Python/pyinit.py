@@ -179,6 +179,7 @@ class Main(SmileiSingleton):
     solve_poisson = True
     poisson_max_iteration = 50000
     poisson_max_error = 1.e-14
+    poisson_preconditioner_sweeps = 0
 
     # Relativistic Poisson tuning
     solve_relativistic_poisson = False
@@ -187,6 +188,8 @@ class Main(SmileiSingleton):
 
     # Default fields
     maxwell_solver = 'Yee'
+    fused_maxwell_solver = False
+    exchange_fields_each = 1
     EM_boundary_conditions = [["periodic"]]
     EM_boundary_conditions_k = []
     save_magnectic_fields_for_SM = True
@@ -198,6 +201,7 @@ class Main(SmileiSingleton):
     print_every = None
     random_seed = None
     print_expected_disk_usage = True
+    compile_profiles = False
 
     def __init__(self, **kwargs):
         # Load all arguments to Main()
@@ -312,6 +316,7 @@ class CurrentFilter(SmileiSingleton):
     """Current filtering parameters"""
     model = "binomial"
     passes = [0]
+    single_exchange = False
 
 class FieldFilter(SmileiSingleton):
     """Fields filtering parameters"""
@@ -417,6 +422,10 @@ class Collisions(SmileiComponent):
     species2 = None
     coulomb_log = 0.
     debug_every = 0
+    every = 1
+    collision_bins_merged = 1
+    subcycling_threshold = 0.
+    subcycling_max = 10
     ionizing = False
     nuclear_reaction = None
     nuclear_reaction_multiplier = 0.
@@ -450,6 +459,7 @@ class DiagRadiationSpectrum(SmileiComponent):
     axes = []
     every = None
     flush_every = 1
+    tabulated_spectrum = False
 
 class DiagScreen(SmileiComponent):
     """Screen diagnostic"""
@@ -475,7 +485,9 @@ class DiagFields(SmileiComponent):
     every = None
     fields = []
     time_average = 1
+    time_average_precision = "double"
     subgrid = None
+    downsample = None
     flush_every = 1
 
 class DiagTrackParticles(SmileiComponent):
@@ -484,13 +496,29 @@ class DiagTrackParticles(SmileiComponent):
     every = 0
     flush_every = 1
     filter = None
+    compile_filter = False
     attributes = ["x", "y", "z", "px", "py", "pz"]
+    ordered = False
+
+class DiagStream(SmileiComponent):
+    """Stream diagnostic (shared memory)"""
+    name = None
+    every = 0
+    fields = []
+    species = []
+    attributes = []
+    particle_stride = 1
+    max_particles = 100000
+    slots = 4
+    policy = "block"
+    block_timeout = 10.
 
 class DiagPerformances(SmileiSingleton):
     """Performances diagnostic"""
     every = 0
     flush_every = 1
     patch_information = True
+    timeline = 0
 
 # external fields
 class ExternalField(SmileiComponent):
@@ -503,6 +531,8 @@ class PrescribedField(SmileiComponent):
     """External Time Field"""
     field = None
     profile = None
+    space_profile = None
+    time_profile = None
 
 # external current (antenna)
 class Antenna(SmileiComponent):
@@ -538,6 +568,9 @@ class RadiationReaction(SmileiComponent):
     # Parameters for computing the tables
     Niel_computation_method = "table"
 
+    # Size of the inverse cumulative distribution tables for the photon sampling (0: not used)
+    inverse_cdf_size = 0
+
 # MutliphotonBreitWheeler pair creation
 class MultiphotonBreitWheeler(SmileiComponent):
     """
@@ -546,6 +579,9 @@ class MultiphotonBreitWheeler(SmileiComponent):
     # Path the tables/databases
     table_path = ""
 
+    # Size of the inverse cumulative distribution table for the pair sampling (0: not used)
+    inverse_cdf_size = 0
+
 # Smilei-defined
 smilei_mpi_rank = 0
 smilei_mpi_size = 1
@@ -703,37 +703,392 @@ def LaserEnvelopeGaussianAM( a0=1., omega=1., focus=None, waist=3., time_envelop
     )
 
 # Define the tools for the propagation of a laser profile
-try:
-    import numpy as np
+_N_LaserOffset = 0
+
+def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., extra_envelope=lambda *a:1., keep_n_strongest_modes=100, angle=0.):
+    global _N_LaserOffset
+    
+    file = 'LaserOffset'+str(_N_LaserOffset)+'.h5'
     
-    _N_LaserOffset = 0
+    L = Laser(
+        box_side = "xmin",
+        file = file,
+    )
     
-    def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., extra_envelope=lambda *a:1., keep_n_strongest_modes=100, angle=0.):
-        global _N_LaserOffset
-        
-        file = 'LaserOffset'+str(_N_LaserOffset)+'.h5'
-        
-        L = Laser(
-            box_side = "xmin",
-            file = file,
-        )
-        
-        L._offset = offset
-        L._extra_envelope = extra_envelope
-        L._profiles = space_time_profile
-        L._keep_n_strongest_modes = keep_n_strongest_modes
-        L._angle = angle
-        L._propagate = True
-        
-        _N_LaserOffset += 1
-
-except:
+    L._offset = offset
+    L._extra_envelope = extra_envelope
+    L._profiles = space_time_profile
+    L._keep_n_strongest_modes = keep_n_strongest_modes
+    L._angle = angle
+    L._propagate = True
     
-    def LaserOffset(box_side="xmin", space_time_profile=[], offset=0., time_envelope=1.):
-        L = Laser(
-            box_side = "xmin",
-            file = "none",
-            time_envelope = time_envelope
-        )
-        print("WARNING: LaserOffset unavailable because numpy was not found")
+    _N_LaserOffset += 1
+
+
+
+# Translation of user-defined profiles into a program evaluated natively by Smilei
+# --------------------------------------------------------------------------------
+# The profile is called with symbolic arguments that record all the operations.
+# Each `if` on a symbolic value is explored on both sides and becomes a `select`.
+# The result is a list of operations in postfix order, or None if the profile
+# uses something that cannot be translated (it is then evaluated by python).
+
+class _ProfileTracerError(Exception):
+    pass
+
+class _ProfileTracer(object):
+    """Symbolic value recording the operations applied to the arguments of a profile"""
+    _branches = None
+    __hash__ = None
+    def __init__(self, node):
+        self.node = node
+    @staticmethod
+    def make(op, *args):
+        return _ProfileTracer( (op,) + tuple(_ProfileTracer.toNode(a) for a in args) )
+    @staticmethod
+    def toNode(a):
+        if isinstance(a, _ProfileTracer):
+            return a.node
+        if isinstance(a, complex):
+            raise _ProfileTracerError("complex values are not supported")
+        try:
+            return ("const", float(a))
+        except _ProfileTracerError:
+            raise
+        except Exception:
+            raise _ProfileTracerError("unsupported value "+repr(a))
+    # Arithmetic
+    def __add__(self, o): return _ProfileTracer.make("add", self, o)
+    def __radd__(self, o): return _ProfileTracer.make("add", o, self)
+    def __sub__(self, o): return _ProfileTracer.make("sub", self, o)
+    def __rsub__(self, o): return _ProfileTracer.make("sub", o, self)
+    def __mul__(self, o): return _ProfileTracer.make("mul", self, o)
+    def __rmul__(self, o): return _ProfileTracer.make("mul", o, self)
+    def __truediv__(self, o): return _ProfileTracer.make("div", self, o)
+    def __rtruediv__(self, o): return _ProfileTracer.make("div", o, self)
+    __div__ = __truediv__
+    __rdiv__ = __rtruediv__
+    def __pow__(self, o): return _ProfileTracer.make("pow", self, o)
+    def __rpow__(self, o): return _ProfileTracer.make("pow", o, self)
+    def __neg__(self): return _ProfileTracer.make("neg", self)
+    def __pos__(self): return self
+    def __abs__(self): return _ProfileTracer.make("abs", self)
+    # Comparisons and logical operators (numpy style)
+    def __lt__(self, o): return _ProfileTracer.make("lt", self, o)
+    def __le__(self, o): return _ProfileTracer.make("le", self, o)
+    def __gt__(self, o): return _ProfileTracer.make("gt", self, o)
+    def __ge__(self, o): return _ProfileTracer.make("ge", self, o)
+    def __eq__(self, o): return _ProfileTracer.make("eq", self, o)
+    def __ne__(self, o): return _ProfileTracer.make("ne", self, o)
+    def __and__(self, o): return _ProfileTracer.make("and", self, o)
+    def __rand__(self, o): return _ProfileTracer.make("and", o, self)
+    def __or__(self, o): return _ProfileTracer.make("or", self, o)
+    def __ror__(self, o): return _ProfileTracer.make("or", o, self)
+    def __invert__(self): return _ProfileTracer.make("not", self)
+    # Branches: the decision is imposed by the current exploration
+    def __bool__(self):
+        b = _ProfileTracer._branches
+        if b is None:
+            raise _ProfileTracerError("branch outside of a trace")
+        return b.decide(self.node)
+    __nonzero__ = __bool__
+    def __float__(self): raise _ProfileTracerError("conversion to float")
+    def __int__(self): raise _ProfileTracerError("conversion to int")
+    def __index__(self): raise _ProfileTracerError("conversion to int")
+    # Methods called by numpy ufuncs on objects
+    def exp(self): return _ProfileTracer.make("exp", self)
+    def log(self): return _ProfileTracer.make("log", self)
+    def log10(self): return _ProfileTracer.make("log10", self)
+    def sqrt(self): return _ProfileTracer.make("sqrt", self)
+    def sin(self): return _ProfileTracer.make("sin", self)
+    def cos(self): return _ProfileTracer.make("cos", self)
+    def tan(self): return _ProfileTracer.make("tan", self)
+    def sinh(self): return _ProfileTracer.make("sinh", self)
+    def cosh(self): return _ProfileTracer.make("cosh", self)
+    def tanh(self): return _ProfileTracer.make("tanh", self)
+    def arcsin(self): return _ProfileTracer.make("arcsin", self)
+    def arccos(self): return _ProfileTracer.make("arccos", self)
+    def arctan(self): return _ProfileTracer.make("arctan", self)
+    def arctan2(self, o): return _ProfileTracer.make("arctan2", self, o)
+    def floor(self): return _ProfileTracer.make("floor", self)
+    def ceil(self): return _ProfileTracer.make("ceil", self)
+
+class _ProfileBranches(object):
+    """Depth-first exploration of the branches taken by a profile"""
+    def __init__(self, forced):
+        self.forced = forced
+        self.decisions = []
+        self.conditions = []
+    def decide(self, condition):
+        i = len(self.decisions)
+        if i >= 16:
+            raise _ProfileTracerError("too many branches")
+        d = self.forced[i] if i < len(self.forced) else True
+        self.decisions.append(d)
+        self.conditions.append(condition)
+        return d
+
+# Functions of the math module which can be traced
+_profile_math_functions = {
+    "exp":"exp", "log":"log", "log10":"log10", "sqrt":"sqrt", "sin":"sin", "cos":"cos", "tan":"tan",
+    "sinh":"sinh", "cosh":"cosh", "tanh":"tanh", "asin":"arcsin", "acos":"arccos", "atan":"arctan",
+    "atan2":"arctan2", "floor":"floor", "ceil":"ceil", "fabs":"abs", "pow":"pow",
+}
+
+def _profile_math_wrapper(name, original):
+    def f(*args):
+        if any(isinstance(a, _ProfileTracer) for a in args):
+            return _ProfileTracer.make(name, *args)
+        return original(*args)
+    return f
+
+def _patch_profile_namespace(f, wrappers, patches, seen):
+    # Replace the math functions found in the globals and closures of f (and of the functions it uses)
+    if id(f) in seen or not hasattr(f, "__code__"):
+        return
+    seen.add(id(f))
+    g = f.__globals__
+    for k, v in list(g.items()):
+        if id(v) in wrappers:
+            patches.append((g.__setitem__, k, v))
+            g[k] = wrappers[id(v)]
+        elif callable(v) and hasattr(v, "__code__") and v.__code__.co_name in f.__code__.co_names:
+            _patch_profile_namespace(v, wrappers, patches, seen)
+    for cell in (f.__closure__ or ()):
+        try:
+            v = cell.cell_contents
+        except ValueError:
+            continue
+        if id(v) in wrappers:
+            try:
+                patches.append((setattr, cell, "cell_contents", v))
+                cell.cell_contents = wrappers[id(v)]
+            except Exception:
+                patches.pop()
+        elif callable(v):
+            _patch_profile_namespace(v, wrappers, patches, seen)
+
+def _trace_profile(f, nvariables, call=None):
+    # `call(args)` calls f with the symbolic variables (by default f(*args))
+    # Temporarily replace the math functions by wrappers accepting symbolic values
+    # (every replacement is recorded before it is made, and they are all undone in `finally`)
+    wrappers, patches = {}, []
+    try:
+        for name, op in _profile_math_functions.items():
+            original = getattr(math, name)
+            wrappers[id(original)] = _profile_math_wrapper(op, original)
+            patches.append((setattr, math, name, original))
+            setattr(math, name, wrappers[id(original)])
+        _patch_profile_namespace(f, wrappers, patches, set())
+        # Explore all branches
+        args = [_ProfileTracer(("var", float(i))) for i in range(nvariables)]
+        paths, forced = [], []
+        while True:
+            _ProfileTracer._branches = _ProfileBranches(forced)
+            result = call(args) if call else f(*args)
+            if type(result).__name__ == "ndarray" and result.shape == ():
+                result = result.item()
+            b = _ProfileTracer._branches
+            paths.append((b.decisions, b.conditions, _ProfileTracer.toNode(result)))
+            if len(paths) > 64:
+                raise _ProfileTracerError("too many branches")
+            # Next path: flip the last True decision
+            d = list(b.decisions)
+            while d and not d[-1]:
+                d.pop()
+            if not d:
+                break
+            forced = d[:-1] + [False]
+    finally:
+        _ProfileTracer._branches = None
+        for p in reversed(patches):
+            p[0](*p[1:])
+    # Assemble the paths into a tree of selections
+    def assemble(paths, depth):
+        if len(paths) == 1 and len(paths[0][0]) == depth:
+            return paths[0][2]
+        condition = paths[0][1][depth]
+        yes = [p for p in paths if p[0][depth]]
+        no  = [p for p in paths if not p[0][depth]]
+        return ("select", condition, assemble(yes, depth+1), assemble(no, depth+1))
+    return assemble(paths, 0)
+
+def _evaluate_profile_node(node, x):
+    # Reference evaluation of a traced node (used to verify the translation)
+    op = node[0]
+    if op == "var": return x[int(node[1])]
+    if op == "const": return node[1]
+    a = [_evaluate_profile_node(n, x) for n in node[1:]]
+    if op == "select": return a[1] if a[0] else a[2]
+    if op == "add": return a[0] + a[1]
+    if op == "sub": return a[0] - a[1]
+    if op == "mul": return a[0] * a[1]
+    if op == "div": return a[0] / a[1]
+    if op == "pow": return a[0] ** a[1]
+    if op == "neg": return -a[0]
+    if op == "abs": return abs(a[0])
+    if op == "lt": return float(a[0] < a[1])
+    if op == "le": return float(a[0] <= a[1])
+    if op == "gt": return float(a[0] > a[1])
+    if op == "ge": return float(a[0] >= a[1])
+    if op == "eq": return float(a[0] == a[1])
+    if op == "ne": return float(a[0] != a[1])
+    if op == "and": return float(bool(a[0]) and bool(a[1]))
+    if op == "or": return float(bool(a[0]) or bool(a[1]))
+    if op == "not": return float(not a[0])
+    if op == "arctan2": return math.atan2(a[0], a[1])
+    names = {"arcsin":"asin", "arccos":"acos", "arctan":"atan"}
+    return getattr(math, names.get(op, op))(a[0])
+
+def _profile_samples(extents, npoints=64):
+    # Points spread over the extents [(min, max), ...] of the variables (Halton sequence),
+    # after a few special values. Variables with a third element True take integer values.
+    primes = [2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53]
+    special = [0., 1e-3, 0.37, 1.9, -3.2]
+    def halton(i, b):
+        r, f = 0., 1.
+        while i > 0:
+            f /= b
+            r += f * (i % b)
+            i //= b
+        return r
+    points = []
+    for ipoint in range(len(special)):
+        points.append([special[(ipoint+ivar) % len(special)] for ivar in range(len(extents))])
+    for ipoint in range(1, npoints+1):
+        x = []
+        for ivar, e in enumerate(extents):
+            v = e[0] + (e[1]-e[0]) * halton(ipoint, primes[ivar % len(primes)])
+            x.append(float(round(v)) if len(e) > 2 and e[2] else v)
+        points.append(x)
+    return points
+
+def _profile_extents(nvariables):
+    # The variables of a profile are coordinates or the time: they are sampled slightly
+    # beyond the largest of the box lengths and of the simulation time
+    lengths = [float(l) for l in (getattr(Main, "grid_length", None) or [])]
+    if getattr(Main, "simulation_time", None):
+        lengths.append(float(Main.simulation_time))
+    L = max(lengths) if lengths else 1.
+    return [(-0.1*L, 1.1*L)] * nvariables
+
+def _verify_profile_tree(f, nvariables, tree, call=None, extents=None):
+    # Compares the translation to the python function on points spread over the extents of the variables
+    # Returns False if any point differs, or if the function could not be evaluated at any point
+    if extents is None:
+        extents = _profile_extents(nvariables)
+    nmatches = 0
+    for x in _profile_samples(extents):
+        try:
+            reference = float(call(x) if call else f(*x))
+        except Exception:
+            continue
+        try:
+            value = _evaluate_profile_node(tree, x)
+        except Exception:
+            return False
+        if not (value == reference or abs(value-reference) <= 1e-10*abs(reference) or (value!=value and reference!=reference)):
+            return False
+        nmatches += 1
+    return nmatches > 0
+
+def _profile_program(tree):
+    # Postfix program
+    operations, values = [], []
+    def emit(node):
+        for n in node[1:] if node[0] not in ["var", "const"] else []:
+            emit(n)
+        operations.append(node[0])
+        values.append(node[1] if node[0] in ["var", "const"] else 0.)
+    emit(tree)
+    return operations, values
+
+def _compile_profile(f, nvariables):
+    """Returns the program (operations, values) of a profile, or None"""
+    if not Main.compile_profiles:
+        return None
+    try:
+        tree = _trace_profile(f, nvariables)
+    except Exception:
+        return None
+    if not _verify_profile_tree(f, nvariables, tree):
+        return None
+    return _profile_program(tree)
+
+
+# Translation of the DiagTrackParticles filters
+# ---------------------------------------------
+# A filter is either a python function of the particles (see ParticleData), or a string
+# expression of the particle attributes, such as "(px > 5) and (weight > 1e-3)".
+# It is traced like a profile, with the attributes as variables (in the order given
+# by _filter_variables), and the iteration number as the last variable.
+
+def _filter_variables(nDim):
+    return ["x", "y", "z"][:nDim] + ["px", "py", "pz", "weight", "charge", "id", "chi"]
+
+class _FilterParticles(object):
+    """Particles whose attributes are single values (numbers or symbolic values)"""
+    def __init__(self, names, values):
+        for name, value in zip(names, values):
+            setattr(self, name, value)
+
+def _filter_function(expression):
+    # Function of the particles evaluating the expression, with the attributes and the iteration as variables
+    namespace = {"__builtins__": {}, "abs": abs, "True": True, "False": False}
+    for name, op in _profile_math_functions.items():
+        namespace[name] = _profile_math_wrapper(op, getattr(math, name))
+    code = compile(expression, "<DiagTrackParticles filter>", "eval")
+    def f(particles):
+        variables = dict(vars(particles))
+        variables["iteration"] = Main.iteration
+        return eval(code, namespace, variables)
+    return f
+
+def _verify_filter_arrays(f, names, tree, extents):
+    # Python filters receive arrays of particles: the translation, evaluated particle by particle,
+    # must select the same particles (this excludes reductions such as numpy.mean or sorting)
+    try:
+        import numpy as np
+    except ImportError:
+        return True
+    points = _profile_samples(extents)
+    iteration = points[-1][-1]
+    for x in points:
+        x[-1] = iteration
+    Main.iteration = iteration
+    try:
+        arrays = [np.array([x[i] for x in points]) for i in range(len(names))]
+        selected = np.asarray(f(_FilterParticles(names, arrays)), dtype=bool)
+        if selected.shape != (len(points),):
+            return False
+        return all( bool(_evaluate_profile_node(tree, x)) == s for x, s in zip(points, selected) )
+    except Exception:
+        return False
 
+def _compile_filter(filter, nDim):
+    """Returns the program (operations, values) of a DiagTrackParticles filter, or None"""
+    names = _filter_variables(nDim)
+    try:
+        f = _filter_function(filter) if isinstance(filter, str) else filter
+    except Exception:
+        return None
+    iteration = getattr(Main, "iteration", 0)
+    def call(x):
+        Main.iteration = x[-1]
+        return f(_FilterParticles(names, x[:-1]))
+    # Sampled attributes: positions in the box, momenta, weight, integer charge and id, chi, iteration
+    box = _profile_extents(1)[0]
+    extents = [box]*nDim + [(-100., 100.)]*3 + [(0., 1.), (-10., 10., True), (0., 1e6, True), (0., 10.)]
+    niterations = float(Main.simulation_time)/float(Main.timestep) if getattr(Main, "timestep", None) else 1e4
+    extents += [(0., niterations, True)]
+    try:
+        tree = _trace_profile(f, len(names)+1, call)
+        if not _verify_profile_tree(f, len(names)+1, tree, call, extents):
+            return None
+        if not isinstance(filter, str) and not _verify_filter_arrays(f, names, tree, extents):
+            return None
+    except Exception:
+        return None
+    finally:
+        Main.iteration = iteration
+    return _profile_program(tree)
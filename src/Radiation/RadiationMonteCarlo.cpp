@@ -126,10 +126,106 @@ void RadiationMonteCarlo::operator()(
     // Optical depth for the Monte-Carlo process
     double* chi = &( particles.chi(0));
 
+    // Threshold on the quantum parameter for each emission regime
+    const double minimum_chi_discontinuous = RadiationTables.getMinimumChiDiscontinuous();
+    const double minimum_chi_continuous    = RadiationTables.getMinimumChiContinuous();
+
+    // Energy radiated by the continuous emission
+    double cont_radiated_energy = 0;
+
     // _______________________________________________________________
     // Computation
 
+    emission_index_.resize( 0 );
+    emission_px_.resize( 0 );
+    emission_py_.resize( 0 );
+    emission_pz_.resize( 0 );
+    emission_chi_.resize( 0 );
+
+    // 1. Classification of the particles (vectorized)
+    //    - no emission: particle at rest or particle_chi below the continuous threshold
+    //    - continuous emission: applied directly during the whole time step
+    //    - discontinuous emission: particle_chi above the discontinuous threshold
+    //      or emission in progress, treated in the Monte-Carlo loop below
+
+    discontinuous_flag_.resize( iend-istart );
+    int *discontinuous_flag = &discontinuous_flag_[0];
+    classified_gamma_.resize( iend-istart );
+    classified_chi_.resize( iend-istart );
+    double *classified_gamma = &classified_gamma_[0];
+    double *classified_chi = &classified_chi_[0];
+
+    #pragma omp simd reduction(+:cont_radiated_energy)
     for( int ipart=istart ; ipart<iend; ipart++ ) {
+        double charge_over_mass_square = ( double )( charge[ipart] )*one_over_mass_square;
+
+        // Gamma
+        double gamma = sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
+                             + momentum[1][ipart]*momentum[1][ipart]
+                             + momentum[2][ipart]*momentum[2][ipart] );
+
+        // Computation of the Lorentz invariant quantum parameter
+        double particle_chi = Radiation::computeParticleChi( charge_over_mass_square,
+                              momentum[0][ipart], momentum[1][ipart], momentum[2][ipart],
+                              gamma,
+                              ( *( Ex+ipart-ipart_ref ) ), ( *( Ey+ipart-ipart_ref ) ), ( *( Ez+ipart-ipart_ref ) ),
+                              ( *( Bx+ipart-ipart_ref ) ), ( *( By+ipart-ipart_ref ) ), ( *( Bz+ipart-ipart_ref ) ) );
+
+        bool moving = ( gamma > 1. );
+        bool discontinuous = moving
+                             && ( ( particle_chi > minimum_chi_discontinuous ) || ( tau[ipart] > epsilon_tau_ ) );
+        bool continuous    = moving && !discontinuous
+                             && ( particle_chi > minimum_chi_continuous );
+
+        discontinuous_flag[ipart-istart] = discontinuous;
+        classified_gamma[ipart-istart] = gamma;
+        classified_chi[ipart-istart] = particle_chi;
+
+        // Continuous emission during the whole time step
+        double cont_rad_energy = continuous ?
+                                 RadiationTables.getRidgersCorrectedRadiatedEnergy( particle_chi, dt_ ) : 0.;
+
+        // Effect on the momentum
+        double temp = cont_rad_energy*gamma/( gamma*gamma-1. );
+        temp = continuous ? temp : 0.;
+        for( int i = 0 ; i<3 ; i++ ) {
+            momentum[i][ipart] -= temp*momentum[i][ipart];
+        }
+
+        // Incrementation of the radiated energy cumulative parameter
+        double new_gamma = sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
+                                 + momentum[1][ipart]*momentum[1][ipart]
+                                 + momentum[2][ipart]*momentum[2][ipart] );
+        cont_radiated_energy += continuous ? weight[ipart]*( gamma - new_gamma ) : 0.;
+    }
+
+    radiated_energy += cont_radiated_energy;
+
+    // 2. Compaction of the particles with discontinuous emission
+    //    (their momentum was not modified above: gamma and chi are kept for the first sub-step)
+    discontinuous_index_.resize( 0 );
+    discontinuous_gamma_.resize( 0 );
+    discontinuous_chi_.resize( 0 );
+    for( int ipart=istart ; ipart<iend; ipart++ ) {
+        if( discontinuous_flag[ipart-istart] ) {
+            discontinuous_index_.push_back( ipart );
+            discontinuous_gamma_.push_back( classified_gamma[ipart-istart] );
+            discontinuous_chi_.push_back( classified_chi[ipart-istart] );
+        }
+    }
+    
+    // 3. First sub-step of all the compacted particles in lockstep: photon production yield
+    //    (it does not depend on the optical depth, nor on the random numbers)
+    unsigned int ndiscontinuous = discontinuous_index_.size();
+    discontinuous_yield_.resize( ndiscontinuous );
+    for( unsigned int idisc=0 ; idisc<ndiscontinuous; idisc++ ) {
+        discontinuous_yield_[idisc] = RadiationTables.computePhotonProductionYield( discontinuous_chi_[idisc], discontinuous_gamma_[idisc] );
+    }
+
+    // 4. Monte-Carlo loop on the compacted list (not vectorized)
+    //    The random numbers are drawn in the same order as in the particle loop
+    for( unsigned int idisc=0 ; idisc<ndiscontinuous; idisc++ ) {
+        int ipart = discontinuous_index_[idisc];
         charge_over_mass_square = ( double )( charge[ipart] )*one_over_mass_square;
 
         // Init local variables
@@ -141,8 +237,12 @@ void RadiationMonteCarlo::operator()(
         while( ( local_it_time < dt_ )
                 &&( mc_it_nb < max_monte_carlo_iterations_ ) ) {
 
+            // The first sub-step uses the values computed in lockstep
+            bool first_substep = ( mc_it_nb == 0 );
+            
             // Gamma
-            gamma = sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
+            gamma = first_substep ? discontinuous_gamma_[idisc] :
+                    sqrt( 1.0 + momentum[0][ipart]*momentum[0][ipart]
                           + momentum[1][ipart]*momentum[1][ipart]
                           + momentum[2][ipart]*momentum[2][ipart] );
 
@@ -151,7 +251,8 @@ void RadiationMonteCarlo::operator()(
             }
 
             // Computation of the Lorentz invariant quantum parameter
-            particle_chi = Radiation::computeParticleChi( charge_over_mass_square,
+            particle_chi = first_substep ? discontinuous_chi_[idisc] :
+                           Radiation::computeParticleChi( charge_over_mass_square,
                            momentum[0][ipart], momentum[1][ipart], momentum[2][ipart],
                            gamma,
                            ( *( Ex+ipart-ipart_ref ) ), ( *( Ey+ipart-ipart_ref ) ), ( *( Ez+ipart-ipart_ref ) ),
@@ -179,7 +280,8 @@ void RadiationMonteCarlo::operator()(
             if( tau[ipart] > epsilon_tau_ ) {
 
                 // from the cross section
-                temp = RadiationTables.computePhotonProductionYield( particle_chi, gamma );
+                temp = first_substep ? discontinuous_yield_[idisc] :
+                       RadiationTables.computePhotonProductionYield( particle_chi, gamma );
 
                 // Time to discontinuous emission
                 // If this time is > the remaining iteration time,
@@ -257,6 +359,11 @@ void RadiationMonteCarlo::operator()(
 
     }
     
+    // ____________________________________________________
+    // Creation of the recorded macro-photons
+    
+    createPhotons( position, weight );
+    
     // ____________________________________________________
     // Update of the quantum parameter chi
     
@@ -367,41 +474,18 @@ double RadiationMonteCarlo::photonEmission( int ipart,
 
         // Second method: emission of several photons for statistics following
         // the parameter radiation_photon_sampling_
-
-        // Creation of new photons in the temporary array new_photons_
-        new_photons_.createParticles( radiation_photon_sampling_ );
-
-        // Final size
-        int npart = new_photons_.size();
+        // The photons are only recorded here, and created after the Monte-Carlo loop
 
         // Inverse of the momentum norm
         inv_old_norm_p = 1./sqrt( momentum[0][ipart]*momentum[0][ipart]
                                   + momentum[1][ipart]*momentum[1][ipart]
                                   + momentum[2][ipart]*momentum[2][ipart] );
 
-        // For all new photons...
-        for( int idNew=npart-radiation_photon_sampling_; idNew<npart; idNew++ ) {
-            for( int i=0; i<n_dimensions_; i++ ) {
-                new_photons_.position( i, idNew )=position[i][ipart];
-            }
-
-            for( int i=0; i<3; i++ ) {
-                new_photons_.momentum( i, idNew ) =
-                    gammaph*momentum[i][ipart]*inv_old_norm_p;
-            }
-
-            new_photons_.weight( idNew )=weight[ipart]*inv_radiation_photon_sampling_;
-            new_photons_.charge( idNew )=0;
-
-            if( new_photons_.isQuantumParameter ) {
-                new_photons_.chi( idNew ) = photon_chi;
-            }
-
-            if( new_photons_.isMonteCarlo ) {
-                new_photons_.tau( idNew ) = -1.;
-            }
-
-        }
+        emission_index_.push_back( ipart );
+        emission_px_.push_back( gammaph*momentum[0][ipart]*inv_old_norm_p );
+        emission_py_.push_back( gammaph*momentum[1][ipart]*inv_old_norm_p );
+        emission_pz_.push_back( gammaph*momentum[2][ipart]*inv_old_norm_p );
+        emission_chi_.push_back( photon_chi );
 
     }
     // Addition of the emitted energy in the cumulating parameter
@@ -415,3 +499,57 @@ double RadiationMonteCarlo::photonEmission( int ipart,
     
     return radiated_energy;
 }
+
+// ---------------------------------------------------------------------------------------------------------------------
+//! Create all the macro-photons recorded during the Monte-Carlo loop
+//! Each emission event produces radiation_photon_sampling_ photons:
+//! they are reserved at once in new_photons_ and filled at their offsets
+//! \param position           particle position
+//! \param weight             particle weight
+// ---------------------------------------------------------------------------------------------------------------------
+void RadiationMonteCarlo::createPhotons( double *position[3], double *weight )
+{
+    unsigned int nevents = emission_index_.size();
+    
+    // Reserve all photons
+    std::vector<unsigned int> first_new( nevents, radiation_photon_sampling_ );
+    if( new_photons_.prepareEmission( first_new ) == 0 ) {
+        return;
+    }
+    
+    // Fill each property for all events
+    for( int i=0; i<n_dimensions_; i++ ) {
+        double *new_position = &( new_photons_.position( i, 0 ) );
+        for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+            for( int isample=0; isample<radiation_photon_sampling_; isample++ ) {
+                new_position[first_new[ievent]+isample] = position[i][emission_index_[ievent]];
+            }
+        }
+    }
+    
+    double *emission_p[3] = { &emission_px_[0], &emission_py_[0], &emission_pz_[0] };
+    for( int i=0; i<3; i++ ) {
+        double *new_momentum = &( new_photons_.momentum( i, 0 ) );
+        for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+            for( int isample=0; isample<radiation_photon_sampling_; isample++ ) {
+                new_momentum[first_new[ievent]+isample] = emission_p[i][ievent];
+            }
+        }
+    }
+    
+    for( unsigned int ievent=0; ievent<nevents; ievent++ ) {
+        for( int isample=0; isample<radiation_photon_sampling_; isample++ ) {
+            int idNew = first_new[ievent]+isample;
+            new_photons_.weight( idNew ) = weight[emission_index_[ievent]]*inv_radiation_photon_sampling_;
+            new_photons_.charge( idNew ) = 0;
+            
+            if( new_photons_.isQuantumParameter ) {
+                new_photons_.chi( idNew ) = emission_chi_[ievent];
+            }
+            
+            if( new_photons_.isMonteCarlo ) {
+                new_photons_.tau( idNew ) = -1.;
+            }
+        }
+    }
+}
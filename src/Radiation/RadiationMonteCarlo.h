@@ -58,7 +58,7 @@ public:
        );
         
     // ---------------------------------------------------------------------
-    //! Perform the phoon emission (creation of a super-photon
+    //! Perform the phoon emission (record of a super-photon
     //! and slow down of the emitting particle)
     //! \param ipart              particle index
     //! \param particle_chi          particle quantum parameter
@@ -77,6 +77,14 @@ public:
                          Species *photon_species,
                          RadiationTables &RadiationTables );
                          
+    // ---------------------------------------------------------------------
+    //! Create all the macro-photons recorded during the call to the operator,
+    //! reserving them at once in new_photons_
+    //! \param position           particle position
+    //! \param weight             particle weight
+    // ---------------------------------------------------------------------
+    void createPhotons( double *position[3], double *weight );
+    
 protected:
 
     // ________________________________________
@@ -99,6 +107,21 @@ protected:
     //! Espilon to check when tau is near 0
     const double epsilon_tau_ = 1e-100;
     
+    //! Emission events recorded during the Monte-Carlo loop:
+    //! index of the emitting particle, photon momentum and quantum parameter
+    std::vector<int> emission_index_;
+    std::vector<double> emission_px_, emission_py_, emission_pz_, emission_chi_;
+    
+    //! Flag of the particles treated by the discontinuous Monte-Carlo loop
+    std::vector<int> discontinuous_flag_;
+    //! Compacted indices of the particles treated by the Monte-Carlo loop
+    std::vector<int> discontinuous_index_;
+    //! Lorentz factor and quantum parameter of all the particles, computed by the classification
+    std::vector<double> classified_gamma_, classified_chi_;
+    //! Lorentz factor, quantum parameter and photon production yield of the compacted particles
+    //! at their first sub-step
+    std::vector<double> discontinuous_gamma_, discontinuous_chi_, discontinuous_yield_;
+    
 private:
 
 };
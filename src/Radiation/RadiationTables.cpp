@@ -25,6 +25,8 @@ RadiationTables::RadiationTables()
     minimum_chi_continuous_ = 1e-3;
     minimum_chi_discontinuous_ = 1e-2;
     
+    xi_.inverse_size_ = 0;
+    
     // Default init of the tables
     setDefault();
 
@@ -100,6 +102,13 @@ void RadiationTables::initialization( Params &params , SmileiMPI *smpi )
             // Discontinuous minimum threshold
             PyTools::extract( "minimum_chi_discontinuous",
                               minimum_chi_discontinuous_, "RadiationReaction" );
+
+            // Size of the inverse cumulative distribution tables
+            PyTools::extract( "inverse_cdf_size",
+                              xi_.inverse_size_, "RadiationReaction" );
+            if( xi_.inverse_size_ == 1 || xi_.inverse_size_ < 0 ) {
+                ERROR( "The parameter `inverse_cdf_size` must be 0 or greater than 1" );
+            }
         }
 
         // With any radiation model whatever the table computation
@@ -187,6 +196,28 @@ void RadiationTables::initialization( Params &params , SmileiMPI *smpi )
         MESSAGE( 2,"Dimension photon chi: " << xi_.size_photon_chi_ );
         MESSAGE( 2,"Minimum particle chi: " << xi_.min_particle_chi_ );
         MESSAGE( 2,"Maximum particle chi: " << xi_.max_particle_chi_ );
+        
+        if( xi_.inverse_size_ > 0 ) {
+            computeInverseXiTable();
+            MESSAGE( "" );
+            MESSAGE( 1,"--- Inverse table of `xi` for the photon sampling:" );
+            MESSAGE( 2,"Dimension of each segment: " << xi_.inverse_size_ );
+        }
+    }
+    
+    // Table of the synchrotron spectrum, if requested by one DiagRadiationSpectrum
+    bool tabulated_spectrum = false;
+    for( unsigned int idiag=0; idiag<PyTools::nComponents( "DiagRadiationSpectrum" ); idiag++ ) {
+        bool tabulated = false;
+        PyTools::extract( "tabulated_spectrum", tabulated, "DiagRadiationSpectrum", idiag );
+        tabulated_spectrum = tabulated_spectrum || tabulated;
+    }
+    if( tabulated_spectrum ) {
+        computeSynchrotronSpectrumTable();
+        MESSAGE( "" );
+        MESSAGE( 1, "--- Synchrotron spectrum table for DiagRadiationSpectrum:" );
+        MESSAGE( 2, "Dimension quantum parameter: " << spectrum_.size_particle_chi_ );
+        MESSAGE( 2, "Dimension photon energy: " << spectrum_.size_y_ );
     }
     
     if( params.hasNielRadiation ) {
@@ -373,6 +404,15 @@ double RadiationTables::computeRandomPhotonChiWithInterpolation( double particle
 
     xi = rand->uniform();
 
+    // Constant-time lookup in the inverse cumulative distribution
+    if( xi_.inverse_size_ > 0 ) {
+        d_particle_chi = ( log10_particle_chi - ( ichipa*xi_.particle_chi_delta_+xi_.log10_min_particle_chi_ ) )
+                         * xi_.inv_particle_chi_delta_;
+        photon_chi_1 = getLog10PhotonChiFromInverseCDF( ichipa, xi );
+        photon_chi_2 = getLog10PhotonChiFromInverseCDF( ichipa+1, xi );
+        return std::pow( 10.0, photon_chi_1*( 1 - d_particle_chi ) + photon_chi_2*d_particle_chi );
+    }
+
     // If the randomly computed xi if below the first one of the row,
     // we take the first one which corresponds to the minimal photon photon_chi
     if( xi <= xi_.table_[ichipa*xi_.size_photon_chi_] ) {
@@ -568,6 +608,101 @@ double RadiationTables::getHNielFromTable( double particle_chi )
 //     return sqrt( factor_classical_radiated_power_*gamma*h )*r;
 // }
 
+// -----------------------------------------------------------------------------
+// INVERSE CUMULATIVE DISTRIBUTION
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+//! Compute the inverse of the cumulative distribution xi for each particle_chi
+//! row. The inverse is evaluated exactly as in
+//! computeRandomPhotonChiWithInterpolation (search and linear interpolation)
+//! on two grids: uniform in xi on [0, 0.5], and uniform in log10(1-xi)
+//! on [log10(0.5), -16] to resolve the high-energy tail.
+// -----------------------------------------------------------------------------
+void RadiationTables::computeInverseXiTable()
+{
+    int size = xi_.inverse_size_;
+    double log10_min_tail = -16.;
+    
+    xi_.log10_half_ = std::log10( 0.5 );
+    xi_.inverse_low_factor_  = 2.*( size-1 );
+    xi_.inverse_high_factor_ = ( size-1 )/( log10_min_tail - xi_.log10_half_ );
+    xi_.inverse_table_.resize( xi_.size_particle_chi_*2*size );
+    
+    for( int ichipa=0 ; ichipa<xi_.size_particle_chi_ ; ichipa++ ) {
+    
+        double *table = &xi_.table_[ichipa*xi_.size_photon_chi_];
+        double *inverse = &xi_.inverse_table_[ichipa*2*size];
+        
+        // Chi gap for the corresponding particle_chi
+        double chiph_xip_delta = ( ichipa*xi_.particle_chi_delta_+xi_.log10_min_particle_chi_
+                                   - xi_.min_photon_chi_table_[ichipa] )
+                                 *xi_.inv_size_photon_chi_minus_one_;
+                                 
+        for( int i=0 ; i<2*size ; i++ ) {
+            double xi = ( i<size ) ?
+                        0.5*i/( size-1. ) :
+                        1. - std::pow( 10., xi_.log10_half_ + ( i-size )/xi_.inverse_high_factor_ );
+                        
+            int ichiph;
+            if( xi <= table[0] ) {
+                ichiph = 0;
+                xi = table[0];
+            } else {
+                ichiph = userFunctions::searchValuesInMonotonicArray( table, xi, xi_.size_photon_chi_ );
+            }
+            
+            // Linear interpolation in the logarithmic scale
+            // (no interpolation when two consecutive values of the table are equal)
+            double d_photon_chi = 0.;
+            if( ( table[ichiph] < 1.0 ) && ( table[ichiph+1] - table[ichiph] > 1e-15 ) ) {
+                d_photon_chi = ( xi - table[ichiph] ) / ( table[ichiph+1] - table[ichiph] );
+            }
+            inverse[i] = ( ichiph + d_photon_chi )*chiph_xip_delta + xi_.min_photon_chi_table_[ichipa];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+//! Tabulate the log of the normalized synchrotron spectrum
+//! xi*( F1(nu) + xi*zeta*F2(nu) ), where xi is the ratio of the photon energy
+//! to the particle energy, zeta = xi/(1-xi) and nu = 2*zeta/(3*particle_chi).
+//! Along a row, the variable y = log10( zeta/particle_chi ) = log10( 3*nu/2 )
+//! resolves both the low-energy power law and the exponential cut-off
+//! whatever particle_chi. particle_chi goes from minimum_chi_continuous_
+//! to 1e3 (larger values are not tabulated).
+// -----------------------------------------------------------------------------
+void RadiationTables::computeSynchrotronSpectrumTable()
+{
+    double log10_max_particle_chi = std::max( 3., std::log10( minimum_chi_continuous_ ) + 1. );
+    
+    spectrum_.size_particle_chi_ = 128;
+    spectrum_.log10_min_particle_chi_ = std::log10( minimum_chi_continuous_ );
+    double particle_chi_delta = ( log10_max_particle_chi - spectrum_.log10_min_particle_chi_ )
+                                / ( spectrum_.size_particle_chi_-1 );
+    spectrum_.inv_particle_chi_delta_ = 1./particle_chi_delta;
+    
+    // From nu ~ 7e-7 (power law) to nu ~ 670 (exp(-nu) negligible)
+    spectrum_.size_y_ = 1024;
+    spectrum_.min_y_ = -6.;
+    double y_delta = ( 3. - spectrum_.min_y_ ) / ( spectrum_.size_y_-1 );
+    spectrum_.inv_y_delta_ = 1./y_delta;
+    
+    spectrum_.table_.resize( spectrum_.size_particle_chi_*spectrum_.size_y_ );
+    
+    for( int ichipa=0 ; ichipa<spectrum_.size_particle_chi_ ; ichipa++ ) {
+        double particle_chi = std::pow( 10., spectrum_.log10_min_particle_chi_ + ichipa*particle_chi_delta );
+        double *row = &spectrum_.table_[ichipa*spectrum_.size_y_];
+        for( int iy=0 ; iy<spectrum_.size_y_ ; iy++ ) {
+            double zeta_ov_chi = std::pow( 10., spectrum_.min_y_ + iy*y_delta );
+            double zeta = particle_chi*zeta_ov_chi;
+            double xi   = zeta/( 1.+zeta );
+            double nu   = 2./3.*zeta_ov_chi;
+            row[iy] = std::log( xi*RadiationTools::computeBesselPartsRadiatedPower( nu, xi*zeta ) );
+        }
+    }
+}
+
 // -----------------------------------------------------------------------------
 // TABLE READING
 // -----------------------------------------------------------------------------
@@ -19,6 +19,7 @@
 #include <cstring>
 #include <iomanip>
 #include <cmath>
+#include <algorithm>
 #include "userFunctions.h"
 #include "Params.h"
 #include "RadiationTools.h"
@@ -66,6 +67,25 @@ public:
     //! ramdomly and using the tables xi and chiphmin
     //! \param particle_chi particle quantum parameter
     double computeRandomPhotonChiWithInterpolation( double particle_chi, Random * rand);
+
+    //! Computation of the photon quantum parameter photon_chi for emission
+    //! from a uniform random number xi using the inverse
+    //! cumulative distribution tables (constant-time lookup)
+    //! \param ichipa index of the particle_chi row in the tables
+    //! \param xi uniform random number in [0,1[
+    inline double getLog10PhotonChiFromInverseCDF( int ichipa, double xi )
+    {
+        // Two segments: uniform in xi on [0, 0.5] and uniform in log10(1-xi) on [0.5, 1[
+        double x_low  = xi*xi_.inverse_low_factor_;
+        double x_high = ( std::log10( std::max( 1.-xi, 1e-16 ) ) - xi_.log10_half_ )*xi_.inverse_high_factor_;
+        bool low = ( xi <= 0.5 );
+        double x = low ? x_low : x_high;
+        int segment = low ? 0 : xi_.inverse_size_;
+        int i = std::min( int( x ), xi_.inverse_size_-2 );
+        double w = x - i;
+        const double *row = &xi_.inverse_table_[ichipa*2*xi_.inverse_size_ + segment];
+        return row[i]*( 1.-w ) + row[i+1]*w;
+    }
     
     //! Return the value of the function h(particle_chi) of Niel et al.
     //! Use an integration of Gauss-Legendre
@@ -134,6 +154,43 @@ public:
                     + 2.44*particle_chi*particle_chi, -2.0/3.0 );
     };
 
+    //! Rows of the tabulated synchrotron spectrum surrounding particle_chi
+    //! (first of the two rows), for getSynchrotronSpectrum
+    //! Returns NULL if particle_chi is above the table
+    //! \param particle_chi particle quantum parameter
+    //! \param weight interpolation weight of the second row
+    inline const double *getSynchrotronSpectrumRows( double particle_chi, double &weight )
+    {
+        double x = ( std::log10( particle_chi ) - spectrum_.log10_min_particle_chi_ )*spectrum_.inv_particle_chi_delta_;
+        if( x > ( double )( spectrum_.size_particle_chi_-1 ) ) {
+            return NULL;
+        }
+        x = std::max( x, 0. );
+        int ichipa = std::min( int( x ), spectrum_.size_particle_chi_-2 );
+        weight = x - ichipa;
+        return &spectrum_.table_[ichipa*spectrum_.size_y_];
+    }
+    
+    //! Normalized synchrotron spectrum xi*( F1(nu) + xi*zeta*F2(nu) ) interpolated in the table
+    //! (see RadiationTools::computeBesselPartsRadiatedPower), with zeta = xi/(1-xi) and
+    //! nu = 2*zeta/(3*particle_chi). Can be called in SIMD loops.
+    //! \param rows rows returned by getSynchrotronSpectrumRows
+    //! \param weight interpolation weight returned by getSynchrotronSpectrumRows
+    //! \param log10_zeta_ov_chi log10( zeta/particle_chi )
+    inline double getSynchrotronSpectrum( const double *rows, double weight, double log10_zeta_ov_chi )
+    {
+        double y = ( log10_zeta_ov_chi - spectrum_.min_y_ )*spectrum_.inv_y_delta_;
+        double yc = std::min( y, ( double )( spectrum_.size_y_-1 ) );
+        // Below the table, the spectrum is a power law: linear extrapolation of its log
+        int iy = std::min( std::max( int( yc ), 0 ), spectrum_.size_y_-2 );
+        double wy = yc - iy;
+        const double *next = rows + spectrum_.size_y_;
+        double log_spectrum = ( rows[iy]*( 1.-wy ) + rows[iy+1]*wy )*( 1.-weight )
+                            + ( next[iy]*( 1.-wy ) + next[iy+1]*wy )*weight;
+        // Above the table, the spectrum is negligible (exp(-nu) with nu > 600)
+        return y < ( double )( spectrum_.size_y_-1 ) ? std::exp( log_spectrum ) : 0.;
+    }
+    
     inline std::string getNielHComputationMethod()
     {
         return this->niel_.computation_method_;
@@ -183,6 +240,22 @@ public:
     //! \param smpi Object of class SmileiMPI containing MPI properties
     void bcastTableXi( SmileiMPI *smpi );
 
+    // ---------------------------------------------------------------------
+    // INVERSE CUMULATIVE DISTRIBUTION
+    // ---------------------------------------------------------------------
+
+    //! Compute the inverse of the cumulative distribution xi for each
+    //! particle_chi row on the grids used by getLog10PhotonChiFromInverseCDF
+    void computeInverseXiTable();
+    
+    // ---------------------------------------------------------------------
+    // SYNCHROTRON SPECTRUM
+    // ---------------------------------------------------------------------
+    
+    //! Tabulate the log of the normalized synchrotron spectrum
+    //! used by getSynchrotronSpectrum (DiagRadiationSpectrum)
+    void computeSynchrotronSpectrumTable();
+
 private:
 
     // ---------------------------------------------
@@ -323,10 +396,54 @@ private:
         //! xip threshold
         // double threshold_;
         
+        //! Number of points of each segment of the inverse table (0: not used)
+        int inverse_size_;
+        
+        //! Inverse cumulative distribution: log10(photon_chi) for each particle_chi row,
+        //! first on a uniform grid of xi in [0, 0.5] then of log10(1-xi) in [log10(0.5), -16]
+        std::vector<double> inverse_table_;
+        
+        //! Factors to compute the index in the two segments of the inverse table
+        double inverse_low_factor_;
+        double inverse_high_factor_;
+        double log10_half_;
+        
     };
     
     struct Xi xi_;
 
+    // ---------------------------------------------
+    // Table of the synchrotron spectrum
+    // ---------------------------------------------
+    
+    struct SynchrotronSpectrum {
+        
+        //! Log of the normalized spectrum xi*( F1(nu) + xi*zeta*F2(nu) ):
+        //! one row per particle_chi, uniform in y = log10( zeta/particle_chi ) along a row
+        std::vector<double> table_;
+        
+        //! Log10 of the minimum boundary of particle_chi
+        double log10_min_particle_chi_;
+        
+        //! Inverse delta of log10( particle_chi )
+        double inv_particle_chi_delta_;
+        
+        //! Number of particle_chi rows
+        int size_particle_chi_;
+        
+        //! Minimum boundary of y
+        double min_y_;
+        
+        //! Inverse delta of y
+        double inv_y_delta_;
+        
+        //! Number of points along y
+        int size_y_;
+        
+    };
+    
+    struct SynchrotronSpectrum spectrum_;
+
     // ---------------------------------------------
     // Factors
     // ---------------------------------------------
@@ -326,6 +326,9 @@ int main( int argc, char *argv[] )
     unsigned int itime=checkpoint.this_run_start_step+1;
     while( ( itime <= params.n_time ) && ( !checkpoint.exit_asap ) ) {
 
+        // record the timeline of this iteration if requested
+        timers.timeline.prepare( itime );
+
         #pragma omp parallel shared (time_dual,smpi,params, vecPatches, region, simWindow, checkpoint, itime)
         {
 
@@ -573,6 +576,8 @@ int main( int argc, char *argv[] )
             #pragma omp barrier
         }
 
+        timers.timeline.flush( itime );
+
         itime++;
             
     }//END of the time loop
@@ -585,6 +590,7 @@ int main( int argc, char *argv[] )
     // ------------------------------------------------------------------
     TITLE( "End time loop, time dual = " << time_dual );
     timers.global.update();
+    timers.timeline.close();
 
     TITLE( "Time profiling : (print time > 0.001%)" );
     timers.profile( &smpi );
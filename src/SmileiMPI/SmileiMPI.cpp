@@ -1570,6 +1570,9 @@ void SmileiMPI::computeGlobalDiags( DiagnosticScalar *scalars, int timestep )
         return;
     }
 
+    // Combine the contributions of the threads, then reduce over MPI
+    scalars->reduceThreads();
+
     // Reduce all scalars that should be summed
     int n_sum = scalars->values_SUM.size();
     double *d_sum = &scalars->values_SUM[0];
@@ -1020,7 +1020,7 @@ void Species::countSortParticles( Params &params )
 // Move all particles from another species to this one
 void Species::importParticles( Params &params, Patch *patch, Particles &source_particles, vector<Diagnostic *> &localDiags )
 {
-    unsigned int npart = source_particles.size(), nbin=first_index.size();
+    unsigned int npart = source_particles.size();
     double inv_cell_length = 1./ params.cell_length[0];
 
     // If this species is tracked, set the particle IDs
@@ -1036,49 +1036,9 @@ void Species::importParticles( Params &params, Patch *patch, Particles &source_p
         src_bin_keys[i] /= params.clrw;
     }
 
-    vector<int> bin_count( nbin, 0 );
-    for( unsigned int ip=0; ip < npart ; ip++ )
-        bin_count[src_bin_keys[ip]] ++;
-
-    // sort new parts par bins
-    int istart = 0;
-    int istop  = bin_count[0];
-
-    for ( int ibin = 0 ; ibin < (int)nbin ; ibin++ ) {
-        if (bin_count[ibin]!=0) {
-            for( int ip=istart; ip < istop ; ip++ ) {
-                if ( src_bin_keys[ip] == ibin )
-                    continue;
-                else { // rearrange particles
-                    int ip_swap = istop;
-                    while (( src_bin_keys[ip_swap] != ibin ) && (ip_swap<(int)npart))
-                        ip_swap++;
-                    source_particles.swapParticle(ip, ip_swap);
-                    int tmp = src_bin_keys[ip];
-                    src_bin_keys[ip] = src_bin_keys[ip_swap];
-                    src_bin_keys[ip_swap] = tmp;
-                } // rearrange particles
-            } // end loop on particles of a cell
-
-            // inject in main data structure per cell
-            source_particles.copyParticles( istart, bin_count[ibin],
-                                        *particles,
-                                        first_index[ibin] );
-            last_index[ibin] += bin_count[ibin];
-            for ( unsigned int idx=ibin+1 ; idx<last_index.size() ; idx++ ) {
-                first_index[idx] += bin_count[ibin];
-                last_index[idx]  += bin_count[ibin];
-            }
-
-        }
-        // update istart/istop fot the next cell
-        istart += bin_count[ibin];
-        if ( ibin != (int)nbin-1  )
-            istop  += bin_count[ibin+1];
-        else
-            istop = npart;
-
-    } // End cell loop
+    // Insert all new particles at once in their bins
+    vector<int> bin_count;
+    particles->importParticlesInBins( source_particles, src_bin_keys, first_index, last_index, bin_count );
 
     source_particles.clear();
 }
@@ -755,55 +755,14 @@ void SpeciesV::importParticles( Params &params, Patch *patch, Particles &source_
             src_cell_keys[ip] = src_cell_keys[ip] * length[ipos] + IX;
         }
     }
-    vector<int> src_count( ncells, 0 );
-    for( unsigned int ip=0; ip < npart ; ip++ )
-        src_count[src_cell_keys[ip]] ++;
-
-    // sort new parts par cells
-    int istart = 0;
-    int istop  = src_count[0];
-
-    for ( int icell = 0 ; icell < (int)ncells ; icell++ ) {
-        if (src_count[icell]!=0) {
-            for( int ip=istart; ip < istop ; ip++ ) {
-                if ( src_cell_keys[ip] == icell )
-                    continue;
-                else { // rearrange particles
-                    int ip_swap = istop;
-                    while (( src_cell_keys[ip_swap] != icell ) && (ip_swap<(int)npart))
-                        ip_swap++;
-                    source_particles.swapParticle(ip, ip_swap);
-                    int tmp = src_cell_keys[ip];
-                    src_cell_keys[ip] = src_cell_keys[ip_swap];
-                    src_cell_keys[ip_swap] = tmp;
-                } // rearrange particles
-            } // end loop on particles of a cell
-
-            // inject in main data structure per cell
-            source_particles.copyParticles( istart, src_count[icell],
-                                        *particles,
-                                        first_index[icell] );
-            last_index[icell] += src_count[icell];
-            for ( unsigned int idx=icell+1 ; idx<last_index.size() ; idx++ ) {
-                first_index[idx] += src_count[icell];
-                last_index[idx]  += src_count[icell];
-            }
-            count[icell] += src_count[icell];
-
-        }
-        // update istart/istop fot the next cell
-        istart += src_count[icell];
-        if ( icell != (int)ncells-1  )
-            istop  += src_count[icell+1];
-        else
-            istop = npart;
-
-    } // End cell loop
-    //source_particles.clear();
-
-    // Set place for new particles in species->particles->cell_keys
-    for (unsigned int ip=0;ip<npart ; ip++ )
-        addSpaceForOneParticle();
+    // Insert all new particles at once in their cells
+    vector<int> src_count;
+    particles->importParticlesInBins( source_particles, src_cell_keys, first_index, last_index, src_count );
+    // Keys of the new particles are computed at the next dynamics
+    particles->cell_keys.resize( particles->size(), -1 );
+    for( unsigned int icell = 0 ; icell < ncells ; icell++ ) {
+        count[icell] += src_count[icell];
+    }
 
     source_particles.clear();
 
@@ -0,0 +1,128 @@
+#include "FFT.h"
+
+#include <cmath>
+
+using namespace std;
+
+FFT::FFT( unsigned int n ) :
+    n_( n )
+{
+    // Size of the radix-2 transform
+    m_ = 1;
+    while( m_ < n_ ) {
+        m_ *= 2;
+    }
+    bluestein_ = m_ != n_;
+    if( bluestein_ ) {
+        m_ = 1;
+        while( m_ < 2*n_-1 ) {
+            m_ *= 2;
+        }
+    }
+    
+    // Twiddle factors and bit-reversal permutation
+    twiddles_.resize( m_/2 );
+    for( unsigned int k=0; k<m_/2; k++ ) {
+        double a = -2.*M_PI*( double )k/( double )m_;
+        twiddles_[k] = complex<double>( cos( a ), sin( a ) );
+    }
+    bitrev_.resize( m_ );
+    unsigned int log2m = 0;
+    while( ( 1u<<log2m ) < m_ ) {
+        log2m++;
+    }
+    for( unsigned int k=0; k<m_; k++ ) {
+        unsigned int r = 0;
+        for( unsigned int b=0; b<log2m; b++ ) {
+            r |= ( ( k>>b )&1 ) << ( log2m-1-b );
+        }
+        bitrev_[k] = r;
+    }
+    
+    // Bluestein: exp(-2i pi jk/n) = w_j w_k conj(w_{k-j}) with w_k = exp(-i pi k^2/n)
+    if( bluestein_ ) {
+        chirp_.resize( n_ );
+        for( unsigned int k=0; k<n_; k++ ) {
+            // k^2 modulo 2n to keep the argument small
+            unsigned long long k2 = ( ( unsigned long long )k*( unsigned long long )k ) % ( 2ull*n_ );
+            double a = -M_PI*( double )k2/( double )n_;
+            chirp_[k] = complex<double>( cos( a ), sin( a ) );
+        }
+        chirp_fft_.assign( m_, 0. );
+        chirp_fft_[0] = conj( chirp_[0] );
+        for( unsigned int k=1; k<n_; k++ ) {
+            chirp_fft_[k] = conj( chirp_[k] );
+            chirp_fft_[m_-k] = conj( chirp_[k] );
+        }
+        radix2( &chirp_fft_[0] );
+        for( unsigned int k=0; k<m_; k++ ) {
+            chirp_fft_[k] /= ( double )m_;
+        }
+    }
+}
+
+void FFT::radix2( complex<double> *z )
+{
+    for( unsigned int k=0; k<m_; k++ ) {
+        if( k < bitrev_[k] ) {
+            swap( z[k], z[bitrev_[k]] );
+        }
+    }
+    for( unsigned int half=1; half<m_; half*=2 ) {
+        unsigned int step = m_/( 2*half );
+        for( unsigned int start=0; start<m_; start+=2*half ) {
+            for( unsigned int k=0; k<half; k++ ) {
+                complex<double> t = twiddles_[k*step] * z[start+k+half];
+                z[start+k+half] = z[start+k] - t;
+                z[start+k]     += t;
+            }
+        }
+    }
+}
+
+void FFT::forward( complex<double> *z, vector<complex<double> > &work )
+{
+    if( ! bluestein_ ) {
+        radix2( z );
+        return;
+    }
+    // Convolution of z*w with conj(w), computed in Fourier space
+    for( unsigned int k=0; k<n_; k++ ) {
+        work[k] = z[k] * chirp_[k];
+    }
+    for( unsigned int k=n_; k<m_; k++ ) {
+        work[k] = 0.;
+    }
+    radix2( &work[0] );
+    // Backward transform obtained as the conjugate of the forward transform of the conjugate
+    for( unsigned int k=0; k<m_; k++ ) {
+        work[k] = conj( work[k] * chirp_fft_[k] );
+    }
+    radix2( &work[0] );
+    for( unsigned int k=0; k<n_; k++ ) {
+        z[k] = conj( work[k] ) * chirp_[k];
+    }
+}
+
+void FFT::transform( complex<double> *z, unsigned int outer, unsigned int inner, int sign )
+{
+    unsigned int nseq = outer*inner;
+    double norm = sign > 0 ? 1./( double )n_ : 1.;
+    #pragma omp parallel
+    {
+        vector<complex<double> > work( bluestein_ ? m_ : 0 );
+        vector<complex<double> > seq( n_ );
+        #pragma omp for schedule(static)
+        for( unsigned int s=0; s<nseq; s++ ) {
+            // Copy the sequence (conjugate for the backward transform)
+            complex<double> *z0 = z + ( s/inner )*n_*inner + s%inner;
+            for( unsigned int k=0; k<n_; k++ ) {
+                seq[k] = sign > 0 ? conj( z0[k*inner] ) : z0[k*inner];
+            }
+            forward( &seq[0], work );
+            for( unsigned int k=0; k<n_; k++ ) {
+                z0[k*inner] = sign > 0 ? conj( seq[k] ) * norm : seq[k];
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef FFT_H
+#define FFT_H
+
+#include <vector>
+#include <complex>
+
+//! Discrete Fourier transform of complex sequences of a given length
+//! Powers of 2 use an iterative radix-2 algorithm, other lengths use Bluestein's
+//! algorithm (a convolution computed with a radix-2 transform of a larger size).
+//! The conventions are those of numpy.fft: the forward transform is not normalized,
+//! the backward transform is normalized by 1/n.
+class FFT
+{
+public:
+    //! Prepares the transforms of sequences of length n
+    FFT( unsigned int n );
+    ~FFT() {};
+    
+    //! Length of the transformed sequences
+    inline unsigned int size()
+    {
+        return n_;
+    }
+    
+    //! In-place transform along the axis of length n of a C-ordered array of shape (outer, n, inner)
+    //! sign=-1 for the forward transform (numpy.fft.fft), sign=+1 for the backward one (numpy.fft.ifft)
+    //! The outer*inner sequences are distributed between the OpenMP threads
+    void transform( std::complex<double> *z, unsigned int outer, unsigned int inner, int sign );
+
+private:
+    //! Forward transform of one contiguous sequence (work has size m_ when using Bluestein)
+    void forward( std::complex<double> *z, std::vector<std::complex<double> > &work );
+    
+    //! Forward radix-2 transform of a contiguous sequence of length m_
+    void radix2( std::complex<double> *z );
+    
+    //! Length of the sequences
+    unsigned int n_;
+    
+    //! Length of the radix-2 transform (n_, or a power of 2 larger than 2n_-2 with Bluestein)
+    unsigned int m_;
+    
+    //! True if n_ is not a power of 2
+    bool bluestein_;
+    
+    //! Twiddle factors exp(-2i pi k/m_) for k<m_/2
+    std::vector<std::complex<double> > twiddles_;
+    
+    //! Bit-reversal permutation of the radix-2 transform
+    std::vector<unsigned int> bitrev_;
+    
+    //! Bluestein chirp exp(-i pi k^2/n_) for k<n_
+    std::vector<std::complex<double> > chirp_;
+    
+    //! Transform of the conjugate chirp, wrapped and padded to m_, divided by m_
+    std::vector<std::complex<double> > chirp_fft_;
+};
+
+#endif
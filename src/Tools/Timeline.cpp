@@ -0,0 +1,206 @@
+#include "Timeline.h"
+
+#include <iomanip>
+#include <sstream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "SmileiMPI.h"
+#include "TimeSelection.h"
+#include "PyTools.h"
+#include "Tools.h"
+
+using namespace std;
+
+Timeline::Timeline() :
+    timeSelection_( new TimeSelection() ),
+    flush_timeSelection_( new TimeSelection() ),
+    active_( false ),
+    itime_( 0 ),
+    t0_( 0. ),
+    rank_( 0 ),
+    first_event_( true )
+{
+    names_.resize( nOperators );
+    names_[Dynamics                 ] = "Dynamics";
+    names_[ExchangeParticles        ] = "Exchange particles";
+    names_[FinalizeExchangeParticles] = "Finalize exchange particles";
+    names_[ImportParticles          ] = "Import particles";
+    names_[MergeParticles           ] = "Merge particles";
+    names_[Collisions               ] = "Collisions";
+    names_[MaxwellAmpere            ] = "Maxwell-Ampere";
+    names_[MaxwellFaraday           ] = "Maxwell-Faraday";
+    names_[MaxwellFused             ] = "Maxwell (fused)";
+    names_[BoundaryConditions       ] = "Boundary conditions";
+}
+
+Timeline::~Timeline()
+{
+    close();
+    delete timeSelection_;
+    delete flush_timeSelection_;
+}
+
+void Timeline::init( SmileiMPI *smpi )
+{
+    if( PyTools::nComponents( "DiagPerformances" ) == 0 ) {
+        return;
+    }
+    
+    delete timeSelection_;
+    timeSelection_ = new TimeSelection( PyTools::extract_py( "timeline", "DiagPerformances" ), "Timeline" );
+    if( timeSelection_->isEmpty() ) {
+        return;
+    }
+    delete flush_timeSelection_;
+    flush_timeSelection_ = new TimeSelection( PyTools::extract_py( "flush_every", "DiagPerformances" ), "Timeline" );
+    
+    // Names of the species
+    unsigned int nspec = PyTools::nComponents( "Species" );
+    species_names_.resize( nspec );
+    for( unsigned int ispec=0; ispec<nspec; ispec++ ) {
+        PyTools::extract( "name", species_names_[ispec], "Species", ispec );
+    }
+    
+    // One buffer per thread
+    unsigned int nthreads = 1;
+#ifdef _OPENMP
+    nthreads = omp_get_max_threads();
+#endif
+    buffers_.resize( nthreads );
+    for( unsigned int ithread=0; ithread<nthreads; ithread++ ) {
+        buffers_[ithread].events.reserve( 4096 );
+        buffers_[ithread].phase_start.resize( names_.size(), 0. );
+    }
+    
+    // One file per MPI process
+    rank_ = smpi->getRank();
+    ostringstream filename( "" );
+    filename << "timeline_" << rank_ << ".json";
+    fout_.open( filename.str().c_str() );
+    if( ! fout_.is_open() ) {
+        ERROR( "Cannot open the timeline file " << filename.str() );
+    }
+    fout_ << "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank_ << ",\"args\":{\"name\":\"MPI process " << rank_ << "\"}}";
+    for( unsigned int ithread=0; ithread<nthreads; ithread++ ) {
+        fout_ << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank_ << ",\"tid\":" << ithread
+              << ",\"args\":{\"name\":\"OpenMP thread " << ithread << "\"}}";
+    }
+    first_event_ = false;
+    
+    if( smpi->isMaster() ) {
+        MESSAGE( 1, "Recording the timeline of selected iterations in timeline_*.json" );
+    }
+    
+    // Common origin of the times
+    smpi->barrier();
+    t0_ = MPI_Wtime();
+}
+
+unsigned int Timeline::addPhase( string name )
+{
+    names_.push_back( name );
+    for( unsigned int ithread=0; ithread<buffers_.size(); ithread++ ) {
+        buffers_[ithread].phase_start.resize( names_.size(), 0. );
+    }
+    return names_.size()-1;
+}
+
+void Timeline::prepare( int itime )
+{
+    itime_ = itime;
+    active_ = fout_.is_open() && timeSelection_->theTimeIsNow( itime );
+}
+
+void Timeline::flush( int itime )
+{
+    if( fout_.is_open() && flush_timeSelection_->theTimeIsNow( itime ) ) {
+        write();
+        fout_.flush();
+    }
+}
+
+void Timeline::close()
+{
+    active_ = false;
+    if( fout_.is_open() ) {
+        write();
+        fout_ << "\n]\n";
+        fout_.close();
+    }
+}
+
+void Timeline::beginPhase( unsigned int phase )
+{
+    if( active_ ) {
+        int ithread = 0;
+#ifdef _OPENMP
+        ithread = omp_get_thread_num();
+#endif
+        buffers_[ithread].phase_start[phase] = MPI_Wtime();
+    }
+}
+
+void Timeline::endPhase( unsigned int phase )
+{
+    if( active_ ) {
+        int ithread = 0;
+#ifdef _OPENMP
+        ithread = omp_get_thread_num();
+#endif
+        double &start = buffers_[ithread].phase_start[phase];
+        if( start > 0. ) {
+            add( phase, start, MPI_Wtime(), -1, -1 );
+            start = 0.;
+        }
+    }
+}
+
+void Timeline::add( unsigned int name, double start, double end, int hindex, int ispec )
+{
+    int ithread = 0;
+#ifdef _OPENMP
+    ithread = omp_get_thread_num();
+#endif
+    TimelineEvent event;
+    event.start  = start;
+    event.end    = end;
+    event.itime  = itime_;
+    event.hindex = hindex;
+    event.ispec  = ( short )ispec;
+    event.name   = ( unsigned short )name;
+    buffers_[ithread].events.push_back( event );
+}
+
+void Timeline::write()
+{
+    // Complete events ("ph":"X"), times in microseconds
+    fout_ << fixed << setprecision( 3 );
+    for( unsigned int ithread=0; ithread<buffers_.size(); ithread++ ) {
+        vector<TimelineEvent> &events = buffers_[ithread].events;
+        for( unsigned int i=0; i<events.size(); i++ ) {
+            fout_ << ( first_event_ ? "\n" : ",\n" );
+            first_event_ = false;
+            fout_ << "{\"name\":\"" << names_[events[i].name] << "\",\"cat\":\"" << ( events[i].name < nOperators ? "patch" : "phase" )
+                  << "\",\"ph\":\"X\",\"pid\":" << rank_ << ",\"tid\":" << ithread
+                  << ",\"ts\":" << ( events[i].start - t0_ )*1.e6 << ",\"dur\":" << ( events[i].end - events[i].start )*1.e6
+                  << ",\"args\":{\"iteration\":" << events[i].itime;
+            if( events[i].hindex >= 0 ) {
+                fout_ << ",\"patch\":" << events[i].hindex;
+            }
+            if( events[i].ispec >= 0 ) {
+                fout_ << ",\"species\":\"";
+                if( events[i].ispec < ( int )species_names_.size() ) {
+                    fout_ << species_names_[events[i].ispec];
+                } else {
+                    fout_ << events[i].ispec;
+                }
+                fout_ << "\"";
+            }
+            fout_ << "}}";
+        }
+        events.clear();
+    }
+}
@@ -0,0 +1,124 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include <mpi.h>
+
+class SmileiMPI;
+class TimeSelection;
+
+//! One event of the timeline: an operator applied to a patch, or a phase of the time loop
+struct TimelineEvent {
+    //! Beginning and end (MPI_Wtime)
+    double start, end;
+    //! Iteration
+    int itime;
+    //! Hilbert index of the patch (-1 for a phase)
+    int hindex;
+    //! Index of the species (-1 if none)
+    short ispec;
+    //! Index of the name of the event
+    unsigned short name;
+};
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class Timeline: records the events of each OpenMP thread during selected iterations,
+//! and writes them in a Chrome-trace JSON file per MPI process (readable by Perfetto or chrome://tracing)
+//  --------------------------------------------------------------------------------------------------------------------
+class Timeline
+{
+public:
+    //! Operators recorded for each patch
+    enum Operator { Dynamics, ExchangeParticles, FinalizeExchangeParticles, ImportParticles, MergeParticles,
+                    Collisions, MaxwellAmpere, MaxwellFaraday, MaxwellFused, BoundaryConditions, nOperators
+                  };
+    
+    Timeline();
+    ~Timeline();
+    
+    //! Reads the options of DiagPerformances and opens the file of this MPI process
+    void init( SmileiMPI *smpi );
+    
+    //! Registers a phase of the time loop (one for each Timer) and returns its index
+    unsigned int addPhase( std::string name );
+    
+    //! Starts or stops the recording at the beginning of an iteration (outside of parallel regions)
+    void prepare( int itime );
+    
+    //! Writes the recorded events at the iterations selected by DiagPerformances.flush_every (outside of parallel regions)
+    void flush( int itime );
+    
+    //! Writes the remaining events and closes the file
+    void close();
+    
+    //! Whether events are recorded at this iteration
+    inline bool active()
+    {
+        return active_;
+    }
+    
+    //! Current time when recording (0 otherwise), to be passed to record()
+    inline double now()
+    {
+        return active_ ? MPI_Wtime() : 0.;
+    }
+    
+    //! Records an operator, from start until now, applied to a patch and a species (-1 if none)
+    inline void record( unsigned int op, double start, int hindex, int ispec = -1 )
+    {
+        if( active_ ) {
+            add( op, start, MPI_Wtime(), hindex, ispec );
+        }
+    }
+    
+    //! Beginning of a phase by the current thread
+    void beginPhase( unsigned int phase );
+    
+    //! End of a phase by the current thread (ignored if it did not begin)
+    void endPhase( unsigned int phase );
+
+private:
+    //! Appends an event in the buffer of the current thread
+    void add( unsigned int name, double start, double end, int hindex, int ispec );
+    
+    //! Writes and empties the buffers of all threads
+    void write();
+    
+    //! Buffer of one thread, padded to avoid sharing cache lines with the other threads
+    struct ThreadBuffer {
+        std::vector<TimelineEvent> events;
+        //! Beginning of the phases in progress (0 when not in progress)
+        std::vector<double> phase_start;
+        char padding[64];
+    };
+    std::vector<ThreadBuffer> buffers_;
+    
+    //! Names of the operators, then of the phases
+    std::vector<std::string> names_;
+    
+    //! Iterations recorded, and iterations when the file is written
+    TimeSelection *timeSelection_;
+    TimeSelection *flush_timeSelection_;
+    
+    //! Whether the current iteration is recorded, and its number
+    bool active_;
+    int itime_;
+    
+    //! Names of the species
+    std::vector<std::string> species_names_;
+    
+    //! Origin of the times
+    double t0_;
+    
+    //! MPI rank
+    int rank_;
+    
+    //! Output file, and whether an event was already written
+    std::ofstream fout_;
+    bool first_event_;
+};
+
+#endif
@@ -8,12 +8,15 @@
 #include "SmileiMPI.h"
 #include "Tools.h"
 #include "VectorPatch.h"
+#include "Timeline.h"
 
 using namespace std;
 
 Timer::Timer( string name ) :
     name_( name ),
     time_acc_( 0.0 ),
+    timeline_( NULL ),
+    timeline_id_( 0 ),
     smpi_( NULL )
 {
     register_timers.resize( 0, 0. );
@@ -33,6 +36,10 @@ void Timer::init( SmileiMPI *smpi )
 //! Accumulate time couting from last init/restart
 void Timer::update( bool store )
 {
+    // Each thread ends its phase before waiting for the others
+    if( timeline_ ) {
+        timeline_->endPhase( timeline_id_ );
+    }
     #pragma omp barrier
     #pragma omp master
     {
@@ -86,6 +93,9 @@ void Timer::restart()
     {
         last_start_ = MPI_Wtime();
     }
+    if( timeline_ ) {
+        timeline_->beginPhase( timeline_id_ );
+    }
 }
 
 void Timer::reboot()
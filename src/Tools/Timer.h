@@ -6,6 +6,8 @@
 
 #include "SmileiMPI.h"
 
+class Timeline;
+
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class Timer
 //  --------------------------------------------------------------------------------------------------------------------
@@ -57,6 +59,11 @@ public:
     unsigned int patch_timer_id;
 #endif
     
+    //! Timeline where each thread records the periods between restart and update (NULL if none)
+    Timeline *timeline_;
+    //! Id of the associated phase in the timeline
+    unsigned int timeline_id_;
+    
 private:
     //! Last timer start
     double last_start_;
@@ -106,6 +106,15 @@ Timers::Timers( SmileiMPI *smpi ) :
         timers[i]->init( smpi );
     }
     
+    // The main timers are also phases of the timeline
+    for( unsigned int i=1; i<patch_timer_id_start+1; i++ ) {
+        timers[i]->timeline_ = &timeline;
+        timers[i]->timeline_id_ = timeline.addPhase( timers[i]->name() );
+    }
+    if( ! smpi->test_mode ) {
+        timeline.init( smpi );
+    }
+    
     if( smpi->getRank()==0 && ! smpi->test_mode ) {
         remove( "profil.txt" );
         ofstream fout;
@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "Timer.h"
+#include "Timeline.h"
 
 class SmileiMPI;
 
@@ -37,6 +38,9 @@ public:
     Timer envelope  ;
     Timer susceptibility ;
     Timer grids ;
+    
+    //! Events of each thread during the iterations selected by DiagPerformances.timeline
+    Timeline timeline;
 #ifdef __DETAILED_TIMERS
     Timer interpolator  ;
     Timer pusher  ;
@@ -0,0 +1,39 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Previous fit of the synchrotron spectrum (RadiationTools::computeBesselPartsRadiatedPower)
+def fit(nu, cst):
+    if nu < 0.1:
+        f2 = 1.074764120720013 / np.cbrt(nu*nu)
+        f1 = 2*f2 - 1.813799364234217
+        return f1 + cst*f2
+    elif nu > 10:
+        return (1.+cst)*1.253314137315500*np.exp(-nu)/np.sqrt(nu)
+    lognu = np.log(nu)
+    c1 = [-4.364684279797524e-01, 1.670543589881836e+00, 4.533108925728350e-01, 1.723519212869859e-01, 5.431864123685266e-02, 7.892740572869308e-03]
+    c2 = [-7.121012104149862e-01, 1.539212709860801e+00, 4.589601096726573e-01, 1.782660550734939e-01, 5.412029310872778e-02, 7.694562217592761e-03]
+    f1 = c1[0] - sum( c1[n]*lognu**n for n in range(1,6) )
+    f2 = c2[0] - sum( c2[n]*lognu**n for n in range(1,6) )
+    return np.exp(f1) + cst*np.exp(f2)
+
+for idiag, name in enumerate(S.namelist.gammas):
+    # Mean Lorentz factor and quantum parameter of the species
+    w    = S.ParticleBinning(3*idiag  ).getData()[-1]
+    ekin = S.ParticleBinning(3*idiag+1).getData()[-1]
+    chi  = S.ParticleBinning(3*idiag+2).getData()[-1] / w
+    gamma = 1. + ekin / w
+    
+    # Spectrum of the last output, on a linear axis
+    spectrum = np.array( S.RadiationSpectrum(idiag).getData()[-1] )
+    energies = np.array( S.RadiationSpectrum(idiag).getAxis("gamma") )
+    
+    # Expected shape: xi * F( nu, xi*zeta ), with zeta = xi/(1-xi) and nu = 2/3 zeta/chi
+    xi   = energies / gamma
+    zeta = xi / (1.-xi)
+    expected = np.array([ x * fit(2./3.*z/chi, x*z) for x, z in zip(xi, zeta) ])
+    
+    # The table differs from the fit by less than 1% of the peak
+    Validate("Species "+name+": spectrum not empty", bool(spectrum.max() > 0.) )
+    Validate("Species "+name+": tabulated spectrum equals the fit", bool(np.abs( spectrum/spectrum.max() - expected/expected.max() ).max() < 1e-2) )
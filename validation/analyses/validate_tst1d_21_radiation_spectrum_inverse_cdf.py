@@ -0,0 +1,32 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# The reference values are those of tst1d_18_radiation_spectrum_chi0.1,
+# where the photons are sampled by a search in the table xi
+sim_hyper_volume = S.namelist.Lx
+
+# extract the power radiated away from the RadiationSpectrum diagnostic
+spc_noRR_t = np.array( S.RadiationSpectrum(0).getData() )
+spc_MC_t   = np.array( S.ParticleBinning(1).getData() ) * sim_hyper_volume
+gaxis      = np.array( S.ParticleBinning(1).getAxis("gamma") )
+
+spc_noRR = np.mean(spc_noRR_t,axis=0)
+spc_MC   = spc_MC_t[-1]/S.namelist.Tsim
+
+dgaxis     = np.zeros(gaxis.size)
+dgaxis[0]  = gaxis[0]
+for i in range(1,gaxis.size): dgaxis[i] = gaxis[i]-gaxis[i-1]
+
+Prad_noRR  = np.sum(dgaxis*spc_noRR)
+
+# extract the power radiated away from the MC ParticleBinning diagnostic
+Prad_MC    = np.sum(dgaxis*spc_MC)
+
+print( "Prad (noRR)   = ", Prad_noRR)
+print( "Prad (MC)     = ", Prad_MC)
+
+Validate("Prad (noRR)",Prad_noRR, 1.e-6*Prad_noRR)
+Validate("Prad   (MC)",  Prad_MC, 1.e-2*Prad_MC  )
+Validate("Radiation Spectrum (noRR)", spc_noRR, 1.e-6)
@@ -0,0 +1,16 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Compiled and python profiles must give the same densities
+for name in S.namelist.profiles:
+	compiled = S.Field.Field0("Rho_compiled_"+name, timesteps=0).getData()[0]
+	python   = S.Field.Field0("Rho_python_"  +name, timesteps=0).getData()[0]
+	Validate("Profile "+name+" not empty", bool(np.abs(python).max() > 0.) )
+	Validate("Profile "+name+": compiled equals python", bool(np.allclose(compiled, python, rtol=1e-10, atol=1e-12*np.abs(python).max())) )
+
+# Compiled and python external fields
+Ey = S.Field.Field0("Ey", timesteps=0).getData()[0]
+Bx = S.Field.Field0("Bx", timesteps=0).getData()[0]
+Validate("External field: compiled equals python", bool(np.allclose(Ey, Bx, rtol=1e-10, atol=1e-12*np.abs(Bx).max())) )
@@ -0,0 +1,16 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Pre-defined and python profiles must give the same densities
+for name in S.namelist.profiles:
+	predefined = S.Field.Field0("Rho_predefined_"+name, timesteps=0).getData()[0]
+	python     = S.Field.Field0("Rho_python_"    +name, timesteps=0).getData()[0]
+	Validate("Profile "+name+" not empty", bool(np.abs(python).max() > 0.) )
+	Validate("Profile "+name+": predefined equals python", bool(np.allclose(predefined, python, rtol=1e-10, atol=1e-12*np.abs(python).max())) )
+
+# Pre-defined and python external fields
+Ey = S.Field.Field0("Ey", timesteps=0).getData()[0]
+Bx = S.Field.Field0("Bx", timesteps=0).getData()[0]
+Validate("External field: predefined equals python", bool(np.allclose(Ey, Bx, rtol=1e-10, atol=1e-12*np.abs(Bx).max())) )
@@ -0,0 +1,11 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Built-in diagnostics (binned together by chunks) and python ones (whole patches) must give the same histograms
+for i in range(len(S.namelist.diagnostics)):
+	builtin = np.array( S.ParticleBinning(2*i  ).getData() )
+	python  = np.array( S.ParticleBinning(2*i+1).getData() )
+	Validate("Diagnostic "+str(i)+" not empty", bool(np.abs(python).max() > 0.) )
+	Validate("Diagnostic "+str(i)+": built-in equals python", bool(builtin.shape == python.shape and np.allclose(builtin, python, rtol=1e-12, atol=1e-12*np.abs(python).max())) )
@@ -0,0 +1,23 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+def tracked(species):
+	track = S.TrackParticles(species, axes=["x", "y", "px", "py"], sort=False)
+	data = track.getData()
+	particles = {}
+	for t in data["times"]:
+		a = np.array([ data[t][axis] for axis in ["x", "y", "px", "py"] ])
+		particles[t] = a[:, np.lexsort(a[::-1])]
+	return particles
+
+# Compiled and python filters must track the same particles
+for name in S.namelist.filters:
+	compiled = tracked("compiled_"+name)
+	python   = tracked("python_"  +name)
+	Validate("Filter "+name+" tracks particles", bool(sum( p.shape[1] for p in python.values() ) > 0) )
+	Validate("Filter "+name+": compiled equals python", bool(
+		sorted(compiled.keys()) == sorted(python.keys())
+		and all( compiled[t].shape == python[t].shape and np.array_equal(compiled[t], python[t]) for t in python )
+	) )
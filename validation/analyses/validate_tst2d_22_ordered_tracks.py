@@ -0,0 +1,29 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+axes = ["x", "y", "px", "py"]
+def tracked(species):
+	data = S.TrackParticles(species, axes=["Id"]+axes).getData()
+	particles = []
+	for it in range(len(data["times"])):
+		a = np.array([ data[axis][it] for axis in axes ])
+		a = a[:, ~np.isnan(a).any(axis=0)]
+		particles.append( a[:, np.lexsort(a[::-1])] )
+	return data, particles
+
+ordered_data, ordered = tracked("ordered")
+disordered_data, disordered = tracked("disordered")
+
+# Same particles tracked at each output, in both modes
+Validate("Particles tracked", bool(disordered[-1].shape[1] > disordered[0].shape[1] > 0) )
+Validate("Ordered equals disordered", bool(
+	len(ordered) == len(disordered)
+	and all( o.shape == d.shape and np.array_equal(o, d) for o, d in zip(ordered, disordered) )
+) )
+
+# In the ordered file, each column holds a single particle
+Id = ordered_data["Id"]
+same_id = all( len(set(Id[:,i][Id[:,i] > 0])) == 1 for i in range(Id.shape[1]) )
+Validate("Each ordered particle keeps its position", bool(same_id and len(set(Id.max(axis=0))) == Id.shape[1]) )
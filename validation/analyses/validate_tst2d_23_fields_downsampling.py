@@ -0,0 +1,30 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# Average over blocks of f cells in each dimension: trapezoidal rule on primal axes
+# (n+1 points for n cells), midpoint rule on dual axes (n+2 points, first one outside)
+def block_average(A, f, ncells):
+	for axis, n in enumerate(ncells):
+		A = np.moveaxis(A, axis, 0)
+		if A.shape[0] == n+1:
+			w = np.ones((f+1,)) / f
+			w[0] *= 0.5
+			w[-1] *= 0.5
+			A = np.array([ np.tensordot(w, A[k*f:k*f+f+1], axes=1) for k in range(n//f) ])
+		else:
+			A = np.array([ A[k*f+1:k*f+f+1].mean(axis=0) for k in range(n//f) ])
+		A = np.moveaxis(A, 0, axis)
+	return A
+
+ncells = [ int(round(l/d)) for l, d in zip(S.namelist.Main.grid_length, S.namelist.Main.cell_length) ]
+for full, downsampled, factors in [(0, 1, [2, 8]), (2, 3, [4])]:
+	for field in S.namelist.fields:
+		F = np.array( S.Field(full, field).getData() )
+		for level, f in enumerate(factors):
+			D = np.array( S.Field(downsampled, field, level=level).getData() )
+			expected = np.array([ block_average(A, f, ncells) for A in F ])
+			Validate("Diag "+str(downsampled)+" "+field+" level "+str(level)+" equals the block average",
+				bool(D.shape == expected.shape and np.allclose(D, expected, rtol=1e-10, atol=1e-10*np.abs(expected).max())) )
+	Validate("Diag "+str(full)+" not empty", bool(np.abs(np.array(S.Field(full, "Ey").getData())).max() > 0.) )
@@ -0,0 +1,23 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+tavg = S.namelist.time_average
+subgrids = S.namelist.subgrids + [S.namelist.subgrids[1]]
+
+for field in S.namelist.fields:
+	instantaneous = S.Field(0, field)
+	for i, subgrid in enumerate(subgrids):
+		diag = S.Field(i+1, field)
+		timesteps = diag.getTimesteps()
+		averaged = np.array( diag.getData() )
+		# Average of the instantaneous fields over the timesteps ending at each output
+		expected = []
+		for t in timesteps:
+			A = np.mean([ instantaneous.getData(timestep=it)[0] for it in range(int(t)-tavg+1, int(t)+1) ], axis=0)
+			expected.append( A if subgrid is None else A[subgrid] )
+		expected = np.array(expected)
+		rtol = 1e-5 if i == len(S.namelist.subgrids) else 1e-10
+		Validate("Diag "+str(i+1)+" "+field+" equals the average of the instantaneous fields",
+			bool(len(timesteps) > 1 and averaged.shape == expected.shape and np.allclose(averaged, expected, rtol=rtol, atol=rtol*np.abs(expected).max())) )
@@ -0,0 +1,55 @@
+import os, re, numpy as np
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+dx, dy = S.namelist.Main.cell_length
+nx, ny = [int(round(l/d)) for l, d in zip(S.namelist.Main.grid_length, S.namelist.Main.cell_length)]
+max_error = S.namelist.Main.poisson_max_error
+# The solver also covers the ghost cells of the patches at xmin and xmax
+oversize = S.namelist.Main.interpolation_order
+
+# Iterations and residual of the preconditioned solver, printed by Smilei
+with open("./restart000/smilei_exe.out") as f:
+	m = re.search(r"Poisson solver converged at iteration: (\d+), relative err is ctrl = ([^ ]+) x 1e-14", f.read())
+pcg_iterations = int(m.group(1))
+pcg_ctrl = float(m.group(2))*1e-14
+
+# Plain conjugate gradient, as in Smilei with poisson_preconditioner_sweeps = 0:
+# phi = 0 beyond the ghost cells along x, periodic along y
+rho = np.array(S.Field(0, "Rho").getData(timestep=0)[0])[:, :ny]
+rho = np.pad(rho, ((oversize, oversize), (0, 0)), "constant")
+def laplacian(p):
+	px = np.pad(p, ((1, 1), (0, 0)), "constant")
+	return ( (px[:-2]+px[2:])/dx**2 + (np.roll(p, 1, 1)+np.roll(p, -1, 1))/dy**2
+		- 2.*(1./dx**2+1./dy**2)*p )
+phi = np.zeros_like(rho)
+r = -rho
+p = r.copy()
+r_dot_r = (r*r).sum()
+cg_iterations = 0
+while r_dot_r/((nx+1)*(ny+1)) > max_error and cg_iterations < S.namelist.Main.poisson_max_iteration:
+	cg_iterations += 1
+	Ap = laplacian(p)
+	alpha = r_dot_r/(p*Ap).sum()
+	phi += alpha*p
+	r -= alpha*Ap
+	rnew_dot_rnew = (r*r).sum()
+	p = r + rnew_dot_rnew/r_dot_r*p
+	r_dot_r = rnew_dot_rnew
+
+Validate("Preconditioned Poisson solver converged", bool(pcg_ctrl <= max_error))
+Validate("Preconditioned Poisson solver needs fewer iterations than the plain one", bool(pcg_iterations < cg_iterations))
+
+# Fields of the plain conjugate gradient, up to the constant added by the centering
+phi = phi[oversize:oversize+nx+1]
+expected = {
+	"Ex": ( phi[:-1, :] - phi[1:, :] )/dx,
+	"Ey": ( phi - np.roll(phi, -1, 1) )/dy,
+}
+for field, E in expected.items():
+	A = np.array(S.Field(0, field).getData(timestep=0)[0])
+	A = A[1:nx+1, :ny] if field == "Ex" else A[:, 1:ny+1]
+	difference = A - E
+	difference -= difference.mean()
+	Validate(field+" equals the field of the plain Poisson solver", bool(np.abs(difference).max() < 1e-4*np.abs(E).max()))
@@ -0,0 +1,35 @@
+import os, re, numpy as np, math
+import happi
+
+S = happi.Open(["./restart*"], verbose=False)
+
+# TOTAL WEIGHT AND MEAN CHARGE OF THE IONS VS TIME, FROM THE CHARGE DISTRIBUTIONS
+def weight_and_mean_charge( diag ):
+	charge = diag.get()
+	charge_distribution = np.array( charge["data"] )
+	n1, n2 = charge_distribution.shape
+	total = charge_distribution.sum(axis=1)
+	return total, (charge_distribution * np.outer(np.ones((n1,)), np.arange(n2))).sum(axis=1) / total
+
+Wh, Zh = weight_and_mean_charge( S.ParticleBinning.Diag0() )
+Wc, Zc = weight_and_mean_charge( S.ParticleBinning.Diag1() )
+We = np.array( S.ParticleBinning.Diag2().get()["data"] ).sum(axis=1)
+
+# The ionization must have happened, and the charge states may only increase
+Validate("Hydrogen is ionized", bool(Zh[-1] > 0.) )
+Validate("Mean charges do not decrease", bool(np.all(np.diff(Zh) >= 0.) and np.all(np.diff(Zc) >= 0.)) )
+
+# The weight of the ions is conserved
+Validate("Ion weights are conserved", bool(np.allclose(Wh, Wh[0], rtol=1e-10) and np.allclose(Wc, Wc[0], rtol=1e-10)) )
+
+# Each new electron carries the weight of its ion: the charge is conserved
+ion_charge = Zh*Wh + Zc*Wc
+Validate("Electron weight equals the ion charge", bool(np.allclose(We, ion_charge, rtol=1e-8, atol=1e-12*Wh[0])) )
+
+# The scalars see all the imported electrons
+Dens_e = S.Scalar.Dens_electron().getData()
+Dens_h = S.Scalar.Dens_hydrogen().getData()
+Dens_c = S.Scalar.Dens_carbon  ().getData()
+Zavg_h = S.Scalar.Zavg_hydrogen().getData()
+Zavg_c = S.Scalar.Zavg_carbon  ().getData()
+Validate("Scalar Dens_electron equals the ion charge density", bool(np.allclose(Dens_e, Zavg_h*Dens_h+Zavg_c*Dens_c, rtol=1e-6, atol=1e-12)) )